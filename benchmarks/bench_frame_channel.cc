@@ -0,0 +1,196 @@
+/**
+  * @file bench_frame_channel.cc
+  * @brief This file is part of UnitreeCameraSDK.
+  * @details This benchmark measures producer jitter of the latest-frame channel while consumer threads read it.
+  * Usage: bench_frame_channel [--rate HZ] [--frames N] [--readers N] [--wait]
+  * The producer publishes pooled frames at a fixed rate, consumers lease the latest frame in a tight loop
+  * (or block in waitNewer() with --wait). Publish latency and the deviation of the publish period are compared
+  * between FrameChannel and a mutex guarded latest frame, like the channel was before.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c) 2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  */
+
+#include <FrameChannel.hpp>
+#include <StageStats.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock ClockType;
+
+// reference: every read and publish takes the same mutex
+class LockedSlot
+{
+private:
+    std::mutex m_lock;
+    std::condition_variable m_trigger;
+    FrameLease m_latest;
+    uint64_t m_sequence = 0;
+
+public:
+    uint64_t nextSequence(void){
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_sequence + 1;
+    }
+    void publish(FrameLease &&lease){
+        FrameLease previous;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_sequence = lease.sequence();
+            previous = std::move(m_latest);
+            m_latest = std::move(lease);
+        }
+        m_trigger.notify_all();
+    }
+    bool latest(FrameLease &lease){
+        std::lock_guard<std::mutex> lock(m_lock);
+        lease = m_latest;
+        return lease.isValid();
+    }
+    bool waitNewer(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout){
+        std::unique_lock<std::mutex> lock(m_lock);
+        uint64_t last = sequence;
+        if(!m_trigger.wait_for(lock, timeout, [this, last]{ return m_latest.isValid() && m_sequence > last; }))
+            return false;
+        lease = m_latest;
+        sequence = m_sequence;
+        return true;
+    }
+    void close(void){
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_latest.release();
+    }
+};
+
+typedef struct BenchResult{
+    StageStatsType publish;
+    StageStatsType jitter;
+    uint64_t reads = 0;
+    double seconds = 0;
+}BenchResultType;
+
+// keeps the frame reads of consumers from being optimized away
+static std::atomic<int64_t> g_checksum(0);
+
+template<typename SlotType>
+static void readLoop(SlotType &slot, std::atomic<bool> &stop, std::atomic<uint64_t> &reads){
+    uint64_t count = 0;
+    int64_t checksum = 0;
+    while(!stop){
+        FrameLease lease;
+        if(slot.latest(lease))
+            checksum += lease.timeStamp().count();
+        count++;
+    }
+    reads += count;
+    g_checksum += checksum;
+}
+
+template<typename SlotType>
+static void waitLoop(SlotType &slot, std::atomic<bool> &stop, std::atomic<uint64_t> &reads){
+    uint64_t count = 0, sequence = 0;
+    while(!stop){
+        FrameLease lease;
+        if(slot.waitNewer(lease, sequence, std::chrono::milliseconds(10)))
+            count++;
+    }
+    reads += count;
+}
+
+template<typename SlotType>
+static BenchResultType runBench(SlotType &slot, double rate, int frames, int readers, bool wait){
+    FramePool pool(readers + 4);
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> reads(0);
+    std::vector<std::thread> threads;
+    for(int i = 0; i < readers; i++){
+        if(wait)
+            threads.emplace_back([&]{ waitLoop(slot, stop, reads); });
+        else
+            threads.emplace_back([&]{ readLoop(slot, stop, reads); });
+    }
+
+    StageStatsRecorder publishStats, jitterStats;
+    ClockType::duration period = std::chrono::duration_cast<ClockType::duration>(std::chrono::duration<double>(1.0 / rate));
+    ClockType::time_point begin = ClockType::now(), due = begin, last = begin;
+    for(int i = 0; i < frames; i++){
+        std::this_thread::sleep_until(due);
+        ClockType::time_point start = ClockType::now();
+        if(i > 0){
+            ClockType::duration deviation = (start - last) - period;
+            jitterStats.record(std::chrono::duration_cast<std::chrono::microseconds>(
+                deviation < ClockType::duration::zero() ? -deviation : deviation));
+        }
+        last = start;
+        due += period;
+
+        int index;
+        PooledFrameType *frame = pool.acquire(index);
+        if(!frame){
+            publishStats.drop();
+            continue;
+        }
+        frame->sequence = slot.nextSequence();
+        frame->timeStamp = std::chrono::duration_cast<std::chrono::microseconds>(start.time_since_epoch());
+        slot.publish(pool.commit(index));
+        publishStats.record(start);
+    }
+
+    BenchResultType result;
+    result.seconds = std::chrono::duration<double>(ClockType::now() - begin).count();
+    stop = true;
+    for(std::thread &thread : threads)
+        thread.join();
+    slot.close();
+    result.reads = reads;
+    publishStats.snapshot(result.publish);
+    jitterStats.snapshot(result.jitter);
+    return result;
+}
+
+static void printResult(const char *name, int readers, const BenchResultType &result){
+    printf("%-14s %7d %10.4f %10.4f %10.4f %10.4f %10.4f %12.0f\n", name, readers,
+           result.publish.p50, result.publish.p99, result.publish.max, result.jitter.p99, result.jitter.max,
+           result.reads / result.seconds);
+}
+
+int main(int argc, char *argv[]){
+    double rate = 1000;
+    int frames = 5000, maxReaders = (int)std::thread::hardware_concurrency();
+    bool wait = false;
+    for(int i = 1; i < argc; i++){
+        if(!strcmp(argv[i], "--rate") && i + 1 < argc)
+            rate = std::max(1.0, atof(argv[++i]));
+        else if(!strcmp(argv[i], "--frames") && i + 1 < argc)
+            frames = std::max(2, atoi(argv[++i]));
+        else if(!strcmp(argv[i], "--readers") && i + 1 < argc)
+            maxReaders = std::max(0, atoi(argv[++i]));
+        else if(!strcmp(argv[i], "--wait"))
+            wait = true;
+        else{
+            fprintf(stderr, "usage: %s [--rate HZ] [--frames N] [--readers N] [--wait]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("%d frames at %.0f Hz, consumers %s\n", frames, rate, wait ? "wait for new frames" : "poll latest frame");
+    printf("%-14s %7s %10s %10s %10s %10s %10s %12s\n", "slot", "readers", "pub p50", "pub p99", "pub max",
+           "jit p99", "jit max", "reads/s");
+    std::vector<int> readerCounts = {0};
+    for(int readers = 1; readers <= maxReaders; readers *= 2)
+        readerCounts.push_back(readers);
+    for(int readers : readerCounts){
+        LockedSlot locked;
+        printResult("mutex", readers, runBench(locked, rate, frames, readers, wait));
+        FrameChannel channel;
+        printResult("FrameChannel", readers, runBench(channel, rate, frames, readers, wait));
+    }
+    printf("latency and jitter in ms\n");
+    return 0;
+}
@@ -0,0 +1,265 @@
+/**
+  * @file bench_reprojection.cc
+  * @brief This file is part of UnitreeCameraSDK.
+  * @details This benchmark compares disparity reprojection kernels on recorded or synthetic disparity maps,
+  * and the cost and point reduction of the voxel grid and radius outlier filter behind them.
+  * Usage: bench_reprojection [--perspective] [--iterations N] [--size W H] [disparity files ...]
+  * Disparity files are CV_16SC1 disparities with 4 fractional bits, saved by cv::FileStorage under the key
+  * "disparity" (.yml, .xml) or as 16 bit png, at 464x400 unless --size W H is given.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c) 2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  */
+
+#include <PointCloudFilter.hpp>
+#include <StereoReprojector.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+static const float BASELINE = 0.03f;
+static const float MIN_DEPTH = 0.05f;
+static const float MAX_DEPTH = 1.0f;
+
+typedef std::chrono::steady_clock ClockType;
+
+static double elapsedMs(ClockType::time_point start, int iterations){
+    return std::chrono::duration<double, std::milli>(ClockType::now() - start).count() / iterations;
+}
+
+static cv::Mat rectIntrinsic(int mode, cv::Size size){
+    if(mode == RECTIFY_PERSPECTIVE){
+        double f = size.width / 2.0;   // 90 degree field of view
+        return (cv::Mat_<double>(3, 3) << f, 0, (size.width - 1) / 2.0, 0, f, (size.height - 1) / 2.0, 0, 0, 1);
+    }
+    return (cv::Mat_<double>(3, 3) << size.width / CV_PI, 0, 0, 0, size.height / CV_PI, 0, 0, 0, 1);
+}
+
+// ground-like scene, range grows from 0.1 to 1.2 down the image, 10% holes
+static cv::Mat syntheticDisparity(int mode, const cv::Mat &kfe, cv::Size size){
+    double fx = kfe.at<double>(0, 0), cx = kfe.at<double>(0, 2);
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> noise(-0.5, 0.5), hole(0, 1);
+    cv::Mat disparity(size, CV_16SC1);
+    for(int v = 0; v < size.height; v++){
+        short *disp = disparity.ptr<short>(v);
+        double range = 0.1 + 1.1 * v / size.height;
+        for(int u = 0; u < size.width; u++){
+            double d;
+            if(mode == RECTIFY_LONGLAT){
+                double lon = (u - cx) / fx;
+                d = std::atan2(std::sin(lon), range / BASELINE + std::cos(lon)) * fx;
+            }
+            else{
+                d = fx * BASELINE / range;
+            }
+            disp[u] = hole(random) < 0.1 ? -16 : (short)std::max(0.0, d * 16 + noise(random));
+        }
+    }
+    return disparity;
+}
+
+static bool loadDisparity(const std::string &fileName, cv::Size size, cv::Mat &disparity){
+    if(fileName.find(".yml") != std::string::npos || fileName.find(".xml") != std::string::npos){
+        cv::FileStorage fs(fileName, cv::FileStorage::READ);
+        if(fs.isOpened())
+            fs["disparity"] >> disparity;
+    }
+    else{
+        disparity = cv::imread(fileName, cv::IMREAD_UNCHANGED);
+    }
+    if(disparity.empty() || disparity.channels() != 1 || disparity.size() != size)
+        return false;
+    if(disparity.type() != CV_16SC1)
+        disparity.convertTo(disparity, CV_16SC1);
+    return true;
+}
+
+// per-pixel reference: trigonometry for every point and array-of-structs output, like StereoCamera::getPointCloud()
+static void referenceReproject(int mode, const cv::Mat &kfe, const cv::Mat &disparity, std::vector<PCLType> &cloud){
+    double fx = kfe.at<double>(0, 0), fy = kfe.at<double>(1, 1);
+    double cx = kfe.at<double>(0, 2), cy = kfe.at<double>(1, 2);
+    cloud.clear();
+    for(int v = 0; v < disparity.rows; v++){
+        const short *disp = disparity.ptr<short>(v);
+        for(int u = 0; u < disparity.cols; u++){
+            if(disp[u] <= 0)
+                continue;
+            float d = disp[u] / 16.f;
+            cv::Vec3f ray;
+            float r;
+            if(mode == RECTIFY_LONGLAT){
+                float lon = (float)((u - cx) / fx), lat = (float)((v - cy) / fy), angle = (float)(d / fx);
+                r = BASELINE * (std::sin(lon) * std::cos(angle) / std::sin(angle) - std::cos(lon));
+                ray = cv::Vec3f(-std::cos(lon), -std::sin(lon) * std::cos(lat), std::sin(lon) * std::sin(lat));
+            }
+            else{
+                r = (float)(BASELINE * fx / d);
+                ray = cv::Vec3f((float)((u - cx) / fx), (float)((v - cy) / fy), 1.f);
+            }
+            if(!(r >= MIN_DEPTH && r <= MAX_DEPTH))
+                continue;
+            PCLType point;
+            point.pts = cv::Vec3f(ray[0] * r, ray[1] * r, ray[2] * r);
+            point.clr = cv::Vec3b(255, 255, 255);
+            cloud.push_back(point);
+        }
+    }
+}
+
+// tables of the row kernel, built the same way as StereoReprojector::init()
+typedef struct KernelTables{
+    std::vector<float> lut, colA, colS, colC, rowP, rowR;
+    std::vector<int> index;
+}KernelTablesType;
+
+static void buildTables(int mode, const cv::Mat &kfe, cv::Size size, KernelTablesType &tables){
+    double fx = kfe.at<double>(0, 0), fy = kfe.at<double>(1, 1);
+    double cx = kfe.at<double>(0, 2), cy = kfe.at<double>(1, 2);
+    tables.lut.assign(256 * 16 + 1, 0.f);
+    for(size_t d = 1; d < tables.lut.size(); d++){
+        double angle = d / 16.0 / fx;
+        tables.lut[d] = (float)(BASELINE * (mode == RECTIFY_LONGLAT ? std::cos(angle) / std::sin(angle) : 1.0 / angle));
+    }
+    for(int u = 0; u < size.width; u++){
+        double lon = (u - cx) / fx;
+        tables.colA.push_back(mode == RECTIFY_LONGLAT ? (float)-std::cos(lon) : (float)lon);
+        tables.colS.push_back(mode == RECTIFY_LONGLAT ? (float)std::sin(lon) : 1.f);
+        tables.colC.push_back(mode == RECTIFY_LONGLAT ? (float)(BASELINE * std::cos(lon)) : 0.f);
+    }
+    for(int v = 0; v < size.height; v++){
+        double lat = (v - cy) / fy;
+        tables.rowP.push_back(mode == RECTIFY_LONGLAT ? (float)-std::cos(lat) : (float)lat);
+        tables.rowR.push_back(mode == RECTIFY_LONGLAT ? (float)std::sin(lat) : 1.f);
+    }
+    tables.index.resize(size.width + REPROJECT_ROW_PADDING);
+}
+
+// row kernel without color, to compare scalar and vector code
+static size_t kernelReproject(const cv::Mat &disparity, KernelTablesType &tables, bool scalar, cv::Mat &depth,
+                              PointCloudSoAType &cloud){
+    cloud.reserve(disparity.total() + REPROJECT_ROW_PADDING);
+    depth.create(disparity.size(), CV_32FC1);
+    size_t count = 0;
+    for(int v = 0; v < disparity.rows; v++){
+        ReprojectRowArgsType args = {disparity.ptr<short>(v), disparity.cols, tables.lut.data(), (int)tables.lut.size(),
+                                     tables.colA.data(), tables.colS.data(), tables.colC.data(),
+                                     tables.rowP[v], tables.rowR[v], MIN_DEPTH, MAX_DEPTH, nullptr};
+        float *x = &cloud.x[count], *y = &cloud.y[count], *z = &cloud.z[count];
+        if(scalar)
+            count += reprojectRowScalar(args, depth.ptr<float>(v), x, y, z, tables.index.data());
+        else
+            count += reprojectRow(args, depth.ptr<float>(v), x, y, z, tables.index.data());
+    }
+    cloud.count = count;
+    return count;
+}
+
+int main(int argc, char *argv[]){
+    int mode = RECTIFY_LONGLAT, iterations = 200;
+    cv::Size size(464, 400);
+    std::vector<std::string> files;
+    for(int i = 1; i < argc; i++){
+        if(!strcmp(argv[i], "--perspective"))
+            mode = RECTIFY_PERSPECTIVE;
+        else if(!strcmp(argv[i], "--iterations") && i + 1 < argc)
+            iterations = std::max(1, atoi(argv[++i]));
+        else if(!strcmp(argv[i], "--size") && i + 2 < argc){
+            size.width = atoi(argv[++i]);
+            size.height = atoi(argv[++i]);
+        }
+        else
+            files.push_back(argv[i]);
+    }
+
+    cv::Mat kfe = rectIntrinsic(mode, size);
+    std::vector<cv::Mat> disparities;
+    for(const std::string &file : files){
+        cv::Mat disparity;
+        if(loadDisparity(file, size, disparity))
+            disparities.push_back(disparity);
+        else
+            printf("skip %s, not a %dx%d single channel disparity\n", file.c_str(), size.width, size.height);
+    }
+    if(disparities.empty())
+        disparities.push_back(syntheticDisparity(mode, kfe, size));
+
+    StereoReprojector reprojector;
+    reprojector.init(mode, kfe, BASELINE, size);
+    KernelTablesType tables;
+    buildTables(mode, kfe, size, tables);
+    cv::Mat white(size, CV_8UC3, cv::Scalar(255, 255, 255)), depth;
+    std::vector<PCLType> cloud;
+    PointCloudSoAType cloudSoA;
+
+    printf("%s, %dx%d, %d disparity maps, %d iterations, kernel %s\n",
+           mode == RECTIFY_LONGLAT ? "longlat" : "perspective", size.width, size.height,
+           (int)disparities.size(), iterations, reprojectKernelName());
+    printf("%-28s %10s %10s\n", "variant", "ms/frame", "points");
+
+    for(const cv::Mat &disparity : disparities){
+        ClockType::time_point start = ClockType::now();
+        for(int i = 0; i < iterations; i++)
+            referenceReproject(mode, kfe, disparity, cloud);
+        printf("%-28s %10.3f %10d\n", "per-pixel reference", elapsedMs(start, iterations), (int)cloud.size());
+        std::vector<PCLType> reference = cloud;
+
+        size_t count = 0;
+        start = ClockType::now();
+        for(int i = 0; i < iterations; i++)
+            count = kernelReproject(disparity, tables, true, depth, cloudSoA);
+        printf("%-28s %10.3f %10d\n", "lut row kernel, scalar", elapsedMs(start, iterations), (int)count);
+
+        start = ClockType::now();
+        for(int i = 0; i < iterations; i++)
+            count = kernelReproject(disparity, tables, false, depth, cloudSoA);
+        printf("%-28s %10.3f %10d\n", (std::string("lut row kernel, ") + reprojectKernelName()).c_str(),
+               elapsedMs(start, iterations), (int)count);
+
+        start = ClockType::now();
+        for(int i = 0; i < iterations; i++)
+            reprojector.reproject(disparity, white, MIN_DEPTH, MAX_DEPTH, &depth, &cloud);
+        printf("%-28s %10.3f %10d\n", "reproject(), PCLType", elapsedMs(start, iterations), (int)cloud.size());
+
+        start = ClockType::now();
+        for(int i = 0; i < iterations; i++)
+            reprojector.reproject(disparity, white, MIN_DEPTH, MAX_DEPTH, &depth, cloudSoA);
+        printf("%-28s %10.3f %10d\n", "reproject(), PointCloudSoA", elapsedMs(start, iterations), (int)cloudSoA.count);
+
+        PointCloudFilter filter;
+        PointCloudSoAType filtered;
+        filter.setParams(0.01f, 0, 1);
+        start = ClockType::now();
+        for(int i = 0; i < iterations; i++){
+            reprojector.reproject(disparity, white, MIN_DEPTH, MAX_DEPTH, nullptr, filtered);
+            filter.apply(filtered);
+        }
+        printf("%-28s %10.3f %10d\n", "+ 1 cm voxel grid", elapsedMs(start, iterations), (int)filtered.count);
+
+        filter.setParams(0.01f, 0.03f, 2);
+        start = ClockType::now();
+        for(int i = 0; i < iterations; i++){
+            reprojector.reproject(disparity, white, MIN_DEPTH, MAX_DEPTH, nullptr, filtered);
+            filter.apply(filtered);
+        }
+        printf("%-28s %10.3f %10d\n", "+ radius outlier 3 cm", elapsedMs(start, iterations), (int)filtered.count);
+
+        // float rounding at the ends of the depth range may keep or drop a few different points
+        if(reference.size() != cloudSoA.count){
+            printf("point count differs from reference by %d\n\n", (int)cloudSoA.count - (int)reference.size());
+            continue;
+        }
+        float maxError = 0;
+        for(size_t i = 0; i < reference.size(); i++){
+            maxError = std::max(maxError, std::fabs(reference[i].pts[0] - cloudSoA.x[i]));
+            maxError = std::max(maxError, std::fabs(reference[i].pts[1] - cloudSoA.y[i]));
+            maxError = std::max(maxError, std::fabs(reference[i].pts[2] - cloudSoA.z[i]));
+        }
+        printf("max coordinate difference to reference %g\n\n", maxError);
+    }
+    return 0;
+}
@@ -0,0 +1,183 @@
+/**
+  * @file bench_stereo.cc
+  * @brief This file is part of UnitreeCameraSDK.
+  * @details This benchmark runs StereoPipeline::processFrame() over a fixed set of raw frames, at both raw frame
+  * sizes, every RectifyFrameSize and both matchers, everything else such as DisparityBands and the filters comes
+  * from the pipeline config.
+  * Usage: bench_stereo [--dataset SOURCE --calib FILE] [--frames N] [--repeat N] [--config FILE] [--csv]
+  * SOURCE is a side-by-side video or image sequence such as "frames/%04d.png", FILE is written by
+  * VirtualStereoCamera::exportCalibParams(). Without a dataset frames are rendered from the synthetic scene of
+  * VirtualStereoCamera, whose ball moves with wall clock time, so use a recorded dataset to compare releases.
+  * Every configuration prints one JSON line (or one CSV row with --csv) with throughput, p50/p99/max latency of
+  * every stage of StereoPipeline::getStats() and of the whole frame in millisecond and peak RSS in kilobyte.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c) 2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  */
+
+#include <StageStats.hpp>
+#include <StereoPipeline.hpp>
+#include <StereoReprojector.hpp>
+#include <VirtualStereoCamera.hpp>
+#include <sys/resource.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock ClockType;
+
+static const cv::Size RAW_SIZES[] = {cv::Size(1856, 800), cv::Size(928, 400)};
+static const cv::Size RECT_SIZES[] = {cv::Size(232, 200), cv::Size(464, 400), cv::Size(928, 800)};
+static const int ALGORITHMS[] = {DISPARITY_BM, DISPARITY_SGBM};
+
+// peak resident set size in kilobyte, since the last resetPeakRss()
+static long peakRss(void){
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while(std::getline(status, line))
+        if(line.compare(0, 6, "VmHWM:") == 0)
+            return atol(line.c_str() + 6);
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// linux 4.0 and later, otherwise the peak is the process peak so far
+static void resetPeakRss(void){
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+}
+
+static bool loadFrames(VirtualStereoCamera &camera, int count, std::vector<cv::Mat> &frames){
+    for(int i = 0; i < count; i++){
+        cv::Mat frame;
+        std::chrono::microseconds timeStamp;
+        if(!camera.getRawFrame(frame, timeStamp))
+            return false;
+        frames.push_back(frame);
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]){
+    std::string dataset = VIRTUAL_SOURCE_SYNTHETIC, calibFile, configFile;
+    int frameCount = 30, repeat = 1;
+    bool isCsv = false;
+    for(int i = 1; i < argc; i++){
+        if(!strcmp(argv[i], "--dataset") && i + 1 < argc)
+            dataset = argv[++i];
+        else if(!strcmp(argv[i], "--calib") && i + 1 < argc)
+            calibFile = argv[++i];
+        else if(!strcmp(argv[i], "--frames") && i + 1 < argc)
+            frameCount = std::max(1, atoi(argv[++i]));
+        else if(!strcmp(argv[i], "--repeat") && i + 1 < argc)
+            repeat = std::max(1, atoi(argv[++i]));
+        else if(!strcmp(argv[i], "--config") && i + 1 < argc)
+            configFile = argv[++i];
+        else if(!strcmp(argv[i], "--csv"))
+            isCsv = true;
+        else{
+            fprintf(stderr, "usage: %s [--dataset SOURCE --calib FILE] [--frames N] [--repeat N] [--config FILE] [--csv]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    // bands, filters and depth range of the pipeline config, frame sizes and matcher are swept
+    StereoPipeline pipeline;
+    if(!configFile.empty() && !pipeline.loadConfig(configFile))
+        return 1;
+    StereoPipelineConfigType config = pipeline.getConfig();
+
+    VirtualStereoCamera camera(dataset, 0, RAW_SIZES[0]);
+    if(!camera.isOpened() || (!calibFile.empty() && !camera.loadCalibParams(calibFile)))
+        return 1;
+    std::vector<cv::Mat> leftParams, rightParams, frames;
+    if(!camera.getCalibParams(leftParams, false) || !camera.getCalibParams(rightParams, true)){
+        fprintf(stderr, "%s needs calibration parameters, pass --calib\n", dataset.c_str());
+        return 1;
+    }
+    if(!loadFrames(camera, frameCount, frames))
+        return 1;
+
+    // stage names of getStats() are fixed, they are available before init()
+    std::vector<StageStatsType> stages;
+    pipeline.getStats(stages);
+    if(isCsv){
+        printf("raw_width,raw_height,rect_width,rect_height,algorithm,frames,fps");
+        for(const StageStatsType &stage : stages)
+            printf(",%s_p50_ms,%s_p99_ms,%s_max_ms", stage.name.c_str(), stage.name.c_str(), stage.name.c_str());
+        printf(",total_p50_ms,total_p99_ms,total_max_ms,points,peak_rss_kb\n");
+    }
+
+    for(cv::Size rawSize : RAW_SIZES){
+        std::vector<cv::Mat> raws(frames.size());
+        for(size_t i = 0; i < frames.size(); i++){
+            if(frames[i].size() == rawSize)
+                raws[i] = frames[i];
+            else
+                cv::resize(frames[i], raws[i], rawSize, 0, 0, cv::INTER_AREA);
+        }
+
+        for(cv::Size rectSize : RECT_SIZES){
+            for(int algorithm : ALGORITHMS){
+                StereoPipelineConfigType sweep = config;
+                sweep.rectFrameSize = rectSize;
+                sweep.algorithm = algorithm;
+                // keep the disparity range in degrees, 64 at 464x400
+                sweep.numDisparities = std::max(16, config.numDisparities * rectSize.width / 464 / 16 * 16);
+                if(!pipeline.setConfig(sweep) || !pipeline.init(leftParams, rightParams, rawSize))
+                    return 1;
+
+                StageStatsRecorder total;
+                cv::Mat left, right, disparity, depth;
+                PointCloudSoAType cloud;
+                size_t points = 0;
+
+                resetPeakRss();
+                ClockType::time_point begin = ClockType::now();
+                for(int r = 0; r < repeat; r++){
+                    for(const cv::Mat &raw : raws){
+                        ClockType::time_point start = ClockType::now();
+                        if(!pipeline.processFrame(raw, left, right, disparity, &depth, cloud))
+                            return 1;
+                        total.record(start);
+                        points += cloud.count;
+                    }
+                }
+                double seconds = std::chrono::duration<double>(ClockType::now() - begin).count();
+                int processed = (int)raws.size() * repeat;
+                long rss = peakRss();
+
+                StageStatsType frame;
+                pipeline.getStats(stages);
+                total.snapshot(frame);
+                const char *algorithmName = algorithm == DISPARITY_BM ? "bm" : "sgbm";
+                if(isCsv){
+                    printf("%d,%d,%d,%d,%s,%d,%.2f", rawSize.width, rawSize.height, rectSize.width, rectSize.height,
+                           algorithmName, processed, processed / seconds);
+                    for(const StageStatsType &stage : stages)
+                        printf(",%.3f,%.3f,%.3f", stage.p50, stage.p99, stage.max);
+                    printf(",%.3f,%.3f,%.3f,%zu,%ld\n", frame.p50, frame.p99, frame.max, points / processed, rss);
+                }
+                else{
+                    printf("{\"raw\": [%d, %d], \"rect\": [%d, %d], \"algorithm\": \"%s\", \"numDisparities\": %d, "
+                           "\"bands\": %d, \"frames\": %d, \"fps\": %.2f, \"stages\": {", rawSize.width, rawSize.height,
+                           rectSize.width, rectSize.height, algorithmName, sweep.numDisparities, sweep.disparityBands,
+                           processed, processed / seconds);
+                    for(const StageStatsType &stage : stages)
+                        printf("\"%s\": {\"p50\": %.3f, \"p99\": %.3f, \"max\": %.3f}, ", stage.name.c_str(),
+                               stage.p50, stage.p99, stage.max);
+                    printf("\"total\": {\"p50\": %.3f, \"p99\": %.3f, \"max\": %.3f}}", frame.p50, frame.p99, frame.max);
+                    printf(", \"points\": %zu, \"peakRssKb\": %ld, \"threads\": %d, \"kernel\": \"%s\"}\n",
+                           points / processed, rss, cv::getNumThreads(), reprojectKernelName());
+                }
+                fflush(stdout);
+            }
+        }
+    }
+    return 0;
+}
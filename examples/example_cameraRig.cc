@@ -0,0 +1,73 @@
+/**
+  * @file example_cameraRig.cc
+  * @brief This file is part of UnitreeCameraSDK.
+  * @details This example that how to run several body cameras in one process and get time aligned depth frame sets
+  * Usage: example_cameraRig [--fuse] position config.yaml [position config.yaml ...]
+  * with --fuse the point clouds of all cameras are merged in the body frame, see BodyTransform of each config file
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c) 2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  */
+
+#include <CameraRig.hpp>
+
+int main(int argc, char *argv[]){
+
+    WorkerPoolConfigType poolConfig;
+    poolConfig.name = "vision"; ///< threads show up as vision0, cam1-grab, rig0 ... in top -H
+    // poolConfig.cpus = {4, 5, 6, 7}; ///< keep vision off the cores of the motion controller
+    // poolConfig.priority = 10;        ///< SCHED_FIFO, needs root or CAP_SYS_NICE
+    WorkerPool pool(poolConfig);
+
+    bool isFused = argc > 1 && std::string(argv[1]) == "--fuse";
+    int first = isFused ? 2 : 1;
+
+    CameraRig rig; ///< one worker per cpu core shared by all cameras
+    rig.setWorkerPool(&pool);
+    for(int i = first; i + 1 < argc; i += 2){
+        int posNumber = atoi(argv[i]); ///< face NO.1, chin NO.2, left NO.3, right NO.4, down NO.5
+        if(!rig.addCamera(posNumber, argv[i + 1], posNumber == 1 ? 1 : 0)) ///< face camera goes first
+            exit(EXIT_FAILURE);
+    }
+    if(argc < first + 2 && !rig.addCamera(1, "stereo_camera_config.yaml"))
+        exit(EXIT_FAILURE);
+
+    rig.setSchedule(RIG_SCHEDULE_PRIORITY);
+    rig.setProduct(isFused ? PIPELINE_POINT_CLOUD : PIPELINE_DEPTH_FRAME);
+    rig.setFusionVoxelSize(0.02f); ///< 2 cm voxels, 0 keeps every point
+    if(!rig.startRig())
+        exit(EXIT_FAILURE);
+
+    uint64_t sequence = 0; ///< sequence number of the last consumed frame set
+    PointCloudSoAType cloud;
+    while(true){
+        RigFrameSetType frameSet;
+        if(!rig.waitForFrameSet(frameSet, sequence, std::chrono::milliseconds(100)))
+            continue;
+        if(isFused){
+            if(rig.fuseCloud(frameSet, cloud))
+                std::cout << "frame set " << frameSet.sequence << ", " << cloud.count << " fused points" << std::endl;
+            continue;
+        }
+        for(size_t i = 0; i < frameSet.frames.size(); i++){
+            cv::Mat show;
+            frameSet.frames[i].data1().convertTo(show, CV_8U, 255.0); ///< 1 meter is white
+            cv::imshow("UnitreeCamera-Rig" + std::to_string(frameSet.posNumbers[i]), show);
+        }
+        std::cout << "frame set " << frameSet.sequence << ", spread " << frameSet.spread.count() / 1000.0 << " ms" << std::endl;
+        frameSet = RigFrameSetType(); ///< release the leases before waiting for the next frame set
+        char key = cv::waitKey(10);
+        if(key == 27) // press ESC key
+           break;
+    }
+
+    std::vector<StageStatsType> stats;
+    rig.getStats(stats);
+    for(const StageStatsType &stage : stats)
+        std::cout << stage.name << ": " << stage.processed << " frames, " << stage.dropped << " dropped, p50 "
+                  << stage.p50 << " ms, p99 " << stage.p99 << " ms" << std::endl;
+    std::cout << rig.getMismatchCount() << " frame sets out of sync" << std::endl;
+    rig.stopRig();
+
+    return 0;
+}
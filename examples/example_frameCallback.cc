@@ -0,0 +1,61 @@
+/**
+  * @file example_frameCallback.cc
+  * @brief This file is part of UnitreeCameraSDK.
+  * @details This example that how to get frames pushed to callbacks
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c) 2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  */
+
+#include <UnitreeCameraSDK.hpp>
+#include <StereoFrameGrabber.hpp>
+#include <signal.h>
+#include <unistd.h>
+
+bool killSignalFlag = false;
+void ctrl_c_handler(int s){
+    killSignalFlag = true;
+    return ; 
+}
+
+int main(int argc, char *argv[]){
+    
+    UnitreeCamera cam("stereo_camera_config.yaml"); ///< init UnitreeCamera object by config file
+    if(!cam.isOpened())  ///< get camera open state
+        exit(EXIT_FAILURE);
+    
+    struct sigaction sigIntHandler;
+    sigIntHandler.sa_handler = ctrl_c_handler;
+    sigemptyset(&sigIntHandler.sa_mask);
+    sigIntHandler.sa_flags = 0;
+    sigaction(SIGINT, &sigIntHandler, NULL);
+    
+    cam.startCapture(); ///< disable image h264 encoding and share memory sharing
+    cam.startStereoCompute(); ///< start disparity computing
+    
+    StereoFrameGrabber grabber;
+    {
+        CallbackExecutor executor(1, 2); ///< one worker thread, at most two waiting calls
+        
+        ///< runs on the raw grab thread as soon as a frame is captured, keep it short
+        grabber.registerCallback(GRAB_RAW_FRAME, [](const FrameLease &raw){
+            std::cout << "raw frame " << raw.sequence() << " at " << raw.timeStamp().count() << " us" << std::endl;
+        });
+        ///< handed off to executor, slow work does not delay the depth grab thread
+        int depthCallback = grabber.registerCallback(GRAB_DEPTH_FRAME, [](const FrameLease &depth){
+            std::cout << "depth frame " << depth.sequence() << " " << depth.data1().size() << std::endl;
+        }, &executor);
+        
+        grabber.startGrab(&cam, GRAB_DEPTH_FRAME);
+        while(cam.isOpened() && !killSignalFlag)
+            usleep(100000);
+        
+        grabber.unregisterCallback(GRAB_DEPTH_FRAME, depthCallback); ///< stop handing off to executor
+    } ///< executor is destroyed here, before grabbing stops
+    
+    grabber.stopGrab();
+    cam.stopStereoCompute();  ///< stop disparity computing 
+    cam.stopCapture();  ///< stop camera capturing
+    
+    return 0;
+}
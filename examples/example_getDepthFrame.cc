@@ -9,6 +9,7 @@
   */
 
 #include <UnitreeCameraSDK.hpp>
+#include <StereoFrameGrabber.hpp>
 #include <unistd.h>
 
 int main(int argc, char *argv[]){
@@ -20,21 +21,23 @@ int main(int argc, char *argv[]){
     cam.startCapture(); ///< disable image h264 encoding and share memory sharing
     cam.startStereoCompute(); ///< start disparity computing
     
+    StereoFrameGrabber grabber;
+    grabber.startGrab(&cam, GRAB_COLOR_DEPTH); ///< grab color depth image
+    
+    uint64_t sequence = 0; ///< sequence number of the last consumed depth image
     while(cam.isOpened()){
-        cv::Mat depth; 
-        std::chrono::microseconds t;
-        if(!cam.getDepthFrame(depth, true, t)){  ///< get stereo camera depth image 
-            usleep(1000);
+        FrameLease depth;
+        if(!grabber.waitForDepthFrame(depth, sequence, std::chrono::milliseconds(100))){  ///< wait for next depth image 
             continue;
         }
-        if(!depth.empty()){
-            cv::imshow("UnitreeCamera-Depth", depth);
-        }
+        cv::imshow("UnitreeCamera-Depth", depth.data1());
+        depth.release();
         char key = cv::waitKey(10);
         if(key == 27) // press ESC key
            break;
     }
     
+    grabber.stopGrab(); ///< stop grabbing before disparity computing stops
     cam.stopStereoCompute();  ///< stop disparity computing 
     cam.stopCapture();  ///< stop camera capturing
     
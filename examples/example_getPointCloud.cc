@@ -15,6 +15,7 @@
 #include <unistd.h>
 #include "glViewer/scenewindow.hpp"
 #include <UnitreeCameraSDK.hpp>
+#include <StereoFrameGrabber.hpp>
 
 #define RGB_PCL true ///< Color Point Cloud Enable Flag
 
@@ -28,10 +29,14 @@ void DrawScene(const std::vector<PCLType>& pcl_vec) {
     glEnd();
 }
 
-void DrawScene(const std::vector<cv::Vec3f>& pcl_vec) {
+void DrawScene(const std::vector<PCLType>& pcl_vec, bool rgb) {
+    if (rgb) {
+        DrawScene(pcl_vec);
+        return;
+    }
     glBegin(GL_POINTS);
     for (uint i = 0; i < pcl_vec.size(); ++i) {
-        cv::Vec3f pcl = pcl_vec[i];
+        cv::Vec3f pcl = pcl_vec[i].pts;
         glColor3ub(255, 255, 0);
         glVertex3f(-pcl(0), -pcl(1), pcl(2));
     }
@@ -53,6 +58,9 @@ int main(int argc, char *argv[]){
     cam.startCapture();
     cam.startStereoCompute();
     
+    StereoFrameGrabber grabber;
+    grabber.startGrab(&cam, GRAB_POINT_CLOUD);
+    
     struct sigaction sigIntHandler;
     sigIntHandler.sa_handler = ctrl_c_handler;
     sigemptyset(&sigIntHandler.sa_mask);
@@ -63,34 +71,26 @@ int main(int argc, char *argv[]){
     
     glwindow::SceneWindow scene(960, 720, "Panorama 3D Scene");
     
+    uint64_t sequence = 0;
     while(cam.isOpened()){
         
         if(killSignalFlag){
             break;
         }
         
-        std::chrono::microseconds t;
-#if RGB_PCL       
-        std::vector<PCLType> pcl_vec;
-        if(!cam.getPointCloud(pcl_vec, t)){
-            usleep(1000);
-            continue;
-        }
-#else        
-        std::vector<cv::Vec3f> pcl_vec;
-        if(!cam.getPointCloud(pcl_vec, t)){
-            usleep(1000);
+        FrameLease pcl;
+        if(!grabber.waitForPointCloud(pcl, sequence, std::chrono::milliseconds(100))){
             continue;
         }
-#endif
         if (scene.win.alive()) {
             if (scene.start_draw()) {
-                DrawScene(pcl_vec);
+                DrawScene(pcl.cloud(), RGB_PCL);
                 scene.finish_draw();
             }
         }
     }
     
+    grabber.stopGrab();
     cam.stopStereoCompute();
     cam.stopCapture();
     return 0;
@@ -9,6 +9,7 @@
   */
 
 #include <UnitreeCameraSDK.hpp>
+#include <StereoFrameGrabber.hpp>
 #include <unistd.h>
 
 int main(int argc, char *argv[]){
@@ -37,26 +38,30 @@ int main(int argc, char *argv[]){
     
     cam.startCapture();            ///< start camera capturing
 
+    StereoFrameGrabber grabber;    ///< share captured frames by leases instead of copies
+    grabber.startGrab(&cam);       ///< start grabbing frames into pooled buffers
+
+    uint64_t sequence = 0;         ///< sequence number of the last consumed frame
+
     while(cam.isOpened())
     {
         
-        cv::Mat frame;
-        std::chrono::microseconds t;
-        if(!cam.getRawFrame(frame, t)){ ///< get camera raw image
-            usleep(1000);
+        FrameLease lease;
+        cv::Mat left,right;
+        if(!grabber.waitForStereoFrame(lease, left, right, sequence, std::chrono::milliseconds(100))){ ///< wait for next raw image, left and right share its buffer
             continue;
         }
  
-        cv::Mat left,right;
-        frame(cv::Rect(0, 0, frame.size().width/2, frame.size().height)).copyTo(right);
-        frame(cv::Rect(frame.size().width/2,0, frame.size().width/2, frame.size().height)).copyTo(left);
+        cv::Mat frame;
         cv::hconcat(left, right, frame); 
+        lease.release();           ///< give the buffer back to the grabber
         cv::imshow("UnitreeCamera_Left-Right", frame);
         char key = cv::waitKey(10);
         if(key == 27) // press ESC key
            break;
     }
     
+    grabber.stopGrab(); ///< stop grabbing before camera capturing stops
     cam.stopCapture();  ///< stop camera capturing
     
     return 0;
@@ -9,6 +9,7 @@
   */
 
 #include <UnitreeCameraSDK.hpp>
+#include <StereoFrameGrabber.hpp>
 #include <unistd.h>
 
 int main(int argc, char *argv[]){
@@ -35,18 +36,21 @@ int main(int argc, char *argv[]){
     cam.setRectFrameSize(cv::Size(frameSize.width >> 2, frameSize.height >> 1)); ///< set camera rectify frame size
     cam.startCapture(); ///< disable image h264 encoding and share memory sharing
     
-    usleep(500000);
+    StereoFrameGrabber grabber;
+    grabber.startGrab(&cam, GRAB_RECT_FRAME); ///< rectify every captured frame once
+    
+    uint64_t sequence = 0; ///< sequence number of the last consumed rectify frame
     while(cam.isOpened()){
-        cv::Mat left,right;
-        if(!cam.getRectStereoFrame(left,right)){ ///< get rectify left,right frame  
-            usleep(1000);
+        FrameLease rect;
+        if(!grabber.waitForRectFrame(rect, sequence, std::chrono::milliseconds(100))){ ///< wait for next rectify left,right frame  
             continue;
         }
         
         cv::Mat stereo;
         // cv::flip(left,left, -1);
         // cv::flip(right,right, -1);
-        cv::hconcat(left, right, stereo); 
+        cv::hconcat(rect.data1(), rect.data2(), stereo); 
+        rect.release();
         cv::flip(stereo,stereo, -1);
         cv::imshow("Longlat_Rect", stereo);
         char key = cv::waitKey(10);
@@ -54,6 +58,7 @@ int main(int argc, char *argv[]){
            break;
     }
     
+    grabber.stopGrab(); ///< stop grabbing before camera capturing stops
     cam.stopCapture(); ///< stop camera capturing
     
     return 0;
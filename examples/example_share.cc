@@ -1,4 +1,5 @@
 #include <UnitreeCameraSDK.hpp>
+#include <StereoFrameGrabber.hpp>
 #include <unistd.h>
 
 int main(int argc, char *argv[])
@@ -9,20 +10,24 @@ int main(int argc, char *argv[])
         exit(EXIT_FAILURE);   
     cam.startCapture(false, true);
 
-    usleep(500000);
+    StereoFrameGrabber grabber;
+    grabber.startGrab(&cam, GRAB_RECT_FRAME); ///< rectify every captured frame once
+
+    uint64_t sequence = 0;
     while(cam.isOpened())
     {
-        cv::Mat left,right,feim;
-        if(!cam.getRectStereoFrame(left,right))
+        FrameLease rect;
+        if(!grabber.waitForRectFrame(rect, sequence, std::chrono::milliseconds(100)))
         {
-            usleep(1000);
             continue;
         }
+        rect.release();
         char key = cv::waitKey(10);
         if(key == 27) // press ESC key
            break;
     }
     
+    grabber.stopGrab(); ///< stop grabbing before camera capturing stops
     cam.stopCapture(); ///< stop camera capturing
     
     return 0;
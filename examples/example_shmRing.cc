@@ -0,0 +1,91 @@
+/**
+  * @file example_shmRing.cc
+  * @brief This file is part of UnitreeCameraSDK.
+  * @details This example that how to share raw, rectified and depth frames with other processes through shared
+  * memory rings, and how another process reads them in place. Run it once without arguments to publish, and
+  * with --read <position number> <stream> in other processes to read.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c) 2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  */
+
+#include <UnitreeCameraSDK.hpp>
+#include <ShmFramePublisher.hpp>
+#include <ShmFrameRing.hpp>
+#include <cstring>
+#include <unistd.h>
+
+static int readFrames(int posNumber, int stream){
+    ShmFrameReader reader;
+    reader.open(posNumber, stream); ///< the ring may not exist yet, waitFrame() attaches it when it does
+
+    uint64_t sequence = 0; ///< sequence number of the last read frame
+    uint64_t readCount = 0, invalidCount = 0;
+    cv::Mat display;
+    while(true){
+        ShmFrameType frame;
+        if(!reader.waitFrame(frame, sequence, std::chrono::milliseconds(100))){ ///< sleep until the publisher writes a frame
+            if(cv::waitKey(1) == 27)
+                break;
+            continue;
+        }
+        if(frame.data1.type() == CV_32FC1)
+            frame.data1.convertTo(display, CV_8U, 255.0 / 5.0); ///< depth in meter, 0 to 5 m
+        else if(frame.data1.type() == CV_16UC1)
+            frame.data1.convertTo(display, CV_8U, 255.0 / 5000.0); ///< depth in millimeter
+        else
+            frame.data1.copyTo(display);
+        if(!reader.isValid(frame)){ ///< the publisher reused the slot while it was copied, skip the frame
+            invalidCount++;
+            continue;
+        }
+        readCount++;
+        cv::imshow("UnitreeCamera-Share", display);
+        char key = cv::waitKey(10);
+        if(key == 27) // press ESC key
+           break;
+    }
+    std::cout << "read " << readCount << " frames, " << reader.getLostCount() << " skipped, " << invalidCount
+              << " overwritten while copied" << std::endl;
+    return 0;
+}
+
+int main(int argc, char *argv[]){
+
+    if(argc == 4 && strcmp(argv[1], "--read") == 0) ///< stream 0 raw, 1 rectified, 2 depth
+        return readFrames(atoi(argv[2]), atoi(argv[3]));
+
+    UnitreeCamera cam("stereo_camera_config.yaml"); ///< init UnitreeCamera object by config file
+    if(!cam.isOpened())   ///< get camera open state
+        exit(EXIT_FAILURE);
+    cam.startCapture(); ///< the rings replace the share memory of startCapture(false, true)
+
+    StereoFrameGrabber grabber;
+    grabber.startGrab(&cam); ///< pipeline is fed with raw frames
+
+    StereoPipeline pipeline;
+    pipeline.loadConfig("stereo_camera_config.yaml");
+    if(!pipeline.startPipeline(&cam, &grabber)){
+        grabber.stopGrab();
+        cam.stopCapture();
+        exit(EXIT_FAILURE);
+    }
+
+    ShmFramePublisher publisher;
+    if(!publisher.startPublish(cam.getPosNumber(), &grabber, &pipeline)){ ///< raw, rectified and depth rings
+        pipeline.stopPipeline();
+        grabber.stopGrab();
+        cam.stopCapture();
+        exit(EXIT_FAILURE);
+    }
+    std::cout << "publishing at share memory keys " << shmRingKey(cam.getPosNumber(), SHM_STREAM_RAW) << " to "
+              << shmRingKey(cam.getPosNumber(), SHM_STREAM_DEPTH) << ", press Enter to stop" << std::endl;
+    std::cin.get();
+
+    publisher.stopPublish(); ///< stop publishing before the pipeline stops
+    pipeline.stopPipeline();
+    grabber.stopGrab();
+    cam.stopCapture(); ///< stop camera capturing
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+/**
+  * @file example_stereoPipeline.cc
+  * @brief This file is part of UnitreeCameraSDK.
+  * @details This example that how to get colorized depth frame from the staged stereo pipeline
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c) 2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  */
+
+#include <UnitreeCameraSDK.hpp>
+#include <StereoPipeline.hpp>
+#include <unistd.h>
+
+int main(int argc, char *argv[]){
+    
+    UnitreeCamera cam("stereo_camera_config.yaml"); ///< init UnitreeCamera object by config file
+    if(!cam.isOpened())  ///< get camera open state
+        exit(EXIT_FAILURE);
+    
+    cam.startCapture(); ///< disable image h264 encoding and share memory sharing
+    
+    StereoFrameGrabber grabber;
+    grabber.startGrab(&cam); ///< pipeline is fed with raw frames
+    
+    StereoPipeline pipeline;
+    pipeline.loadConfig("stereo_camera_config.yaml"); ///< matcher, depth range and queue depths
+    if(!pipeline.startPipeline(&cam, &grabber)){ ///< rectify, match and reproject on separate threads
+        grabber.stopGrab();
+        cam.stopCapture();
+        exit(EXIT_FAILURE);
+    }
+    
+    pipeline.setStatsLogInterval(std::chrono::seconds(5)); ///< log stage latency and drops every 5 seconds
+    
+    uint64_t sequence = 0; ///< sequence number of the last consumed depth image
+    while(cam.isOpened()){
+        FrameLease depth;
+        if(!pipeline.waitForColorDepth(depth, sequence, std::chrono::milliseconds(100))){  ///< wait for next depth image, colored by DepthPalette
+            continue;
+        }
+        cv::imshow("UnitreeCamera-PipelineDepth", depth.data1());
+        depth.release();
+        char key = cv::waitKey(10);
+        if(key == 27) // press ESC key
+           break;
+    }
+    
+    std::vector<StageStatsType> stats; ///< capture stage of the grabber, then the pipeline stages
+    grabber.getStats(stats);
+    std::vector<StageStatsType> pipelineStats;
+    pipeline.getStats(pipelineStats);
+    stats.insert(stats.end(), pipelineStats.begin(), pipelineStats.end());
+    for(const StageStatsType &stage : stats)
+        std::cout << stage.name << ": " << stage.processed << " frames, " << stage.dropped << " dropped, p50 "
+                  << stage.p50 << " ms, p99 " << stage.p99 << " ms, max " << stage.max << " ms" << std::endl;
+    std::vector<double> timings; ///< matching time of each disparity band, see DisparityBands
+    if(pipeline.getBandTimings(timings))
+        for(size_t i = 0; i < timings.size(); i++)
+            std::cout << "disparity band " << i << ": " << timings[i] << " ms" << std::endl;
+    pipeline.stopPipeline(); ///< stop pipeline before grabbing stops
+    grabber.stopGrab();
+    cam.stopCapture();  ///< stop camera capturing
+    
+    return 0;
+}
@@ -0,0 +1,52 @@
+/**
+  * @file example_v4l2Capture.cc
+  * @brief This file is part of UnitreeCameraSDK.
+  * @details This example that how to capture raw frames through V4L2 buffers and print their driver timing,
+  * the vivid virtual driver can stand in for the camera: sudo modprobe vivid
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c) 2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  */
+
+#include <V4l2StereoCamera.hpp>
+
+int main(int argc, char *argv[]){
+
+    std::string device = argc > 1 ? argv[1] : "/dev/video0"; ///< device file
+    cv::Size frameSize(1856, 800);
+    if(argc > 3)
+        frameSize = cv::Size(atoi(argv[2]), atoi(argv[3]));
+
+    V4l2StereoCamera cam(device, 30, frameSize);
+    if(!cam.isOpened())
+        exit(EXIT_FAILURE);
+    std::cout << device << " " << cam.getPixelFormat() << " " << cam.getRawFrameSize()
+              << " " << cam.getRawFrameRate() << " fps" << std::endl;
+
+    if(!cam.startCapture())
+        exit(EXIT_FAILURE);
+
+    std::chrono::microseconds lastStamp(0);
+    uint64_t dropped = 0;
+    for(int i = 0; i < 300; i++){
+        cv::Mat frame;
+        V4l2FrameInfoType info;
+        if(!cam.getRawFrame(frame, info))
+            continue;
+
+        std::chrono::microseconds now = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch());
+        dropped += info.dropped;
+        std::cout << "sequence " << info.sequence
+                  << " dropped " << info.dropped
+                  << " interval " << (lastStamp.count() ? (info.timeStamp - lastStamp).count() / 1000.0 : 0) << " ms"
+                  << " exposure midpoint " << info.exposureMidpoint.count()
+                  << " latency " << (now - info.timeStamp).count() / 1000.0 << " ms"
+                  << (info.isDriverStamp ? "" : " (no driver time stamp)") << std::endl;
+        lastStamp = info.timeStamp;
+    }
+    std::cout << "total dropped " << dropped << std::endl;
+
+    cam.stopCapture();
+    return 0;
+}
@@ -0,0 +1,68 @@
+/**
+  * @file example_virtualCamera.cc
+  * @brief This file is part of UnitreeCameraSDK.
+  * @details This example that how to run the stereo pipeline without a camera, on the synthetic scene of a virtual
+  * camera, and check its disparity against ground truth
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c) 2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  */
+
+#include <VirtualStereoCamera.hpp>
+#include <StereoPipeline.hpp>
+
+int main(int argc, char *argv[]){
+    
+    int frames = argc > 1 ? atoi(argv[1]) : 100; ///< number of disparity images to check
+    VirtualStereoCamera cam(VIRTUAL_SOURCE_SYNTHETIC, 30, cv::Size(928, 400)); ///< or openStereoCamera() with DeviceNode -1
+    if(!cam.isOpened())
+        exit(EXIT_FAILURE);
+    
+    cam.startCapture();
+    
+    StereoFrameGrabber grabber;
+    grabber.startGrab(&cam);
+    
+    StereoPipeline pipeline;
+    pipeline.loadConfig("stereo_camera_config.yaml");
+    if(!pipeline.startPipeline(&cam, &grabber)){
+        grabber.stopGrab();
+        exit(EXIT_FAILURE);
+    }
+    
+    StereoPipelineConfigType config = pipeline.getConfig(); ///< ground truth is rendered in the rectified image of the pipeline
+    std::vector<cv::Mat> leftParams, rightParams;
+    cam.getCalibParams(leftParams, false);
+    cam.getCalibParams(rightParams, true);
+    StereoRectifier rectifier;
+    cv::Size rawSize(cam.getRawFrameSize().width / 2, cam.getRawFrameSize().height);
+    rectifier.init(leftParams, rightParams, config.calibFrameSize, rawSize, config.rectFrameSize,
+                   config.depthMode, config.hFov, "", config.depthRoi, config.decimation);
+    
+    uint64_t sequence = 0;
+    double errorSum = 0;
+    int checked = 0;
+    while(checked < frames){
+        FrameLease disparity;
+        if(!pipeline.waitForDisparity(disparity, sequence, std::chrono::milliseconds(500)))
+            continue;
+        cv::Mat truth;
+        cam.getGroundTruth(rectifier, disparity.timeStamp(), truth); ///< scene at the time stamp of the raw frame
+        cv::Mat valid = (truth > 0) & (disparity.data1() > 0);
+        int count = cv::countNonZero(valid);
+        if(count > 0){
+            double error = cv::norm(disparity.data1(), truth, cv::NORM_L1, valid) / 16 / count;
+            std::cout << "frame " << sequence << ": " << count << " matched pixels, mean error " << error << " px" << std::endl;
+            errorSum += error;
+            checked++;
+        }
+        disparity.release();
+    }
+    std::cout << "mean disparity error " << errorSum / std::max(checked, 1) << " px" << std::endl;
+    
+    pipeline.stopPipeline();
+    grabber.stopGrab();
+    cam.stopCapture();
+    
+    return 0;
+}
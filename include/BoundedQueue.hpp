@@ -0,0 +1,162 @@
+/**
+  * @file BoundedQueue.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare the bounded queue used between worker threads.
+  * @details fixed capacity ring queue with drop-oldest policy, the producer never blocks.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __BOUNDED_QUEUE_HPP__
+#define __BOUNDED_QUEUE_HPP__
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+  * @class BoundedQueue
+  * @brief fixed capacity queue with drop-oldest policy
+  * @details storage is allocated once, push() on a full queue drops the oldest item,
+  * pop() blocks until an item arrives or the queue is closed.
+  * @note T must be default constructible and move assignable
+  */
+template<typename T>
+class BoundedQueue
+{
+private:
+    std::vector<T> m_items;
+    size_t m_head = 0;
+    size_t m_count = 0;
+    uint64_t m_dropCount = 0;
+    bool m_isClosed = false;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_trigger;
+
+public:
+    /**
+      * @fn BoundedQueue
+      * @brief BoundedQueue constructor
+      * @param[in] capacity maximum number of queued items, at least 1
+      */
+    explicit BoundedQueue(size_t capacity = 2) : m_items(capacity < 1 ? 1 : capacity){
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+public:
+    /**
+      * @fn push
+      * @brief queue an item, drop the oldest one if queue is full
+      * @param[in] item queued item
+      * @return true or false, if no item was dropped return true, otherwise return false
+      */
+    bool push(T &&item){
+        bool dropped = false;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            if(m_isClosed)
+                return false;
+            if(m_count == m_items.size()){
+                m_head = (m_head + 1) % m_items.size();
+                m_count--;
+                m_dropCount++;
+                dropped = true;
+            }
+            m_items[(m_head + m_count) % m_items.size()] = std::move(item);
+            m_count++;
+        }
+        m_trigger.notify_one();
+        return !dropped;
+    }
+    /**
+      * @fn pop
+      * @brief take the oldest item, block until an item arrives or queue is closed
+      * @param[out] item oldest item
+      * @return true or false, if an item is taken return true, false if queue is closed
+      */
+    bool pop(T &item){
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_trigger.wait(lock, [this]{ return m_isClosed || m_count > 0; });
+        return take(item);
+    }
+    /**
+      * @fn popFor
+      * @brief take the oldest item, block until an item arrives, queue is closed or timeout
+      * @param[out] item oldest item
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if an item is taken return true, otherwise return false
+      */
+    bool popFor(T &item, std::chrono::microseconds timeout){
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_trigger.wait_for(lock, timeout, [this]{ return m_isClosed || m_count > 0; });
+        return take(item);
+    }
+    /**
+      * @fn open
+      * @brief drop queued items and accept new items
+      */
+    void open(void){
+        std::lock_guard<std::mutex> lock(m_lock);
+        clear();
+        m_isClosed = false;
+    }
+    /**
+      * @fn close
+      * @brief drop queued items and wake up all waiting threads
+      */
+    void close(void){
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            clear();
+            m_isClosed = true;
+        }
+        m_trigger.notify_all();
+    }
+    /**
+      * @fn size
+      * @brief get number of queued items
+      */
+    size_t size(void) const{
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_count;
+    }
+    /**
+      * @fn capacity
+      * @brief get maximum number of queued items
+      */
+    size_t capacity(void) const{
+        return m_items.size();
+    }
+    /**
+      * @fn dropCount
+      * @brief get number of items dropped because the queue was full
+      */
+    uint64_t dropCount(void) const{
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_dropCount;
+    }
+
+private:
+    bool take(T &item){
+        if(m_isClosed || m_count == 0)
+            return false;
+        item = std::move(m_items[m_head]);
+        m_items[m_head] = T();
+        m_head = (m_head + 1) % m_items.size();
+        m_count--;
+        return true;
+    }
+    void clear(void){
+        for(size_t i = 0; i < m_count; i++)
+            m_items[(m_head + i) % m_items.size()] = T();
+        m_head = 0;
+        m_count = 0;
+    }
+};
+
+#endif //__BOUNDED_QUEUE_HPP__
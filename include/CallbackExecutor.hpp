@@ -0,0 +1,75 @@
+/**
+  * @file CallbackExecutor.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare the bounded callback executor.
+  * @details frame callbacks can be handed off to a CallbackExecutor instead of running on the grab threads,
+  * so a slow consumer never delays capture.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __CALLBACK_EXECUTOR_HPP__
+#define __CALLBACK_EXECUTOR_HPP__
+
+#include <functional>
+#include <future>
+#include <vector>
+#include "BoundedQueue.hpp"
+#include "WorkerPool.hpp"
+
+/**
+  * @class CallbackExecutor
+  * @brief worker threads running queued tasks
+  * @details tasks wait in a BoundedQueue, when the queue is full the oldest task is dropped,
+  * so the submitting thread never blocks.
+  */
+class CallbackExecutor
+{
+public:
+    typedef std::function<void(void)> TaskType;
+
+private:
+    BoundedQueue<TaskType> m_tasks;
+    std::vector<std::future<void>> m_workers;
+
+public:
+    /**
+      * @fn CallbackExecutor
+      * @brief CallbackExecutor constructor
+      * @param[in] threadCount number of worker threads, at least 1
+      * @param[in] queueDepth maximum number of waiting tasks, at least 1
+      * @param[in] pool worker pool the threads are taken from, nullptr for WorkerPool::defaultPool()
+      * @code
+      *     CallbackExecutor executor(1, 2);
+      * @endcode
+      */
+    CallbackExecutor(int threadCount = 1, int queueDepth = 2, WorkerPool *pool = nullptr);
+    /**
+      * @fn ~CallbackExecutor
+      * @brief CallbackExecutor destructor
+      * @details drop waiting tasks and join worker threads, running tasks are finished
+      */
+    ~CallbackExecutor();
+
+    CallbackExecutor(const CallbackExecutor&) = delete;
+    CallbackExecutor& operator=(const CallbackExecutor&) = delete;
+
+public:
+    /**
+      * @fn submit
+      * @brief queue a task
+      * @param[in] task task to run on a worker thread
+      * @return true or false, if no waiting task was dropped return true, otherwise return false
+      */
+    bool submit(TaskType task);
+    /**
+      * @fn dropCount
+      * @brief get number of tasks dropped because the queue was full
+      */
+    uint64_t dropCount(void) const;
+
+private:
+    void taskWorker(void);
+};
+
+#endif //__CALLBACK_EXECUTOR_HPP__
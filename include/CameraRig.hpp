@@ -0,0 +1,328 @@
+/**
+  * @file CameraRig.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare the multi-camera rig APIs.
+  * @details several stereo cameras of one robot in one process, their disparity work runs on one shared set of
+  * worker threads and their products are delivered as time aligned frame sets.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __CAMERA_RIG_HPP__
+#define __CAMERA_RIG_HPP__
+
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "FrameChannel.hpp"
+#include "FramePool.hpp"
+#include "StageStats.hpp"
+#include "StereoFrameGrabber.hpp"
+#include "StereoPipeline.hpp"
+#include "VoxelGrid.hpp"
+#include "WorkerPool.hpp"
+
+/**
+  * @def RIG_POSITION_MAX
+  * @brief largest camera position number, face NO.1, chin NO.2, left NO.3, right NO.4, down NO.5
+  */
+#define RIG_POSITION_MAX 5
+
+/**
+  * @enum RigSchedule
+  * @brief order in which the rig workers take waiting frames of different cameras
+  */
+enum RigSchedule{
+    RIG_SCHEDULE_FAIR     = 0,  ///< the camera with the fewest processed frames goes first, older frame on a tie
+    RIG_SCHEDULE_PRIORITY = 1,  ///< the camera with the highest priority goes first, equal priorities are fair
+};
+
+/**
+  * @struct RigFrameSet
+  * @brief one product frame of every rig camera, taken at about the same time
+  */
+typedef struct RigFrameSet{
+    std::chrono::microseconds timeStamp;   ///< raw time stamp the frames are matched to, the one of the slowest camera
+    std::chrono::microseconds spread;      ///< largest time stamp difference between two frames of the set
+    uint64_t sequence = 0;                 ///< frame set sequence number, starts from 1, 0 means no frame set
+    std::vector<int> posNumbers;           ///< camera position numbers, ascending
+    std::vector<FrameLease> frames;        ///< product frame of the camera at the same index of posNumbers
+}RigFrameSetType;
+
+/**
+  * @class CameraRig
+  * @brief run several stereo cameras with one shared worker pool
+  * @details every camera keeps its capture and grab thread, raw frames are handed to the rig workers instead of
+  * to per-camera pipeline threads. A worker runs StereoPipeline::processFrame() of one camera at a time, a camera is
+  * never processed by two workers at once. A camera whose raw frame is still waiting when the next one arrives drops
+  * the older one. Each camera uses its own config file for calibration, rectification and matching, DisparityBands
+  * is forced to 1 so a frame runs on its worker thread only.
+  * Products of each camera are kept for a few frames. When every camera has a frame newer than the last frame set,
+  * the frames nearest to the latest frame of the slowest camera form the next frame set, if they are all within
+  * the sync tolerance of it.
+  * With per-camera extrinsics the point clouds come out of reprojection in the robot body frame already, so
+  * fuseCloud() merges a frame set into one body frame point cloud with a single copy, or a voxel downsampled one.
+  */
+class CameraRig
+{
+private:
+    typedef struct RigCamera{
+        int posNumber = 0;
+        int priority = 0;
+        std::string fileName;
+        bool isOwned = false;                 ///< camera is opened and deleted by the rig
+        bool isCloudSoA = false;
+        StereoCamera *camera = nullptr;
+        StereoFrameGrabber *grabber = nullptr;
+        StereoPipeline *pipeline = nullptr;
+        int rawCallback = -1;
+        FrameLease pending;                   ///< newest raw frame no worker has taken yet
+        bool isBusy = false;                  ///< a worker processes a frame of this camera
+        uint64_t served = 0;                  ///< frames taken by workers since startRig()
+        cv::Mat left, right, disparity;       ///< worker scratch images, one worker per camera at a time
+        FramePool *pool = nullptr;
+        FrameChannel channel;
+        StageStatsRecorder stats;
+    }RigCameraType;
+
+    int m_workerCount = 0;
+    int m_poolSize = 6;
+    int m_product = PIPELINE_DEPTH_FRAME;
+    std::vector<RigCameraType*> m_cameras;   ///< ascending position numbers
+    std::atomic<bool> m_isRunning;
+    WorkerPool *m_workerPool = nullptr;
+    std::vector<std::future<void>> m_workers;
+
+    std::mutex m_jobLock;                    ///< pending frames, busy flags, served counts, priorities, schedule
+    std::condition_variable m_jobTrigger;
+    int m_schedule = RIG_SCHEDULE_FAIR;
+
+    std::mutex m_setLock;
+    std::condition_variable m_setTrigger;
+    RigFrameSetType m_frameSet;
+    std::chrono::microseconds m_tolerance;  ///< 0 means half a raw frame period of the slowest camera
+    std::chrono::microseconds m_syncTolerance;
+    std::chrono::microseconds m_lastReference;  ///< time stamp of the last frame set, or of the last dropped one
+    uint64_t m_mismatchCount = 0;
+
+    std::mutex m_fuseLock;
+    float m_fusionVoxelSize = 0;             ///< 0 concatenates the camera point clouds
+    VoxelGrid m_fuseGrid;
+
+    SystemLog *m_log = nullptr;
+    std::string m_logName = "CameraRig";
+
+public:
+    /**
+      * @fn CameraRig
+      * @brief CameraRig constructor
+      * @param[in] workerCount frames processed at once, 0 for one per cpu core
+      * @param[in] poolSize pooled product buffers of each camera, keep it larger than the frame sets your consumers
+      * hold at once plus 2
+      * @code
+      *     CameraRig rig(4);
+      * @endcode
+      */
+    CameraRig(int workerCount = 0, int poolSize = 6);
+    /**
+      * @fn ~CameraRig
+      * @brief CameraRig destructor, stop the rig and close the cameras it opened
+      * @attention all leases and frame sets taken from this rig must be released before it is destroyed
+      */
+    virtual ~CameraRig();
+
+    CameraRig(const CameraRig&) = delete;
+    CameraRig& operator=(const CameraRig&) = delete;
+
+public:
+    /**
+      * @fn addCamera
+      * @brief open a camera by config file and add it at a position
+      * @param[in] posNumber camera position number, 1 to RIG_POSITION_MAX, unique in the rig
+      * @param[in] fileName camera config file, opened by openStereoCamera() and StereoPipeline::loadConfig()
+      * @param[in] priority scheduling priority with RIG_SCHEDULE_PRIORITY, larger goes first
+      * @return true or false, if rig is stopped and camera is opened return true, otherwise return false
+      * @code
+      *     rig.addCamera(1, "face_camera_config.yaml", 1);
+      *     rig.addCamera(5, "belly_camera_config.yaml");
+      * @endcode
+      */
+    virtual bool addCamera(int posNumber, std::string fileName, int priority = 0);
+    /**
+      * @fn addCamera
+      * @brief add an opened camera at a position, the caller keeps owning it
+      * @param[in] posNumber camera position number, 1 to RIG_POSITION_MAX, unique in the rig
+      * @param[in] camera opened stereo camera with calibration parameters
+      * @param[in] fileName pipeline config file, empty keeps the default StereoPipelineConfig
+      * @param[in] priority scheduling priority with RIG_SCHEDULE_PRIORITY, larger goes first
+      * @return true or false, if rig is stopped and camera is valid return true, otherwise return false
+      */
+    virtual bool addCamera(int posNumber, StereoCamera *camera, std::string fileName, int priority = 0);
+    /**
+      * @fn getCamera
+      * @brief get the camera at a position, nullptr if there is none
+      */
+    virtual StereoCamera* getCamera(int posNumber);
+    /**
+      * @fn getPosNumbers
+      * @brief get position numbers of the rig cameras, ascending
+      */
+    virtual std::vector<int> getPosNumbers(void) const;
+    /**
+      * @fn setProduct
+      * @brief select the product computed for every camera
+      * @param[in] product PIPELINE_DISPARITY, PIPELINE_DEPTH_FRAME or PIPELINE_POINT_CLOUD
+      * @return true or false, if rig is stopped and product is valid return true, otherwise return false
+      */
+    virtual bool setProduct(int product);
+    /**
+      * @fn setSchedule
+      * @brief select the order of waiting frames, can be changed while running
+      * @param[in] schedule one of RigSchedule
+      * @return true or false, if schedule is valid return true, otherwise return false
+      */
+    virtual bool setSchedule(int schedule);
+    /**
+      * @fn setPriority
+      * @brief change the priority of a camera, can be changed while running
+      * @return true or false, if camera is found return true, otherwise return false
+      */
+    virtual bool setPriority(int posNumber, int priority);
+    /**
+      * @fn setSyncTolerance
+      * @brief set the largest time stamp difference between a frame and the newest frame of its frame set
+      * @param[in] tolerance 0 for half a raw frame period of the slowest camera
+      */
+    virtual void setSyncTolerance(std::chrono::microseconds tolerance);
+    /**
+      * @fn setExtrinsics
+      * @brief set the pose of a camera on the robot, its point cloud is output in the body frame
+      * @details same as BodyTransform of the camera config file, which is read by addCamera()
+      * @param[in] posNumber camera position number
+      * @param[in] transform 4x4 or 3x4 matrix [R|t] from rectified left camera to body frame, empty for camera frame
+      * @return true or false, if rig is stopped, camera is found and transform is valid return true, otherwise return false
+      * @code
+      *     cv::Mat face = (cv::Mat_<double>(4, 4) << 0, 0, 1, 0.3,
+      *                                              -1, 0, 0, 0,
+      *                                              0, -1, 0, 0,
+      *                                              0, 0, 0, 1);
+      *     rig.setExtrinsics(1, face);
+      * @endcode
+      */
+    virtual bool setExtrinsics(int posNumber, const cv::Mat &transform);
+    /**
+      * @fn setFusionVoxelSize
+      * @brief downsample fused point clouds to one point per voxel, the centroid of its points
+      * @param[in] voxelSize voxel edge length, same unit as calibration translation, 0 keeps every point
+      * @return true or false, if voxelSize is not negative return true, otherwise return false
+      */
+    virtual bool setFusionVoxelSize(float voxelSize);
+    /**
+      * @fn fuseCloud
+      * @brief merge the point clouds of a frame set into one body frame point cloud
+      * @details the points are already transformed by the reprojection kernel, merging copies them once, or bins
+      * them into the voxel grid if a fusion voxel size is set
+      * @param[in] frameSet frame set of PIPELINE_POINT_CLOUD
+      * @param[out] cloud caller-owned point cloud, its arrays are reused between calls
+      * @return true or false, if the product is PIPELINE_POINT_CLOUD and frameSet is valid return true, otherwise return false
+      * @code
+      *     rig.setProduct(PIPELINE_POINT_CLOUD);
+      *     rig.setFusionVoxelSize(0.02f);
+      *     rig.startRig();
+      *     PointCloudSoAType cloud;
+      *     while(rig.waitForFrameSet(frameSet, sequence, std::chrono::milliseconds(100)))
+      *         if(rig.fuseCloud(frameSet, cloud))
+      *             publish(cloud);
+      * @endcode
+      */
+    virtual bool fuseCloud(const RigFrameSetType &frameSet, PointCloudSoAType &cloud);
+    /**
+      * @fn setWorkerPool
+      * @brief run the rig workers and the grab threads of all cameras on a pool
+      * @details the pool sets cpu cores, priority and names of the threads, the workers of the rig still limit how
+      * many frames are processed at once
+      * @param[in] pool worker pool, nullptr for WorkerPool::defaultPool(), it must outlive the rig threads
+      * @return true or false, if rig is stopped return true, otherwise return false
+      * @code
+      *     WorkerPoolConfigType config;
+      *     config.cpus = {4, 5, 6, 7};
+      *     WorkerPool pool(config);
+      *     rig.setWorkerPool(&pool);
+      * @endcode
+      */
+    virtual bool setWorkerPool(WorkerPool *pool);
+    /**
+      * @fn startRig
+      * @brief start capture, grab threads and shared workers of all cameras
+      * @return true or false, if all cameras are started return true, otherwise return false
+      * @code
+      *     rig.setSchedule(RIG_SCHEDULE_PRIORITY);
+      *     if(!rig.startRig())
+      *         exit(EXIT_FAILURE);
+      * @endcode
+      */
+    virtual bool startRig(void);
+    /**
+      * @fn stopRig
+      * @brief stop workers, grab threads and capture, threads blocked in waitFor*() functions return false
+      */
+    virtual bool stopRig(void);
+    /**
+      * @fn isRunning
+      * @brief get rig running status
+      */
+    virtual bool isRunning(void) const;
+    /**
+      * @fn waitForFrame
+      * @brief block until a product frame of one camera newer than the last consumed one arrives
+      * @param[in] posNumber camera position number
+      * @param[out] lease product frame, see setProduct()
+      * @param[in,out] sequence in: sequence number of the last consumed frame, out: sequence number of the leased frame
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a new frame is leased return true, false on timeout or after stopRig()
+      */
+    virtual bool waitForFrame(int posNumber, FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout);
+    /**
+      * @fn waitForFrameSet
+      * @brief block until a frame set newer than the last consumed one is complete
+      * @param[out] frameSet product frames of all cameras
+      * @param[in,out] sequence in: sequence number of the last consumed frame set, out: sequence number of frameSet
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a new frame set is taken return true, false on timeout or after stopRig()
+      * @code
+      *     RigFrameSetType frameSet;
+      *     uint64_t sequence = 0;
+      *     while(rig.waitForFrameSet(frameSet, sequence, std::chrono::milliseconds(100))){
+      *         for(size_t i = 0; i < frameSet.frames.size(); i++)
+      *             cv::imshow(std::to_string(frameSet.posNumbers[i]), frameSet.frames[i].data1());
+      *         frameSet = RigFrameSetType();   // release the leases
+      *     }
+      * @endcode
+      */
+    virtual bool waitForFrameSet(RigFrameSetType &frameSet, uint64_t &sequence, std::chrono::microseconds timeout);
+    /**
+      * @fn getMismatchCount
+      * @brief get number of frame sets dropped because a frame was outside the sync tolerance
+      */
+    virtual uint64_t getMismatchCount(void);
+    /**
+      * @fn getStats
+      * @brief get processing latency and frame counters of every camera
+      * @details a raw frame replaced before a worker took it counts as dropped, stage names are "pos1" to "pos5"
+      * @param[out] stats one entry per camera, ascending position numbers
+      */
+    virtual void getStats(std::vector<StageStatsType> &stats) const;
+
+private:
+    bool insertCamera(int posNumber, StereoCamera *camera, std::string fileName, int priority, bool isOwned);
+    RigCameraType* findCamera(int posNumber) const;
+    RigCameraType* nextCamera(void);
+    void rigWorker(void);
+    void processFrame(RigCameraType *camera, const FrameLease &raw);
+    void updateFrameSet(void);
+};
+
+#endif //__CAMERA_RIG_HPP__
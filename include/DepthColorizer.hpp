@@ -0,0 +1,99 @@
+/**
+  * @file DepthColorizer.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare lookup-table depth colorization APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __DEPTH_COLORIZER_HPP__
+#define __DEPTH_COLORIZER_HPP__
+
+#include <cstdint>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+/**
+  * @enum DepthPalette
+  * @brief colors of depth, from near to far
+  */
+enum DepthPalette{
+    PALETTE_JET   = 0,  ///< blue, cyan, yellow, red
+    PALETTE_TURBO = 1,  ///< perceptually smoother jet
+    PALETTE_HOT   = 2,  ///< black, red, yellow, white
+    PALETTE_GRAY  = 3,  ///< black to white
+};
+
+/**
+  * @def DEPTH_LUT_SIZE
+  * @brief number of colors a depth range is divided into
+  */
+#define DEPTH_LUT_SIZE 4096
+
+/**
+  * @class DepthColorizer
+  * @brief colorize depth images through a precomputed color table
+  * @details the palette is sampled once into a table, colorizing a pixel is a scale, a clamp and a table lookup.
+  * Invalid pixels (depth 0) are black.
+  */
+class DepthColorizer
+{
+private:
+    int m_palette = PALETTE_JET;
+    float m_minDepth = 0.05f;
+    float m_maxDepth = 1.0f;
+    bool m_isInverted = false;
+    std::vector<uint32_t> m_lut;    ///< DEPTH_LUT_SIZE colors and black for invalid depth, packed blue, green, red
+    std::vector<uint32_t> m_lut8;   ///< 256 colors for 8 bit gray depth, 0 is black
+
+public:
+    /**
+      * @fn DepthColorizer
+      * @brief DepthColorizer constructor
+      * @param[in] palette one of DepthPalette
+      * @param[in] minDepth depth of the first color, unit is meter
+      * @param[in] maxDepth depth of the last color, unit is meter
+      */
+    DepthColorizer(int palette = PALETTE_JET, float minDepth = 0.05f, float maxDepth = 1.0f);
+    ~DepthColorizer();
+
+public:
+    /**
+      * @fn setPalette
+      * @brief select colors
+      * @param[in] palette one of DepthPalette
+      * @param[in] inverted true to color far to near instead of near to far
+      * @return true or false, if palette is valid return true, otherwise return false
+      */
+    bool setPalette(int palette, bool inverted = false);
+    /**
+      * @fn setDepthRange
+      * @brief set depth of the first and last color, depth out of range gets the first or last color
+      * @return true or false, if minDepth < maxDepth return true, otherwise return false
+      */
+    bool setDepthRange(float minDepth, float maxDepth);
+    /**
+      * @fn getPalette
+      * @brief get selected palette
+      */
+    int getPalette(void) const;
+    /**
+      * @fn colorize
+      * @brief colorize depth image
+      * @param[in] depth CV_32FC1 depth in meter, CV_16UC1 depth in millimeter, or CV_8UC1 gray depth
+      * of StereoCamera::getDepthFrame() whose 256 levels span the whole palette
+      * @param[out] color CV_8UC3 colorized depth
+      * @return true or false, if depth type is supported return true, otherwise return false
+      * @code
+      *     DepthColorizer colorizer(PALETTE_TURBO, 0.1f, 1.5f);
+      *     colorizer.colorize(depth, color);
+      *     cv::imshow("depth", color);
+      * @endcode
+      */
+    bool colorize(const cv::Mat &depth, cv::Mat &color) const;
+
+private:
+    void buildTable(void);
+};
+
+#endif //__DEPTH_COLORIZER_HPP__
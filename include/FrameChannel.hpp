@@ -0,0 +1,207 @@
+/**
+  * @file FrameChannel.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare the latest-frame channel APIs.
+  * @details a FrameChannel keeps the latest published frame lease of one product (raw, rectified, depth, ...)
+  * and wakes up consumers waiting for a frame newer than the one they consumed last,
+  * registered callbacks are pushed every new frame.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __FRAME_CHANNEL_HPP__
+#define __FRAME_CHANNEL_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "CallbackExecutor.hpp"
+#include "FramePool.hpp"
+
+/**
+  * @def FRAME_HISTORY_MAX
+  * @brief largest history depth of a FrameChannel
+  */
+#define FRAME_HISTORY_MAX 64
+
+/**
+  * @class FrameChannel
+  * @brief latest-frame channel of one product
+  * @details one producer publishes leases with increasing sequence numbers, any number of consumers
+  * lease the latest frame or block until a newer one arrives.
+  *
+  * The latest frame is one atomic word of sequence number and pool slot. Consumers lease it lock-free through
+  * FramePool::tryLease() and retry if the producer replaced it meanwhile, so reading never blocks the producer
+  * and always returns a complete frame with its own time stamp. The producer only takes a lock to wake
+  * consumers sleeping in waitNewer(), and only when there are any.
+  */
+class FrameChannel
+{
+public:
+    typedef std::function<void(const FrameLease&)> FrameCallbackType;
+
+private:
+    typedef struct CallbackEntry{
+        int id;
+        FrameCallbackType callback;
+        CallbackExecutor *executor;
+        bool isRemoved = false;               ///< set by removeCallback(), guarded by m_callbackLock
+    }CallbackEntryType;
+
+    typedef struct HistoryEntry{
+        std::atomic<uint64_t> slot;           ///< like m_latestSlot, 0 while the entry is rewritten
+        std::atomic<int64_t> timeStamp;       ///< unit is microsecond
+        FrameLease lease;                     ///< reference of the channel, written by the producer only
+    }HistoryEntryType;
+
+    std::atomic<bool> m_isClosed;
+    std::atomic<uint64_t> m_sequence;
+    std::atomic<uint64_t> m_latestSlot;      ///< sequence << 16 | slot index + 1, 0 if there is no frame
+    std::atomic<FramePool*> m_latestPool;
+    FrameLease m_latest;                     ///< reference of the channel that keeps the latest slot committed
+    mutable std::atomic<int> m_readers;      ///< consumers leasing a slot, close() waits for them
+    std::atomic<int> m_historyDepth;
+    HistoryEntryType m_history[FRAME_HISTORY_MAX];   ///< frame of sequence s at s % m_historyDepth
+
+    int m_callbackId = 0;
+    std::vector<std::shared_ptr<CallbackEntryType>> m_callbacks;
+    std::vector<std::shared_ptr<CallbackEntryType>> m_pushList;   ///< copy of m_callbacks, producer thread only
+    std::atomic<int> m_callbackCount;
+    int m_runningId = 0;                     ///< inline callback running on the producer thread, 0 for none
+    std::thread::id m_pushThread;            ///< producer thread of the last pushCallbacks()
+    std::condition_variable m_callbackDone;
+
+    std::mutex m_lock;                       ///< producer side: publish(), open() and close()
+    std::mutex m_waitLock;
+    std::atomic<int> m_waiters;
+    std::mutex m_callbackLock;               ///< m_callbacks, m_runningId and m_pushThread, not held by callbacks
+    std::condition_variable m_trigger;
+
+public:
+    FrameChannel(void);
+    ~FrameChannel();
+
+    FrameChannel(const FrameChannel&) = delete;
+    FrameChannel& operator=(const FrameChannel&) = delete;
+
+public:
+    /**
+      * @fn open
+      * @brief drop the latest frame and accept new frames
+      * @details sequence numbers continue from the last published frame
+      */
+    void open(void);
+    /**
+      * @fn close
+      * @brief drop the latest frame and wake up all waiting consumers
+      * @details waitNewer() returns false while the channel is closed
+      */
+    void close(void);
+    /**
+      * @fn nextSequence
+      * @brief get the sequence number of the next published frame
+      * @note called by producer before it commits the frame
+      */
+    uint64_t nextSequence(void) const;
+    /**
+      * @fn publish
+      * @brief make lease the latest frame and wake up waiting consumers
+      * @param[in] lease frame lease, its sequence must be nextSequence()
+      */
+    void publish(FrameLease &&lease);
+    /**
+      * @fn latest
+      * @brief lease the latest frame without blocking, lock-free
+      * @param[out] lease latest frame
+      * @return true or false, if a frame has been published return true, otherwise return false
+      */
+    bool latest(FrameLease &lease) const;
+    /**
+      * @fn waitNewer
+      * @brief block until a frame newer than sequence is published
+      * @param[out] lease latest frame
+      * @param[in,out] sequence in: sequence number of the last consumed frame, 0 for any frame,
+      * out: sequence number of the leased frame
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a newer frame is leased return true, false on timeout or closed channel
+      */
+    bool waitNewer(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout);
+    /**
+      * @fn setHistoryDepth
+      * @brief keep the last depth published frames for findFrame()
+      * @details the channel holds a lease of every kept frame, so the pool needs depth more buffers.
+      * Changing the depth drops the kept frames.
+      * @param[in] depth number of frames, 0 keeps only the latest frame, at most FRAME_HISTORY_MAX
+      * @return true or false, if depth is valid return true, otherwise return false
+      */
+    bool setHistoryDepth(int depth);
+    /**
+      * @fn historyDepth
+      * @brief get number of kept frames
+      */
+    int historyDepth(void) const;
+    /**
+      * @fn findFrame
+      * @brief lease a kept frame by time stamp without blocking, lock-free
+      * @param[in] timeStamp time stamp to look up, time since 1970-01-01 00:00:00, unit is microseconds
+      * @param[out] lease kept frame whose time stamp is nearest to timeStamp, the newer one on a tie
+      * @param[in] exact only lease a frame with exactly timeStamp
+      * @return true or false, if a frame is leased return true, otherwise return false
+      * @code
+      *     FrameLease lease;
+      *     if(channel.findFrame(imuStamp, lease) && std::abs((lease.timeStamp() - imuStamp).count()) < 5000){
+      *         // frame within 5 ms of the imu sample
+      *     }
+      * @endcode
+      */
+    bool findFrame(std::chrono::microseconds timeStamp, FrameLease &lease, bool exact = false) const;
+    /**
+      * @fn findFrame
+      * @brief lease a kept frame by sequence number without blocking, lock-free
+      * @param[in] sequence sequence number of the frame
+      * @param[out] lease kept frame
+      * @return true or false, if the frame is still kept return true, otherwise return false
+      */
+    bool findFrame(uint64_t sequence, FrameLease &lease) const;
+    /**
+      * @fn addCallback
+      * @brief register a callback pushed every new frame
+      * @details without executor the callback runs on the producer thread right after the frame is published,
+      * so it must return quickly. With executor the callback is queued to it together with a lease of the frame.
+      * Callbacks are called without any lock of the channel held, an inline callback may add or remove callbacks,
+      * itself included.
+      * @param[in] callback function called with a lease of the new frame
+      * @param[in] executor optional executor the callback is handed off to
+      * @return callback id, pass it to removeCallback()
+      */
+    int addCallback(FrameCallbackType callback, CallbackExecutor *executor = nullptr);
+    /**
+      * @fn removeCallback
+      * @brief unregister a callback
+      * @details when it returns the callback is not running on the producer thread any more,
+      * calls already queued to an executor still run. Called from the producer thread, such as by an inline
+      * callback, it does not wait, the calling callback finishes after it returns.
+      * @param[in] id callback id returned by addCallback()
+      * @return true or false, if callback is found return true, otherwise return false
+      */
+    bool removeCallback(int id);
+    /**
+      * @fn callbackCount
+      * @brief get number of registered callbacks, it does not wait for running callbacks
+      */
+    int callbackCount(void) const;
+
+private:
+    bool leaseLatest(FrameLease &lease, uint64_t &sequence) const;
+    bool leaseSlot(uint64_t slot, FrameLease &lease) const;
+    void clearLatest(void);
+    void wakeWaiters(void);
+    void pushCallbacks(const FrameLease &lease);
+};
+
+#endif //__FRAME_CHANNEL_HPP__
@@ -0,0 +1,243 @@
+/**
+  * @file FramePool.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare the pooled frame buffers and frame lease APIs.
+  * @details A FramePool owns a fixed ring of frame buffers that are reused for every captured frame,
+  * a FrameLease is a ref-counted, read-only handle to one of these buffers.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __FRAME_POOL_HPP__
+#define __FRAME_POOL_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "PointCloudSoA.hpp"
+#include "StereoCameraCommon.hpp"
+
+/**
+  * @struct PooledFrame
+  * @brief frame buffer owned by a FramePool
+  * @details data1 and data2 keep their allocation between frames, so writing a frame of the same
+  * size and type into a recycled slot does not allocate.
+  * @note raw and depth frames only use data1, rectified frames use data1 as left and data2 as right image,
+  * point cloud frames use cloud or cloudSoA
+  */
+typedef struct PooledFrame{
+    cv::Mat data1;                        ///< frame data
+    cv::Mat data2;                        ///< frame data
+    std::vector<PCLType> cloud;           ///< point cloud data, keeps its capacity between frames
+    PointCloudSoAType cloudSoA;           ///< point cloud data in structure-of-arrays layout
+    std::chrono::microseconds timeStamp;  ///< time since 1970-01-01 00:00:00, unit is microseconds(10^-6 s)
+    uint64_t sequence = 0;                ///< frame sequence number, starts from 1, 0 means no frame
+}PooledFrameType;
+
+class FramePool;
+
+/**
+  * @class FrameLease
+  * @brief ref-counted read-only handle of a pooled frame
+  * @details copying a lease only increments the reference count of the pooled buffer, no image data is copied.
+  * The buffer goes back to its pool when the last lease is released or destroyed.
+  * @attention the frame data must not be modified, and every lease must be released before its pool is destroyed.
+  */
+class FrameLease
+{
+private:
+    FramePool *m_pool = nullptr;
+    int m_index = -1;
+
+public:
+    FrameLease(void);
+    FrameLease(const FrameLease &other);
+    FrameLease(FrameLease &&other);
+    FrameLease& operator=(const FrameLease &other);
+    FrameLease& operator=(FrameLease &&other);
+    ~FrameLease();
+
+public:
+    /**
+      * @fn isValid
+      * @brief tell whether lease holds a frame
+      * @param[in] None
+      * @param[out] None
+      * @return true or false, if lease holds a frame return true, otherwise return false
+      */
+    bool isValid(void) const;
+    /**
+      * @fn frame
+      * @brief get the leased frame
+      * @param[in] None
+      * @param[out] None
+      * @return read-only reference of pooled frame
+      * @attention only call it on a valid lease
+      */
+    const PooledFrameType& frame(void) const;
+    /**
+      * @fn data1
+      * @brief get the first image of leased frame
+      * @return read-only image, it shares memory with the pooled buffer
+      */
+    const cv::Mat& data1(void) const;
+    /**
+      * @fn data2
+      * @brief get the second image of leased frame
+      * @return read-only image, it shares memory with the pooled buffer
+      */
+    const cv::Mat& data2(void) const;
+    /**
+      * @fn cloud
+      * @brief get the point cloud of leased frame
+      * @return read-only point cloud, it shares memory with the pooled buffer
+      */
+    const std::vector<PCLType>& cloud(void) const;
+    /**
+      * @fn cloudSoA
+      * @brief get the structure-of-arrays point cloud of leased frame
+      * @return read-only point cloud, it shares memory with the pooled buffer
+      */
+    const PointCloudSoAType& cloudSoA(void) const;
+    /**
+      * @fn timeStamp
+      * @brief get leased frame time stamp
+      * @return time since 1970-01-01 00:00:00, unit is microseconds
+      */
+    std::chrono::microseconds timeStamp(void) const;
+    /**
+      * @fn sequence
+      * @brief get leased frame sequence number
+      * @return frame sequence number, 0 if lease is invalid
+      */
+    uint64_t sequence(void) const;
+    /**
+      * @fn release
+      * @brief give the frame back to its pool
+      * @details after release the lease is invalid, calling release on an invalid lease does nothing
+      * @code
+      *     FrameLease lease;
+      *     if(grabber.getRawFrame(lease)){
+      *         // use lease.data1()
+      *         lease.release();
+      *     }
+      * @endcode
+      */
+    void release(void);
+
+private:
+    friend class FramePool;
+    friend class FrameChannel;
+    FrameLease(FramePool *pool, int index);
+};
+
+/**
+  * @class FramePool
+  * @brief fixed ring of reusable frame buffers
+  * @details a producer claims a free slot by acquire(), fills it and turns it into the first lease by commit().
+  * Slots are recycled in ring order, a slot is free when no lease refers to it.
+  * @note acquire(), commit() and discard() are called by one producer thread, leases can be used from any thread
+  */
+class FramePool
+{
+private:
+    typedef struct Slot{
+        PooledFrameType frame;
+        std::atomic<int> refCount;   ///< lease count, 0 means free, -1 means claimed by producer
+    }SlotType;
+
+    int m_size = 0;
+    int m_cursor = 0;
+    SlotType *m_slots = nullptr;
+
+    std::atomic<int> m_waiters;      ///< threads in waitFree(), release() only signals when there is one
+    std::mutex m_freeLock;
+    std::condition_variable m_freeSignal;
+
+public:
+    /**
+      * @fn FramePool
+      * @brief FramePool constructor
+      * @param[in] size number of frame buffers in the ring, at least 2
+      * @param[out] None
+      * @return None
+      */
+    explicit FramePool(int size = 4);
+    ~FramePool();
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+public:
+    /**
+      * @fn size
+      * @brief get number of buffers in the ring
+      */
+    int size(void) const;
+    /**
+      * @fn freeCount
+      * @brief get number of buffers not held by any lease
+      */
+    int freeCount(void) const;
+    /**
+      * @fn acquire
+      * @brief claim a free buffer for writing
+      * @param[in] None
+      * @param[out] index slot index, pass it to commit() or discard()
+      * @return writable frame buffer, nullptr if all buffers are leased
+      * @note the returned buffer still holds the data of a previous frame
+      */
+    PooledFrameType* acquire(int &index);
+    /**
+      * @fn commit
+      * @brief finish writing a claimed buffer
+      * @param[in] index slot index returned by acquire()
+      * @param[out] None
+      * @return the first lease of the frame
+      */
+    FrameLease commit(int index);
+    /**
+      * @fn discard
+      * @brief give a claimed buffer back without publishing it
+      * @param[in] index slot index returned by acquire()
+      */
+    void discard(int index);
+    /**
+      * @fn waitFree
+      * @brief block until a buffer is free or timeout
+      * @details the last release of a buffer wakes the waiting thread, so a producer that found every buffer
+      * leased sleeps instead of retrying acquire()
+      * @param[in] timeout longest time to wait
+      * @return true or false, if a buffer is free return true, otherwise return false
+      * @code
+      *     PooledFrameType *slot = pool.acquire(index);
+      *     if(!slot && pool.waitFree(std::chrono::milliseconds(10)))
+      *         slot = pool.acquire(index);
+      * @endcode
+      */
+    bool waitFree(std::chrono::microseconds timeout);
+    /**
+      * @fn tryLease
+      * @brief lease a committed frame by slot index without locking, from any thread
+      * @details the reference count is only raised while it is positive, so a slot being written or recycled is
+      * never leased. The frame is checked after it is held, a slot that was recycled meanwhile fails.
+      * @param[in] index slot index
+      * @param[in] sequence sequence number the frame must have
+      * @param[out] lease frame lease, unchanged on failure
+      * @return true or false, if the slot is committed and holds sequence return true, otherwise return false
+      */
+    bool tryLease(int index, uint64_t sequence, FrameLease &lease);
+
+private:
+    friend class FrameLease;
+    void retain(int index);
+    void release(int index);
+    bool hasFree(void) const;
+    const PooledFrameType& frame(int index) const;
+};
+
+#endif //__FRAME_POOL_HPP__
@@ -0,0 +1,131 @@
+/**
+  * @file HostStereoCamera.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare the base of stereo cameras rectified on the host.
+  * @details calibration parameters and rectification shared by VirtualStereoCamera and V4l2StereoCamera, which
+  * read raw frames without the prebuilt library and rectify them with StereoRectifier.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __HOST_STEREO_CAMERA_HPP__
+#define __HOST_STEREO_CAMERA_HPP__
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "StereoCameraCommon.hpp"
+#include "StereoRectifier.hpp"
+#include "SystemLog.hpp"
+
+/**
+  * @class HostStereoCamera
+  * @brief stereo camera whose raw frames are rectified on the host with loaded calibration parameters
+  * @details derived cameras implement raw frame capture, getRectStereoFrame() rectifies the next raw frame with
+  * rectifyFrame(). The rectified size, projection and field of view are RectifyFrameSize, Depthmode and hFov of
+  * the config file when the camera is opened by openStereoCamera(), longlat at 464x400 otherwise.
+  */
+class HostStereoCamera : public StereoCamera
+{
+public:
+    static const cv::Size CALIB_SIZE;           ///< image size the calibration parameters belong to, same as StereoPipelineConfig::calibFrameSize
+
+protected:
+    std::vector<cv::Mat> m_leftParams, m_rightParams;
+
+    cv::Size m_rectSize = cv::Size(464, 400);
+    int m_rectMode = RECTIFY_LONGLAT;
+    double m_hFov = 90;
+    StereoRectifier m_rectifier;
+    bool m_isRectInit = false;                  ///< m_rectifier built from the current parameters and sizes
+    cv::Size m_rectRawSize;                     ///< raw image size m_rectifier is built for
+    std::mutex m_rectLock;
+
+    SystemLog *m_log = nullptr;
+
+public:
+    /**
+      * @fn HostStereoCamera
+      * @brief HostStereoCamera constructor
+      * @param[in] logName log name of the derived camera
+      */
+    HostStereoCamera(std::string logName);
+    virtual ~HostStereoCamera();
+
+    HostStereoCamera(const HostStereoCamera&) = delete;
+    HostStereoCamera& operator=(const HostStereoCamera&) = delete;
+
+public:
+    /**
+      * @fn getRectStereoFrame
+      * @brief rectify the next raw frame with the calibration of this camera
+      */
+    virtual bool getRectStereoFrame(cv::Mat &left, cv::Mat &right);
+    /**
+      * @fn getRectStereoFrame
+      * @brief not supported, the feim output of the camera is not available
+      * @return false
+      */
+    virtual bool getRectStereoFrame(cv::Mat &left, cv::Mat &right, cv::Mat &feim);
+    virtual bool getRectStereoFrame(cv::Mat &left, cv::Mat &right, cv::Mat &feim,
+                                    std::chrono::microseconds &timeStamp);
+    virtual bool getCalibParams(std::vector<cv::Mat> &paramsArray, bool flag = false);
+    virtual bool setCalibParams(std::vector<cv::Mat> paramsArray, bool flag = false);
+    /**
+      * @fn loadCalibParams
+      * @brief load calibration parameters written by exportCalibParams()
+      */
+    virtual bool loadCalibParams(std::string fileName);
+    /**
+      * @fn saveCalibParams
+      * @brief save calibration parameters in the format of exportCalibParams()
+      */
+    virtual bool saveCalibParams(std::string fileName = "stereo_camera_calibparams.yaml");
+
+public:
+    /**
+      * @fn setRectParams
+      * @brief set the output of getRectStereoFrame() and rectifyFrame()
+      * @param[in] rectSize rectified image size
+      * @param[in] mode RECTIFY_LONGLAT or RECTIFY_PERSPECTIVE
+      * @param[in] hFov horizontal field of view of RECTIFY_PERSPECTIVE, unit is degree
+      * @return true or false, if parameters are valid return true, otherwise return false
+      */
+    bool setRectParams(cv::Size rectSize, int mode, double hFov);
+    /**
+      * @fn rectifyFrame
+      * @brief rectify a raw frame of this camera, such as one leased from StereoFrameGrabber
+      * @param[in] frame raw frame, right image at the left half and left image at the right half
+      * @param[out] left rectified left image
+      * @param[out] right rectified right image
+      * @return true or false, if calibration parameters are set and frame is rectified return true,
+      * otherwise return false
+      * @code
+      *     FrameLease lease;
+      *     if(grabber.getRawFrame(lease) && cam.rectifyFrame(lease.data1(), left, right))
+      *         process(left, right, lease.timeStamp());
+      * @endcode
+      */
+    bool rectifyFrame(const cv::Mat &frame, cv::Mat &left, cv::Mat &right);
+    /**
+      * @fn exportCalibParams
+      * @brief save the calibration parameters of any stereo camera for replaying its recordings
+      * @param[in] camera opened stereo camera
+      * @param[in] fileName output yaml file
+      * @return true or false, if parameters are saved return true, otherwise return false
+      */
+    static bool exportCalibParams(StereoCamera &camera, std::string fileName);
+    /**
+      * @fn importCalibParams
+      * @brief read calibration parameters written by exportCalibParams()
+      * @param[in] fileName yaml file
+      * @param[out] leftParams left camera parameters
+      * @param[out] rightParams right camera parameters
+      * @return true or false, if both cameras have an intrinsic matrix return true, otherwise return false
+      */
+    static bool importCalibParams(std::string fileName, std::vector<cv::Mat> &leftParams, std::vector<cv::Mat> &rightParams);
+};
+
+#endif //__HOST_STEREO_CAMERA_HPP__
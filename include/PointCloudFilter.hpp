@@ -0,0 +1,80 @@
+/**
+  * @file PointCloudFilter.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare point cloud downsampling and outlier filter APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __POINT_CLOUD_FILTER_HPP__
+#define __POINT_CLOUD_FILTER_HPP__
+
+#include <vector>
+#include "PointCloudSoA.hpp"
+#include "StereoCameraCommon.hpp"
+#include "VoxelGrid.hpp"
+
+/**
+  * @class PointCloudFilter
+  * @brief voxel grid downsampling followed by radius outlier removal
+  * @details the voxel grid replaces the points of every voxel by their centroid and mean color. The outlier filter
+  * then drops points with fewer than minNeighbors other points within radius. Neighbors are searched in a second
+  * voxel grid with radius sized cells, the points are sorted by cell with a counting sort, so a point only visits
+  * the 27 cells around it. Working buffers are kept between frames and only grow, filtering does not allocate
+  * once the clouds stop getting larger.
+  */
+class PointCloudFilter
+{
+private:
+    float m_voxelSize = 0;
+    float m_radius = 0;
+    int m_minNeighbors = 2;
+    VoxelGrid m_voxelGrid;
+    VoxelGrid m_radiusGrid;
+    PointCloudSoAType m_scratch;
+    std::vector<uint32_t> m_voxels;   ///< radius cell of every point
+    std::vector<uint32_t> m_starts;   ///< first entry of every radius cell in m_order
+    std::vector<uint32_t> m_order;    ///< point indices sorted by radius cell
+
+public:
+    PointCloudFilter(void);
+    ~PointCloudFilter();
+
+public:
+    /**
+      * @fn setParams
+      * @brief set filter parameters
+      * @param[in] voxelSize voxel edge length, same unit as the points, 0 disables downsampling
+      * @param[in] radius neighbor search radius, 0 disables outlier removal
+      * @param[in] minNeighbors points with fewer other points within radius are dropped, at least 1
+      * @return true or false, if parameters are valid return true, otherwise return false
+      */
+    bool setParams(float voxelSize, float radius, int minNeighbors);
+    /**
+      * @fn isValidParams
+      * @brief check filter parameters without setting them, see setParams()
+      */
+    static bool isValidParams(float voxelSize, float radius, int minNeighbors);
+    /**
+      * @fn isEnabled
+      * @brief get whether downsampling or outlier removal is on
+      */
+    bool isEnabled(void) const;
+    /**
+      * @fn apply
+      * @brief filter a point cloud in place
+      * @param[in,out] cloud point cloud, cloud.count is set to the number of points kept
+      */
+    void apply(PointCloudSoAType &cloud);
+    /**
+      * @fn apply
+      * @brief filter a color point cloud in place
+      * @param[in,out] cloud point cloud, resized to the points kept, its capacity is kept
+      */
+    void apply(std::vector<PCLType> &cloud);
+
+private:
+    void removeOutliers(PointCloudSoAType &cloud);
+};
+
+#endif //__POINT_CLOUD_FILTER_HPP__
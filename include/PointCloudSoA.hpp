@@ -0,0 +1,65 @@
+/**
+  * @file PointCloudSoA.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare the structure-of-arrays point cloud.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __POINT_CLOUD_SOA_HPP__
+#define __POINT_CLOUD_SOA_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+  * @struct PointCloudSoA
+  * @brief point cloud in structure-of-arrays layout
+  * @details x, y, z and color are separate arrays, the first count entries of each are valid points.
+  * Arrays are sized to capacity once and keep their memory, filling the cloud again does not allocate.
+  * color packs one point into 4 bytes, in memory order blue, green, red, 0, so it uploads as BGRA without repacking.
+  * @code
+  *     PointCloudSoA cloud;
+  *     cloud.reserve(464 * 400);
+  *     reprojector.reproject(disparity, left, 0.05f, 1.f, nullptr, cloud);
+  *     for(size_t i = 0; i < cloud.count; i++)
+  *         sum += cloud.z[i];
+  * @endcode
+  */
+typedef struct PointCloudSoA{
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<uint32_t> color;
+    size_t count = 0;   ///< number of valid points
+
+    /**
+      * @fn reserve
+      * @brief make room for at least capacity points, never shrinks
+      */
+    void reserve(size_t capacity){
+        if(x.size() >= capacity)
+            return;
+        x.resize(capacity);
+        y.resize(capacity);
+        z.resize(capacity);
+        color.resize(capacity);
+    }
+    /**
+      * @fn capacity
+      * @brief get number of points the arrays hold
+      */
+    size_t capacity(void) const{
+        return x.size();
+    }
+    /**
+      * @fn packColor
+      * @brief pack blue, green and red into one color entry
+      */
+    static uint32_t packColor(uint8_t b, uint8_t g, uint8_t r){
+        return (uint32_t)b | ((uint32_t)g << 8) | ((uint32_t)r << 16);
+    }
+}PointCloudSoAType;
+
+#endif //__POINT_CLOUD_SOA_HPP__
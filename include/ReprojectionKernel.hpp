@@ -0,0 +1,68 @@
+/**
+  * @file ReprojectionKernel.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare the row kernel of disparity reprojection.
+  * @details one pass over a disparity row looks up the distance of every pixel, filters it against the depth range,
+  * writes the depth row and compacts valid points into structure-of-arrays output.
+  * NEON is used on arm64, AVX2 on amd64 when built with it (UNITREE_CAMERA_AVX2), otherwise SSE2, or scalar code.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __REPROJECTION_KERNEL_HPP__
+#define __REPROJECTION_KERNEL_HPP__
+
+/**
+  * @def REPROJECT_ROW_PADDING
+  * @brief extra entries x, y, z and index need behind the valid points, vector code stores whole registers
+  */
+#define REPROJECT_ROW_PADDING 8
+
+/**
+  * @struct ReprojectRowArgs
+  * @brief inputs of one row, the viewing ray of pixel (u, v) is (colA[u], colS[u] * rowP, colS[u] * rowR)
+  * and its distance is colS[u] * lut[d] - colC[u], d is the raw 4 fractional bits disparity
+  * @details with a transform [R|t] the point is moved in the same pass, R is folded into the row factors so a
+  * transformed point costs 6 multiply-adds more than a camera frame point
+  */
+typedef struct ReprojectRowArgs{
+    const short *disparity;   ///< disparity row
+    int width;                ///< number of pixels
+    const float *lut;         ///< distance term of every raw disparity, lut[0] must be 0
+    int lutSize;              ///< disparities >= lutSize are invalid
+    const float *colA;        ///< ray x of each column
+    const float *colS;        ///< ray y, z and distance scale of each column
+    const float *colC;        ///< distance offset of each column
+    float rowP;               ///< ray y factor of this row
+    float rowR;               ///< ray z factor of this row
+    float minDepth;           ///< closer points are invalid
+    float maxDepth;           ///< farther points are invalid
+    const float *transform;   ///< 3x4 row-major [R|t] applied to the points, nullptr keeps the camera frame
+}ReprojectRowArgsType;
+
+/**
+  * @fn reprojectRow
+  * @brief reproject one disparity row with the fastest kernel of this build
+  * @param[in] args row inputs
+  * @param[out] depth depth row, 0 where invalid, pass nullptr to skip
+  * @param[out] x compacted point x, room for width + REPROJECT_ROW_PADDING entries
+  * @param[out] y compacted point y, room for width + REPROJECT_ROW_PADDING entries
+  * @param[out] z compacted point z, room for width + REPROJECT_ROW_PADDING entries
+  * @param[out] index column of each compacted point, room for width + REPROJECT_ROW_PADDING entries
+  * @return number of valid points
+  */
+int reprojectRow(const ReprojectRowArgsType &args, float *depth, float *x, float *y, float *z, int *index);
+
+/**
+  * @fn reprojectRowScalar
+  * @brief reproject one disparity row with scalar code, same output as reprojectRow()
+  */
+int reprojectRowScalar(const ReprojectRowArgsType &args, float *depth, float *x, float *y, float *z, int *index);
+
+/**
+  * @fn reprojectKernelName
+  * @brief get instruction set used by reprojectRow(), "avx2", "sse2", "neon" or "scalar"
+  */
+const char* reprojectKernelName(void);
+
+#endif //__REPROJECTION_KERNEL_HPP__
@@ -0,0 +1,93 @@
+/**
+  * @file ShmFramePublisher.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare the shared memory frame publisher APIs.
+  * @details raw, rectified and depth frames of one camera are written to its shared memory rings, see
+  * ShmFrameRing.hpp for the ring protocol and the reader.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __SHM_FRAME_PUBLISHER_HPP__
+#define __SHM_FRAME_PUBLISHER_HPP__
+
+#include <mutex>
+#include <string>
+#include "CallbackExecutor.hpp"
+#include "ShmFrameRing.hpp"
+#include "StereoFrameGrabber.hpp"
+#include "StereoPipeline.hpp"
+
+/**
+  * @class ShmFramePublisher
+  * @brief publish frames of a camera to shared memory rings
+  * @details a frame callback is registered for every stream, it copies the frame into the ring once. Rectified and
+  * depth frames come from the pipeline if one is given, otherwise from the grabber, which must grab them.
+  * @code
+  *     ShmFramePublisher publisher;
+  *     publisher.startPublish(cam.getPosNumber(), &grabber, &pipeline);
+  * @endcode
+  */
+class ShmFramePublisher
+{
+private:
+    typedef struct ShmPublishStream{
+        int product = 0;
+        int callback = -1;
+        bool isPipeline = false;
+        std::mutex lock;                   ///< callbacks run on executor threads
+        ShmFrameWriter writer;
+    }ShmPublishStreamType;
+
+    int m_posNumber = 0;
+    StereoFrameGrabber *m_grabber = nullptr;
+    StereoPipeline *m_pipeline = nullptr;
+    ShmPublishStreamType m_streams[SHM_STREAM_DEPTH + 1];
+
+    SystemLog *m_log = nullptr;
+    std::string m_logName = "ShmFramePublisher";
+
+public:
+    ShmFramePublisher(void);
+    /**
+      * @fn ~ShmFramePublisher
+      * @brief ShmFramePublisher destructor, stop publishing
+      */
+    virtual ~ShmFramePublisher();
+
+    ShmFramePublisher(const ShmFramePublisher&) = delete;
+    ShmFramePublisher& operator=(const ShmFramePublisher&) = delete;
+
+public:
+    /**
+      * @fn startPublish
+      * @brief start writing frames to the rings of a camera
+      * @param[in] posNumber camera position number, 1 to 9, selects the ring keys, see shmRingKey()
+      * @param[in] grabber started grabber, source of raw frames, and of rectified and depth frames without pipeline
+      * @param[in] pipeline started pipeline or nullptr, source of rectified and depth frames
+      * @param[in] streams bit mask of streams, bit n publishes ShmStream n, default all of them
+      * @param[in] slotCount slots of every ring
+      * @param[in] executor runs the copies instead of the grabber and pipeline threads, nullptr for inline
+      * @return true or false, if all streams are registered return true, otherwise return false
+      * @note without pipeline only the products passed to StereoFrameGrabber::startGrab() are published
+      */
+    virtual bool startPublish(int posNumber, StereoFrameGrabber *grabber, StereoPipeline *pipeline = nullptr,
+                              int streams = 0x07, int slotCount = SHM_RING_SLOTS, CallbackExecutor *executor = nullptr);
+    /**
+      * @fn stopPublish
+      * @brief unregister the frame callbacks and close the rings
+      * @attention stop publishing before the grabber or pipeline stops
+      */
+    virtual void stopPublish(void);
+    /**
+      * @fn getSequence
+      * @brief get sequence number of the last frame published to a stream
+      * @param[in] stream one of ShmStream
+      */
+    virtual uint64_t getSequence(int stream);
+
+private:
+    void publish(int stream, const FrameLease &lease);
+};
+
+#endif //__SHM_FRAME_PUBLISHER_HPP__
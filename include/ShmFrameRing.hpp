@@ -0,0 +1,311 @@
+/**
+  * @file ShmFrameRing.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare the shared memory frame ring APIs.
+  * @details camera frames are shared with other processes of the robot through a ring of frame slots in System V
+  * shared memory. One process writes a ring, any number of processes read it without copying the frames.
+  * The reader side only needs this header, ShmFrameRing.cc (library unitree_camera_shm), OpenCV core and systemlog.
+  *
+  * Ring protocol, version 1:
+  * - one ring per camera and stream, key SHM_RING_KEY_BASE + 10 * posNumber + stream, see shmRingKey().
+  * - the segment starts with ShmRingHeader, followed by slotCount slots of slotSize bytes each. A slot starts with
+  *   ShmSlotHeader, image data follows at the offsets its ShmImageInfo entries give, relative to the slot.
+  *   All offsets and sizes are multiples of 64 bytes.
+  * - frames get sequence numbers 1, 2, 3 ..., frame n is written to slot n % slotCount.
+  * - writer, per frame (seqlock): store slot state 2n+1, release fence, write images and ShmSlotHeader fields,
+  *   store slot state 2n with release, store header latest n with release, increment header notify and wake
+  *   FUTEX_WAKE waiters on it.
+  * - reader: load notify, load latest n with acquire. If n is newer than the last frame read, load slot state with
+  *   acquire, it must be 2n, read ShmSlotHeader fields, acquire fence, load slot state again, it must still be 2n.
+  *   Otherwise the slot is being rewritten, the reader starts over with the new latest. If there is no new frame
+  *   the reader calls FUTEX_WAIT on notify with the value loaded first.
+  * - image data is used in place. It stays valid until the writer wraps around to the slot again, that is
+  *   slotCount - 1 frames later, a reader checks the slot state once more after using the data, see
+  *   ShmFrameReader::isValid().
+  * - the writer sets header isOpen to 0 and removes the segment when it closes or needs larger slots, readers
+  *   attach to the new segment by the same key.
+  * - a new writer replaces an existing segment only if it is a ring of this version whose writerPid process is
+  *   gone, a ring of a live writer or a foreign segment at the key makes it fail.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __SHM_FRAME_RING_HPP__
+#define __SHM_FRAME_RING_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <opencv2/opencv.hpp>
+#include "SystemLog.hpp"
+
+/**
+  * @def SHM_RING_KEY_BASE
+  * @brief first shared memory key of the frame rings, keys 9000 + posNumber belong to startCapture(false, true)
+  */
+#define SHM_RING_KEY_BASE 9100
+
+/**
+  * @def SHM_RING_MAGIC
+  * @brief ShmRingHeader magic, "UCFR"
+  */
+#define SHM_RING_MAGIC 0x52464355u
+
+/**
+  * @def SHM_RING_VERSION
+  * @brief ring protocol version
+  */
+#define SHM_RING_VERSION 1
+
+/**
+  * @def SHM_RING_SLOTS
+  * @brief default number of slots of a ring
+  */
+#define SHM_RING_SLOTS 4
+
+/**
+  * @enum ShmStream
+  * @brief frame streams of a camera
+  */
+enum ShmStream{
+    SHM_STREAM_RAW   = 0,  ///< raw frame image 0, right image at the left half
+    SHM_STREAM_RECT  = 1,  ///< rectified left image 0 and right image 1
+    SHM_STREAM_DEPTH = 2,  ///< depth image 0, validity mask image 1 if 16 bit millimeter
+};
+
+/**
+  * @struct ShmRingHeader
+  * @brief first 128 bytes of a ring segment
+  */
+typedef struct ShmRingHeader{
+    uint32_t magic;                  ///< SHM_RING_MAGIC, written last when the ring is set up
+    uint32_t version;                ///< SHM_RING_VERSION
+    uint32_t headerSize;             ///< sizeof(ShmRingHeader), slot 0 starts here
+    uint32_t slotCount;              ///< number of slots
+    uint64_t slotSize;               ///< bytes of one slot, ShmSlotHeader included
+    int32_t posNumber;               ///< camera position number
+    int32_t stream;                  ///< one of ShmStream
+    int32_t writerPid;               ///< process id of the writer
+    std::atomic<uint32_t> isOpen;    ///< 1 while the writer uses the ring
+    std::atomic<uint32_t> notify;    ///< futex word, incremented after every frame
+    uint32_t reserved0;
+    std::atomic<uint64_t> latest;    ///< sequence number of the newest complete frame, 0 before the first one
+    uint8_t reserved1[72];
+}ShmRingHeaderType;
+
+/**
+  * @struct ShmImageInfo
+  * @brief one image of a slot, rows 0 if the slot has no such image
+  */
+typedef struct ShmImageInfo{
+    int32_t rows;
+    int32_t cols;
+    int32_t type;                    ///< OpenCV type, such as CV_8UC3
+    uint32_t step;                   ///< bytes of one row
+    uint64_t offset;                 ///< first byte relative to the slot
+}ShmImageInfoType;
+
+/**
+  * @struct ShmSlotHeader
+  * @brief first 128 bytes of a slot
+  */
+typedef struct ShmSlotHeader{
+    std::atomic<uint64_t> state;     ///< 2n after frame n is complete, 2n+1 while frame n is written
+    uint64_t sequence;               ///< sequence number n of the frame
+    int64_t timeStamp;               ///< time since 1970-01-01 00:00:00, unit is microseconds
+    uint8_t reserved0[8];
+    ShmImageInfoType images[2];
+    uint8_t reserved1[48];
+}ShmSlotHeaderType;
+
+static_assert(sizeof(ShmRingHeaderType) == 128, "ShmRingHeader must stay 128 bytes");
+static_assert(sizeof(ShmSlotHeaderType) == 128, "ShmSlotHeader must stay 128 bytes");
+
+/**
+  * @fn shmRingKey
+  * @brief get shared memory key of a ring
+  * @param[in] posNumber camera position number, face NO.1, chin NO.2, left NO.3, right NO.4, down NO.5
+  * @param[in] stream one of ShmStream
+  */
+int shmRingKey(int posNumber, int stream);
+
+/**
+  * @struct ShmFrame
+  * @brief frame read from a ring, its images point into the shared memory
+  */
+typedef struct ShmFrame{
+    uint64_t sequence = 0;                 ///< sequence number of the frame in its ring
+    std::chrono::microseconds timeStamp;   ///< time since 1970-01-01 00:00:00, unit is microseconds
+    cv::Mat data1;                         ///< image 0, read only
+    cv::Mat data2;                         ///< image 1, read only, empty if the stream has none
+    uint64_t ringId = 0;                   ///< attachment of the reader the frame was read from
+}ShmFrameType;
+
+/**
+  * @class ShmFrameWriter
+  * @brief write frames into a shared memory ring
+  * @details the segment is created at the first frame with slots large enough for it, and created again if a later
+  * frame does not fit. Frames are copied into the slot once, there is no lock between writer and readers.
+  * @code
+  *     ShmFrameWriter writer;
+  *     writer.open(1, SHM_STREAM_RECT);
+  *     writer.write(left, right, timeStamp);
+  * @endcode
+  */
+class ShmFrameWriter
+{
+private:
+    int m_posNumber = 0;
+    int m_stream = SHM_STREAM_RAW;
+    int m_slotCount = SHM_RING_SLOTS;
+    int m_shmId = -1;
+    ShmRingHeaderType *m_header = nullptr;
+    uint64_t m_sequence = 0;
+    std::chrono::steady_clock::time_point m_retryTime;   ///< no segment is created before, after a failure
+
+    SystemLog *m_log = nullptr;
+    std::string m_logName = "ShmFrameWriter";
+
+public:
+    ShmFrameWriter(void);
+    /**
+      * @fn ~ShmFrameWriter
+      * @brief ShmFrameWriter destructor, close the ring
+      */
+    ~ShmFrameWriter();
+
+    ShmFrameWriter(const ShmFrameWriter&) = delete;
+    ShmFrameWriter& operator=(const ShmFrameWriter&) = delete;
+
+public:
+    /**
+      * @fn open
+      * @brief select the ring to write, the segment is created by the first write()
+      * @param[in] posNumber camera position number, 1 to 9
+      * @param[in] stream one of ShmStream
+      * @param[in] slotCount number of slots, at least 2, a reader may use a frame for slotCount - 1 frame periods
+      * @return true or false, if parameters are valid return true, otherwise return false
+      */
+    bool open(int posNumber, int stream, int slotCount = SHM_RING_SLOTS);
+    /**
+      * @fn write
+      * @brief publish a frame to all readers
+      * @param[in] image0 first image, continuous or not
+      * @param[in] image1 second image, empty if the stream has none
+      * @param[in] timeStamp time since 1970-01-01 00:00:00, unit is microseconds
+      * @return true or false, if the frame is published return true, otherwise return false
+      * @note if the segment cannot be created, for example while another live writer owns the ring, frames are
+      * dropped and creation is tried again a second later
+      */
+    bool write(const cv::Mat &image0, const cv::Mat &image1, std::chrono::microseconds timeStamp);
+    /**
+      * @fn close
+      * @brief tell readers the ring is closed and remove the segment, readers keep their mapping until they detach
+      */
+    void close(void);
+    /**
+      * @fn getSequence
+      * @brief get sequence number of the last written frame
+      */
+    uint64_t getSequence(void) const;
+
+private:
+    bool create(uint64_t slotSize);
+    bool removeStale(int shmId, int key);
+};
+
+/**
+  * @class ShmFrameReader
+  * @brief read frames of a shared memory ring in place
+  * @details the segment is attached read only, waiting for a frame sleeps on the futex of the ring. A ring closed
+  * or recreated by its writer is attached again by the next waitFrame().
+  * @code
+  *     ShmFrameReader reader;
+  *     ShmFrameType frame;
+  *     uint64_t sequence = 0;
+  *     reader.open(1, SHM_STREAM_DEPTH);
+  *     while(running){
+  *         if(!reader.waitFrame(frame, sequence, std::chrono::milliseconds(100)))
+  *             continue;
+  *         float center = frame.data1.at<float>(frame.data1.rows / 2, frame.data1.cols / 2);
+  *         if(reader.isValid(frame))   // the writer did not overwrite the slot meanwhile
+  *             use(center);
+  *     }
+  * @endcode
+  */
+class ShmFrameReader
+{
+private:
+    int m_posNumber = 0;
+    int m_stream = SHM_STREAM_RAW;
+    const ShmRingHeaderType *m_header = nullptr;
+    uint64_t m_ringId = 0;          ///< incremented by every attach
+    uint64_t m_lostCount = 0;
+
+    SystemLog *m_log = nullptr;
+    std::string m_logName = "ShmFrameReader";
+
+public:
+    ShmFrameReader(void);
+    /**
+      * @fn ~ShmFrameReader
+      * @brief ShmFrameReader destructor, detach the ring
+      * @attention images of frames read before are invalid after this
+      */
+    ~ShmFrameReader();
+
+    ShmFrameReader(const ShmFrameReader&) = delete;
+    ShmFrameReader& operator=(const ShmFrameReader&) = delete;
+
+public:
+    /**
+      * @fn open
+      * @brief select the ring to read and attach it if its writer has created it
+      * @param[in] posNumber camera position number
+      * @param[in] stream one of ShmStream
+      * @return true or false, if the ring is attached return true, false if it does not exist yet, waitFrame()
+      * keeps trying
+      */
+    bool open(int posNumber, int stream);
+    /**
+      * @fn close
+      * @brief detach the ring
+      */
+    void close(void);
+    /**
+      * @fn isOpened
+      * @brief get whether a ring is attached and its writer is running
+      */
+    bool isOpened(void) const;
+    /**
+      * @fn waitFrame
+      * @brief block until a frame newer than the last read one is published
+      * @details frames written while the reader was busy are skipped, the newest one is read. Images of the
+      * previous frame must not be used after this call, the ring they point into may be detached.
+      * @param[out] frame newest frame, its images point into the ring
+      * @param[in,out] sequence in: sequence number of the last read frame, out: sequence number of frame
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a new frame is read return true, otherwise return false
+      */
+    bool waitFrame(ShmFrameType &frame, uint64_t &sequence, std::chrono::microseconds timeout);
+    /**
+      * @fn isValid
+      * @brief check that the slot of a frame was not rewritten, call it after using the images
+      */
+    bool isValid(const ShmFrameType &frame) const;
+    /**
+      * @fn getLostCount
+      * @brief get number of frames skipped by waitFrame() because newer ones were published before they were read
+      * @details frames lost when the writer restarts are not counted, neither are frames that fail isValid(),
+      * count those in the caller
+      */
+    uint64_t getLostCount(void) const;
+
+private:
+    bool attach(void);
+    bool readSlot(uint64_t sequence, ShmFrameType &frame) const;
+    const ShmSlotHeaderType* slotHeader(uint64_t sequence) const;
+};
+
+#endif //__SHM_FRAME_RING_HPP__
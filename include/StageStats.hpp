@@ -0,0 +1,109 @@
+/**
+  * @file StageStats.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare hot path timing statistics APIs.
+  * @details every stage records its latency into a lock-free histogram and counts processed, dropped and skipped
+  * frames. Recording is a few relaxed atomic increments, so it is always on.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __STAGE_STATS_HPP__
+#define __STAGE_STATS_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SystemLog.hpp"
+
+/**
+  * @def STATS_BUCKETS
+  * @brief latency histogram buckets, exact below 16 us, 8 buckets per power of two above, up to about 70 minutes
+  */
+#define STATS_BUCKETS 240
+
+/**
+  * @struct StageStats
+  * @brief statistics snapshot of one stage
+  */
+typedef struct StageStats{
+    std::string name;             ///< stage name
+    uint64_t processed = 0;       ///< frames finished by the stage
+    uint64_t dropped = 0;         ///< frames lost to full queues or leased buffers
+    uint64_t skipped = 0;         ///< frames not processed because no product of the stage was demanded
+    size_t queueDepth = 0;        ///< frames waiting in front of the stage
+    size_t queueCapacity = 0;     ///< queue capacity, 0 if the stage has no input queue
+    double p50 = 0;               ///< median latency, unit is millisecond
+    double p99 = 0;               ///< 99th percentile latency, unit is millisecond
+    double max = 0;               ///< largest latency, unit is millisecond
+    double mean = 0;              ///< mean latency, unit is millisecond
+}StageStatsType;
+
+/**
+  * @class StageStatsRecorder
+  * @brief lock-free latency histogram and frame counters of one stage
+  * @details percentiles are read from log-spaced buckets, their error is below 1/16 of the value
+  */
+class StageStatsRecorder
+{
+private:
+    std::atomic<uint64_t> m_buckets[STATS_BUCKETS];
+    std::atomic<uint64_t> m_processed;
+    std::atomic<uint64_t> m_dropped;
+    std::atomic<uint64_t> m_skipped;
+    std::atomic<uint64_t> m_sum;       ///< unit is microsecond
+    std::atomic<uint64_t> m_max;       ///< unit is microsecond
+
+public:
+    StageStatsRecorder(void);
+    ~StageStatsRecorder();
+
+public:
+    /**
+      * @fn record
+      * @brief count a processed frame and its latency
+      */
+    void record(std::chrono::microseconds latency);
+    /**
+      * @fn record
+      * @brief count a processed frame, latency is the time since start
+      * @code
+      *     std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      *     rectify(...);
+      *     stats.record(start);
+      * @endcode
+      */
+    void record(std::chrono::steady_clock::time_point start);
+    /**
+      * @fn drop
+      * @brief count a dropped frame
+      */
+    void drop(uint64_t count = 1);
+    /**
+      * @fn skip
+      * @brief count a skipped frame
+      */
+    void skip(void);
+    /**
+      * @fn reset
+      * @brief clear histogram and counters
+      */
+    void reset(void);
+    /**
+      * @fn snapshot
+      * @brief read histogram and counters, queue fields are left unchanged
+      */
+    void snapshot(StageStatsType &stats) const;
+};
+
+/**
+  * @fn logStageStats
+  * @brief write one line per stage into a log
+  * @param[in] log target log, lines are written by runTimeInfo()
+  * @param[in] stats stage statistics from getStats()
+  */
+void logStageStats(SystemLog *log, const std::vector<StageStatsType> &stats);
+
+#endif //__STAGE_STATS_HPP__
@@ -0,0 +1,353 @@
+/**
+  * @file StereoFrameGrabber.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare zero-copy frame handoff APIs.
+  * @details grab threads pull every frame product of a StereoCamera into fixed rings of pooled buffers,
+  * consumers get ref-counted read-only leases of the latest frame instead of copying it out,
+  * block until a newer frame arrives instead of polling, or have new frames pushed to callbacks.
+  * The grab threads themselves still poll the prebuilt library, see StereoFrameGrabber.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __STEREO_FRAME_GRABBER_HPP__
+#define __STEREO_FRAME_GRABBER_HPP__
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include "DepthColorizer.hpp"
+#include "FrameChannel.hpp"
+#include "FramePool.hpp"
+#include "StageStats.hpp"
+#include "StereoCameraCommon.hpp"
+#include "WorkerPool.hpp"
+
+class HostStereoCamera;
+
+/**
+  * @enum GrabProduct
+  * @brief frame products grabbed from stereo camera, combine them by bitwise or
+  */
+enum GrabProduct{
+    GRAB_RAW_FRAME   = 0x01,  ///< raw frame, always grabbed
+    GRAB_RECT_FRAME  = 0x02,  ///< rectified left and right frame, rectified from the grabbed raw frame on virtual and V4L2 cameras
+    GRAB_DEPTH_FRAME = 0x04,  ///< gray depth frame, needs startStereoCompute()
+    GRAB_COLOR_DEPTH = 0x08,  ///< color depth frame instead of gray, colored by setDepthPalette(), needs startStereoCompute()
+    GRAB_POINT_CLOUD = 0x10,  ///< color point cloud, needs startStereoCompute()
+};
+
+/**
+  * @class StereoFrameGrabber
+  * @brief zero-copy frame handoff of stereo camera frames
+  * @details frames are written once into a pooled buffer by a grab thread, every consumer shares that buffer
+  * through a FrameLease. The rings keep their buffers, so no cv::Mat is allocated per frame.
+  * Every product has its own sequence number, starting from 1.
+  * @note only consumers stop polling. The prebuilt library has no blocking call, so on a UnitreeCamera the raw,
+  * depth and point cloud threads call getRawFrame(), getDepthFrame() and getPointCloud() and sleep 1 ms whenever
+  * no frame is returned, up to three polling threads per camera. The rectified frame thread waits for raw frames.
+  * V4l2StereoCamera and VirtualStereoCamera block in getRawFrame() until the next frame, nothing polls on them.
+  */
+class StereoFrameGrabber
+{
+private:
+    int m_poolSize = 4;
+    int m_historyDepth = 0;                                 ///< frames kept per product for findFrame()
+    int m_products = GRAB_RAW_FRAME;
+    std::atomic<bool> m_isGrabbing;
+
+    StereoCamera *m_camera = nullptr;
+    HostStereoCamera *m_hostCamera = nullptr;               ///< m_camera if it is rectified on the host
+    FramePool *m_rawPool = nullptr;
+    FramePool *m_rectPool = nullptr;
+    FramePool *m_depthPool = nullptr;
+    FramePool *m_cloudPool = nullptr;
+    FrameChannel m_rawChannel, m_rectChannel, m_depthChannel, m_cloudChannel;
+    DepthColorizer m_colorizer;
+    StageStatsRecorder m_rawStats, m_rectStats, m_depthStats, m_cloudStats;
+    std::atomic<int64_t> m_statsInterval;                   ///< stats log interval, unit is millisecond, 0 disables
+    std::chrono::steady_clock::time_point m_lastStatsLog;
+
+    SystemLog *m_log = nullptr;
+    std::string m_logName = "StereoFrameGrabber";
+
+    WorkerPool *m_workerPool = nullptr;
+    std::future<void> m_grabWorker;
+    std::future<void> m_rectWorker;
+    std::future<void> m_depthWorker;
+    std::future<void> m_cloudWorker;
+
+public:
+    /**
+      * @fn StereoFrameGrabber
+      * @brief StereoFrameGrabber constructor
+      * @details
+      * @param[in] poolSize number of pooled frame buffers of each product, it limits how many frames
+      * can be leased at the same time
+      * @param[out] None
+      * @return None
+      * @note a grab thread drops a frame when all buffers are leased, so keep poolSize larger than the number of
+      * leases your consumers hold at once plus one
+      * @code
+      *     StereoFrameGrabber grabber(4);
+      * @endcode
+      */
+    StereoFrameGrabber(int poolSize = 4);
+    /**
+      * @fn ~StereoFrameGrabber
+      * @brief StereoFrameGrabber destructor
+      * @details stop grab threads and release pooled buffers
+      * @attention all leases taken from this grabber must be released before it is destroyed
+      */
+    virtual ~StereoFrameGrabber();
+
+public:
+    /**
+      * @fn startGrab
+      * @brief start grab threads
+      * @details
+      * @param[in] camera stereo camera, it must be opened and capturing
+      * @param[in] products GrabProduct flags, raw frame is always grabbed
+      * @param[out] None
+      * @return true or false, if create grab threads successfully return true, otherwise return false
+      * @attention This function must be called after startCapture(), and after startStereoCompute()
+      * if depth frame or point cloud is grabbed.
+      * @code
+      *     cam.startCapture();
+      *     cam.startStereoCompute();
+      *     grabber.startGrab(&cam, GRAB_COLOR_DEPTH);
+      * @endcode
+      */
+    virtual bool startGrab(StereoCamera *camera, int products = GRAB_RAW_FRAME);
+    /**
+      * @fn stopGrab
+      * @brief stop grab threads
+      * @details threads blocked in waitFor*() functions return false
+      * @param[in] None
+      * @param[out] None
+      * @return true or false, if stop threads successfully return true, otherwise return false
+      * @attention This function must be called before stopStereoCompute() and stopCapture().
+      * @code
+      *     grabber.stopGrab();
+      *     cam.stopStereoCompute();
+      *     cam.stopCapture();
+      * @endcode
+      */
+    virtual bool stopGrab(void);
+    /**
+      * @fn isGrabbing
+      * @brief get grab threads running status
+      * @return true or false, if grab threads are running return true, otherwise return false
+      */
+    virtual bool isGrabbing(void) const;
+    /**
+      * @fn setDepthPalette
+      * @brief select colors of GRAB_COLOR_DEPTH frames
+      * @details the gray depth of the camera is colored through a DepthColorizer table, one lookup per pixel
+      * @param[in] palette one of DepthPalette, PALETTE_JET by default
+      * @param[in] inverted true to color far to near instead of near to far
+      * @return true or false, if grab threads are stopped and palette is valid return true, otherwise return false
+      * @code
+      *     grabber.setDepthPalette(PALETTE_TURBO);
+      *     grabber.startGrab(&cam, GRAB_COLOR_DEPTH);
+      * @endcode
+      */
+    virtual bool setDepthPalette(int palette, bool inverted = false);
+    /**
+      * @fn setHistoryDepth
+      * @brief keep the last frames of every grabbed product for findFrame()
+      * @details kept frames stay in their pooled buffers, every product gets depth more buffers than poolSize
+      * @param[in] depth number of frames kept per product, 0 disables history, at most FRAME_HISTORY_MAX
+      * @return true or false, if grab threads are stopped and depth is valid return true, otherwise return false
+      * @code
+      *     grabber.setHistoryDepth(8);    // 8 raw frames are about 260 ms at 30 fps
+      *     grabber.startGrab(&cam);
+      * @endcode
+      */
+    virtual bool setHistoryDepth(int depth);
+    /**
+      * @fn setWorkerPool
+      * @brief run the grab threads on a pool with cpu affinity, priority and thread names
+      * @param[in] pool worker pool, nullptr for WorkerPool::defaultPool(), it must outlive the grab threads
+      * @return true or false, if grab threads are stopped return true, otherwise return false
+      * @code
+      *     grabber.setWorkerPool(&visionPool);
+      *     grabber.startGrab(&cam);
+      * @endcode
+      */
+    virtual bool setWorkerPool(WorkerPool *pool);
+    /**
+      * @fn getRawFrame
+      * @brief lease the latest raw frame
+      * @details raw frame is lease.data1(), it includes left and right image
+      * @param[in] None
+      * @param[out] lease read-only handle of the latest raw frame
+      * @return true or false, if a frame has been grabbed return true, otherwise return false
+      * @code
+      *     FrameLease lease;
+      *     if(grabber.getRawFrame(lease)){
+      *         cv::imshow("raw", lease.data1());
+      *         lease.release();
+      *     }
+      * @endcode
+      */
+    virtual bool getRawFrame(FrameLease &lease);
+    /**
+      * @fn getStereoFrame
+      * @brief lease the latest raw frame and view its left and right image
+      * @details left and right are headers into the leased buffer, no image data is copied
+      * @param[in] None
+      * @param[out] lease read-only handle of the latest raw frame, keep it while using left and right
+      * @param[out] left left image
+      * @param[out] right right image
+      * @return true or false, if a frame has been grabbed return true, otherwise return false
+      */
+    virtual bool getStereoFrame(FrameLease &lease, cv::Mat &left, cv::Mat &right);
+    /**
+      * @fn waitForRawFrame
+      * @brief block until a raw frame newer than the last consumed one arrives
+      * @details
+      * @param[out] lease read-only handle of the new raw frame
+      * @param[in,out] sequence in: sequence number of the last consumed frame, 0 for any frame,
+      * out: sequence number of the leased frame
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a new frame is leased return true, false on timeout or after stopGrab()
+      * @code
+      *     FrameLease lease;
+      *     uint64_t sequence = 0;
+      *     while(grabber.isGrabbing()){
+      *         if(!grabber.waitForRawFrame(lease, sequence, std::chrono::milliseconds(100)))
+      *             continue;
+      *         // do something with lease.data1()
+      *     }
+      * @endcode
+      */
+    virtual bool waitForRawFrame(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout);
+    /**
+      * @fn waitForStereoFrame
+      * @brief block until a raw frame newer than the last consumed one arrives, and view its left and right image
+      * @details left and right are headers into the leased buffer, no image data is copied
+      * @param[out] lease read-only handle of the new raw frame, keep it while using left and right
+      * @param[out] left left image
+      * @param[out] right right image
+      * @param[in,out] sequence in: sequence number of the last consumed frame, out: sequence number of the leased frame
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a new frame is leased return true, false on timeout or after stopGrab()
+      */
+    virtual bool waitForStereoFrame(FrameLease &lease, cv::Mat &left, cv::Mat &right,
+                                    uint64_t &sequence, std::chrono::microseconds timeout);
+    /**
+      * @fn waitForRectFrame
+      * @brief block until a rectified frame newer than the last consumed one arrives
+      * @details left image is lease.data1(), right image is lease.data2()
+      * @param[out] lease read-only handle of the new rectified frame
+      * @param[in,out] sequence in: sequence number of the last consumed frame, out: sequence number of the leased frame
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a new frame is leased return true, false on timeout or after stopGrab()
+      * @attention GRAB_RECT_FRAME must be passed to startGrab()
+      */
+    virtual bool waitForRectFrame(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout);
+    /**
+      * @fn waitForDepthFrame
+      * @brief block until a depth frame newer than the last consumed one arrives
+      * @details depth image is lease.data1()
+      * @param[out] lease read-only handle of the new depth frame
+      * @param[in,out] sequence in: sequence number of the last consumed frame, out: sequence number of the leased frame
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a new frame is leased return true, false on timeout or after stopGrab()
+      * @attention GRAB_DEPTH_FRAME or GRAB_COLOR_DEPTH must be passed to startGrab()
+      */
+    virtual bool waitForDepthFrame(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout);
+    /**
+      * @fn waitForPointCloud
+      * @brief block until a point cloud newer than the last consumed one arrives
+      * @details point cloud is lease.cloud()
+      * @param[out] lease read-only handle of the new point cloud
+      * @param[in,out] sequence in: sequence number of the last consumed frame, out: sequence number of the leased frame
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a new point cloud is leased return true, false on timeout or after stopGrab()
+      * @attention GRAB_POINT_CLOUD must be passed to startGrab()
+      */
+    virtual bool waitForPointCloud(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout);
+    /**
+      * @fn registerCallback
+      * @brief push every new frame of a product to a callback
+      * @details without executor the callback runs on the grab thread of that product as soon as the frame is ready,
+      * it must return quickly or it delays the next frame. With executor the callback is handed off to it,
+      * the executor drops the oldest waiting call when its queue is full.
+      * @param[in] product one of GRAB_RAW_FRAME, GRAB_RECT_FRAME, GRAB_DEPTH_FRAME and GRAB_POINT_CLOUD
+      * @param[in] callback function called with a lease of the new frame
+      * @param[in] executor optional executor the callback is handed off to
+      * @param[out] None
+      * @return callback id, -1 if product is invalid
+      * @note callbacks can be registered before or after startGrab()
+      * @attention calls queued to an executor hold frame leases, unregister the callback and destroy
+      * the executor before stopGrab(). An inline callback may register and unregister callbacks, itself included,
+      * but must not call stopGrab(), StereoPipeline::stopPipeline() or anything else that joins the thread it runs on.
+      * @code
+      *     CallbackExecutor executor(1, 2);
+      *     grabber.registerCallback(GRAB_DEPTH_FRAME, [](const FrameLease &depth){
+      *         // do something with depth.data1()
+      *     }, &executor);
+      * @endcode
+      */
+    virtual int registerCallback(int product, FrameChannel::FrameCallbackType callback, CallbackExecutor *executor = nullptr);
+    /**
+      * @fn unregisterCallback
+      * @brief stop pushing frames to a callback
+      * @param[in] product product passed to registerCallback()
+      * @param[in] id callback id returned by registerCallback()
+      * @return true or false, if callback is found return true, otherwise return false
+      */
+    virtual bool unregisterCallback(int product, int id);
+    /**
+      * @fn findFrame
+      * @brief lease the kept frame of a product nearest to a time stamp, for fusing with late sensor data
+      * @param[in] product one of GRAB_RAW_FRAME, GRAB_RECT_FRAME, GRAB_DEPTH_FRAME and GRAB_POINT_CLOUD
+      * @param[in] timeStamp time since 1970-01-01 00:00:00, unit is microseconds
+      * @param[out] lease kept frame nearest to timeStamp
+      * @param[in] exact only lease a frame with exactly timeStamp
+      * @return true or false, if a frame is leased return true, otherwise return false
+      * @attention setHistoryDepth() must be called before startGrab()
+      * @code
+      *     FrameLease frame;
+      *     if(grabber.findFrame(GRAB_RAW_FRAME, odometry.timeStamp, frame)){
+      *         // frame.timeStamp() is the frame time nearest to the odometry sample
+      *     }
+      * @endcode
+      */
+    virtual bool findFrame(int product, std::chrono::microseconds timeStamp, FrameLease &lease, bool exact = false);
+    /**
+      * @fn findFrame
+      * @brief lease a kept frame of a product by sequence number
+      * @param[in] product one of GRAB_RAW_FRAME, GRAB_RECT_FRAME, GRAB_DEPTH_FRAME and GRAB_POINT_CLOUD
+      * @param[in] sequence sequence number of the frame
+      * @param[out] lease kept frame
+      * @return true or false, if the frame is still kept return true, otherwise return false
+      */
+    virtual bool findFrame(int product, uint64_t sequence, FrameLease &lease);
+    /**
+      * @fn getStats
+      * @brief get latency histogram and frame counters of every grabbed product
+      * @details latency is the time spent in the camera call of one frame, waiting for the frame included,
+      * dropped frames were grabbed while every buffer was leased. The capture stage counts captured raw frames.
+      * @param[out] stats one entry per grabbed product, capture first
+      */
+    virtual void getStats(std::vector<StageStatsType> &stats) const;
+    /**
+      * @fn setStatsLogInterval
+      * @brief write getStats() to the log periodically while grabbing
+      * @param[in] interval time between two reports, 0 disables reports
+      */
+    virtual void setStatsLogInterval(std::chrono::milliseconds interval);
+
+private:
+    FrameChannel* productChannel(int product);
+    typedef std::function<bool(PooledFrameType&)> FillFrameType;
+    void productWorker(FramePool *pool, FrameChannel *channel, StageStatsRecorder *stats, FillFrameType fillFrame);
+    bool fillRectFrame(PooledFrameType &frame, uint64_t &rawSequence);
+    void logStats(void);
+    static void splitStereoFrame(const cv::Mat &frame, cv::Mat &left, cv::Mat &right);
+};
+
+#endif //__STEREO_FRAME_GRABBER_HPP__
@@ -0,0 +1,466 @@
+/**
+  * @file StereoPipeline.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare the staged stereo compute pipeline APIs.
+  * @details rectification, disparity matching and reprojection run on their own threads, connected by bounded
+  * drop-oldest queues, so frame N+1 is rectified while frame N is matched and frame N-1 is reprojected.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __STEREO_PIPELINE_HPP__
+#define __STEREO_PIPELINE_HPP__
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <string>
+#include "BoundedQueue.hpp"
+#include "DepthColorizer.hpp"
+#include "FrameChannel.hpp"
+#include "FramePool.hpp"
+#include "PointCloudFilter.hpp"
+#include "StageStats.hpp"
+#include "StereoFrameGrabber.hpp"
+#include "StereoRectifier.hpp"
+#include "StereoReprojector.hpp"
+#include "TemporalFilter.hpp"
+#include "WorkerPool.hpp"
+
+/**
+  * @enum PipelineProduct
+  * @brief frame products of stereo pipeline
+  */
+enum PipelineProduct{
+    PIPELINE_RECT_FRAME  = 0x01,  ///< rectified left image data1() and right image data2(), CV_8UC1 if RectifyGray
+    PIPELINE_DISPARITY   = 0x02,  ///< CV_16SC1 disparity of left image data1(), 4 fractional bits
+    PIPELINE_DEPTH_FRAME = 0x04,  ///< depth data1() in DepthFormat, 0 where invalid, CV_8UC1 validity mask data2()
+                                  ///< if DEPTH_MILLIMETER
+    PIPELINE_POINT_CLOUD = 0x08,  ///< color point cloud cloud(), or cloudSoA() if CloudSoA, in rectified left camera
+                                  ///< frame, or in body frame if BodyTransform is set, downsampled by
+                                  ///< CloudVoxelSize and OutlierRadius
+    PIPELINE_COLOR_DEPTH = 0x10,  ///< CV_8UC3 colorized depth data1(), DepthPalette colors from ColorMinDepth to ColorMaxDepth
+};
+
+/**
+  * @enum DepthFormat
+  * @brief pixel format of PIPELINE_DEPTH_FRAME
+  */
+enum DepthFormat{
+    DEPTH_METER      = 0,  ///< CV_32FC1 meter
+    DEPTH_MILLIMETER = 1,  ///< CV_16UC1 millimeter, sub-pixel disparity kept, with validity mask
+};
+
+/**
+  * @enum DisparityAlgorithm
+  * @brief disparity matcher of stereo pipeline
+  */
+enum DisparityAlgorithm{
+    DISPARITY_BM   = 0,  ///< block matching, fastest
+    DISPARITY_SGBM = 1,  ///< semi-global block matching, 3-way mode
+};
+
+/**
+  * @struct StereoPipelineConfig
+  * @brief stereo pipeline parameters, loaded from camera config file by StereoPipeline::loadConfig()
+  */
+typedef struct StereoPipelineConfig{
+    cv::Size calibFrameSize = cv::Size(928, 800);   ///< CalibFrameSize, single image size of calibration
+    cv::Size rectFrameSize = cv::Size(464, 400);    ///< RectifyFrameSize, rectified image size
+    int depthMode = RECTIFY_LONGLAT;                ///< Depthmode, 1 longlat, 2 perspective
+    double hFov = 90;                               ///< hFov, perspective field of view, degree
+    std::string mapCacheDir;                        ///< RectifyMapCache, rectification map cache directory, empty to disable
+    bool rectifyGray = false;                       ///< RectifyGray, rectify into gray images, point cloud is gray
+    cv::Rect depthRoi;                              ///< DepthRoi, [x, y, width, height] of the rectified image
+                                                    ///< depth is computed in, empty for the whole image
+    int decimation = 1;                             ///< DepthDecimation, depth roi is computed at 1 / decimation resolution
+    bool cloudSoA = false;                          ///< CloudSoA, point cloud product in structure-of-arrays layout
+    cv::Mat bodyTransform;                          ///< BodyTransform, 4x4 or 3x4 transform from rectified left camera
+                                                    ///< to body frame applied to the point cloud, empty for camera frame
+    double cloudVoxelSize = 0;                      ///< CloudVoxelSize, point cloud keeps one point per voxel, 0 keeps all
+    double outlierRadius = 0;                       ///< OutlierRadius, neighbor radius of the outlier filter, 0 disables it
+    int outlierMinNeighbors = 2;                    ///< OutlierMinNeighbors, points with fewer neighbors are dropped
+    int algorithm = DISPARITY_SGBM;                 ///< DisparityAlgorithm, 0 BM, 1 SGBM
+    int numDisparities = 64;                        ///< NumDisparities, multiple of 16
+    int blockSize = 5;                              ///< BlockSize, odd
+    int disparityBands = 1;                         ///< DisparityBands, horizontal bands matched in parallel,
+                                                    ///< 0 for one band per cpu core
+    int bandOverlap = 16;                           ///< DisparityBandOverlap, extra rows matched above and below a band
+    bool temporalFilter = false;                    ///< TemporalFilter, filter disparity over frames, see TemporalFilter
+    double temporalAlpha = 0.4;                     ///< TemporalAlpha, weight of the new disparity of a stable pixel
+    double temporalDelta = 1.0;                     ///< TemporalDelta, largest disparity change in pixels still smoothed
+    int temporalPersistence = 2;                    ///< TemporalPersistence, frames a lost pixel keeps its disparity
+    double minDepth = 0.05;                         ///< MinDepth, closer points are invalid, positive
+    double maxDepth = 1.0;                          ///< MaxDepth, farther points are invalid
+    int depthFormat = DEPTH_METER;                  ///< DepthFormat, 0 float meter, 1 16 bit millimeter with mask
+    int depthPalette = PALETTE_JET;                 ///< DepthPalette, colors of PIPELINE_COLOR_DEPTH, one of DepthPalette
+    double colorMinDepth = 0;                       ///< ColorMinDepth, depth of the first palette color, 0 for MinDepth
+    double colorMaxDepth = 0;                       ///< ColorMaxDepth, depth of the last palette color, 0 for MaxDepth
+    int rectQueueDepth = 2;                         ///< RectQueueDepth, raw frames waiting for rectification
+    int disparityQueueDepth = 2;                    ///< DisparityQueueDepth, rectified frames waiting for matching
+    int reprojectQueueDepth = 2;                    ///< ReprojectQueueDepth, disparities waiting for reprojection
+    int demandFrames = 30;                          ///< DemandFrames, a product is computed while it has callbacks or
+                                                    ///< was requested within this many raw frames, 0 computes all
+    int historyDepth = 0;                           ///< HistoryDepth, frames of every product kept for findFrame()
+}StereoPipelineConfigType;
+
+/**
+  * @class StereoPipeline
+  * @brief staged stereo compute pipeline fed by a StereoFrameGrabber
+  * @details raw frames are pushed into the rectification queue by a grabber callback. Every stage pops the oldest
+  * frame of its input queue, writes its product into a pooled buffer and pushes the frame on to the next queue.
+  * A full queue drops its oldest frame, so a slow stage never stalls the stages in front of it.
+  * Products are handed out as FrameLease like StereoFrameGrabber does, every product has its own sequence number.
+  * Products are computed on demand: a product is demanded while it has callbacks, or for DemandFrames raw frames
+  * after a waitFor*() or requestProducts() call. Stages whose products and downstream products are not demanded
+  * skip their frames, so a depth only consumer never pays for the point cloud.
+  */
+class StereoPipeline
+{
+private:
+    typedef struct PipelineJob{
+        FrameLease raw;
+        FrameLease rect;
+        FrameLease disparity;
+    }PipelineJobType;
+
+    int m_poolSize = 6;
+    StereoPipelineConfigType m_config;
+    std::atomic<bool> m_isRunning;
+    std::atomic<uint64_t> m_frameCount;
+    std::atomic<uint64_t> m_requestFrame[5];   ///< raw frame count at the last request of each product
+
+    StereoRectifier m_rectifier;
+    StereoReprojector m_reprojector;
+    DepthColorizer m_colorizer;
+    cv::Mat m_colorSource;
+    std::vector<cv::Ptr<cv::StereoMatcher>> m_matchers;   ///< one matcher per band, matchers are not reentrant
+    std::vector<cv::Mat> m_bandDisparity;
+    std::vector<double> m_bandTimings;
+    mutable std::mutex m_timingLock;
+    cv::Mat m_grayLeft, m_grayRight;
+    TemporalFilter m_temporalFilter;
+    PointCloudFilter m_cloudFilter;
+
+    StereoFrameGrabber *m_grabber = nullptr;
+    int m_rawCallback = -1;
+
+    FramePool *m_rectPool = nullptr;
+    FramePool *m_dispPool = nullptr;
+    FramePool *m_depthPool = nullptr;
+    FramePool *m_cloudPool = nullptr;
+    FramePool *m_colorPool = nullptr;
+    FrameChannel m_rectChannel, m_dispChannel, m_depthChannel, m_cloudChannel, m_colorChannel;
+
+    BoundedQueue<PipelineJobType> *m_rectQueue = nullptr;
+    BoundedQueue<PipelineJobType> *m_dispQueue = nullptr;
+    BoundedQueue<PipelineJobType> *m_reprojQueue = nullptr;
+
+    StageStatsRecorder m_rectStats, m_dispStats, m_reprojStats;
+    std::atomic<int64_t> m_statsInterval;                   ///< stats log interval, unit is millisecond, 0 disables
+    std::chrono::steady_clock::time_point m_lastStatsLog;
+
+    SystemLog *m_log = nullptr;
+    std::string m_logName = "StereoPipeline";
+
+    WorkerPool *m_workerPool = nullptr;
+    std::future<void> m_rectWorker;
+    std::future<void> m_dispWorker;
+    std::future<void> m_reprojWorker;
+
+public:
+    /**
+      * @fn StereoPipeline
+      * @brief StereoPipeline constructor
+      * @param[in] poolSize number of pooled buffers of each product, queued frames hold buffers too,
+      * keep it larger than the queue depths plus the leases your consumers hold at once
+      * @code
+      *     StereoPipeline pipeline(6);
+      * @endcode
+      */
+    StereoPipeline(int poolSize = 6);
+    /**
+      * @fn ~StereoPipeline
+      * @brief StereoPipeline destructor
+      * @attention all leases taken from this pipeline must be released before it is destroyed
+      */
+    virtual ~StereoPipeline();
+
+public:
+    /**
+      * @fn loadConfig
+      * @brief load pipeline parameters from camera config file
+      * @details keys missing from the file keep their current value
+      * @param[in] fileName camera config file, such as stereo_camera_config.yaml
+      * @return true or false, if file is opened return true, otherwise return false
+      */
+    virtual bool loadConfig(std::string fileName);
+    /**
+      * @fn setConfig
+      * @brief set pipeline parameters
+      * @return true or false, if pipeline is stopped and parameters are valid return true, otherwise return false
+      */
+    virtual bool setConfig(const StereoPipelineConfigType &config);
+    /**
+      * @fn getConfig
+      * @brief get pipeline parameters
+      */
+    virtual StereoPipelineConfigType getConfig(void) const;
+    /**
+      * @fn setDepthRoi
+      * @brief compute rectified frames, disparity and depth only inside a region, at reduced resolution
+      * @details the region is in RectifyFrameSize pixels. Rectification and matching never touch pixels outside it,
+      * all products have size roi.size() / decimation. NumDisparities is counted in decimated pixels.
+      * @param[in] roi region of the rectified image, empty for the whole image
+      * @param[in] decimation resolution divisor, at least 1
+      * @return true or false, if pipeline is stopped and parameters are valid return true, otherwise return false
+      * @code
+      *     // lower half at half resolution, for ground plane estimation
+      *     pipeline.setDepthRoi(cv::Rect(0, 200, 464, 200), 2);
+      * @endcode
+      */
+    virtual bool setDepthRoi(cv::Rect roi, int decimation = 1);
+    /**
+      * @fn setBodyTransform
+      * @brief output the point cloud in the robot body frame
+      * @details the transform is applied inside the reprojection row kernel, no extra pass over the points.
+      * It takes effect on an initialized pipeline without calling init() again.
+      * @param[in] transform 4x4 or 3x4 matrix [R|t] from rectified left camera to body frame, empty for camera frame
+      * @return true or false, if pipeline is stopped and transform is valid return true, otherwise return false
+      * @code
+      *     // face camera 0.3 meter in front of the body center, body x forward, y left, z up
+      *     cv::Mat transform = (cv::Mat_<double>(4, 4) << 0, 0, 1, 0.3,
+      *                                                   -1, 0, 0, 0,
+      *                                                   0, -1, 0, 0,
+      *                                                   0, 0, 0, 1);
+      *     pipeline.setBodyTransform(transform);
+      * @endcode
+      */
+    virtual bool setBodyTransform(const cv::Mat &transform);
+    /**
+      * @fn setWorkerPool
+      * @brief run the stage threads on a pool with cpu affinity, priority and thread names
+      * @param[in] pool worker pool, nullptr for WorkerPool::defaultPool(), it must outlive the stage threads
+      * @return true or false, if pipeline is stopped return true, otherwise return false
+      */
+    virtual bool setWorkerPool(WorkerPool *pool);
+    /**
+      * @fn startPipeline
+      * @brief build rectification maps and start stage threads
+      * @param[in] camera opened stereo camera, its calibration parameters are used
+      * @param[in] grabber running frame grabber the raw frames are taken from
+      * @return true or false, if start successfully return true, otherwise return false
+      * @attention This function must be called after grabber.startGrab(), the camera does not need startStereoCompute()
+      * @code
+      *     grabber.startGrab(&cam);
+      *     pipeline.loadConfig("stereo_camera_config.yaml");
+      *     pipeline.startPipeline(&cam, &grabber);
+      * @endcode
+      */
+    virtual bool startPipeline(StereoCamera *camera, StereoFrameGrabber *grabber);
+    /**
+      * @fn stopPipeline
+      * @brief stop stage threads, threads blocked in waitFor*() functions return false
+      * @attention This function must be called before grabber.stopGrab()
+      */
+    virtual bool stopPipeline(void);
+    /**
+      * @fn isRunning
+      * @brief get stage threads running status
+      */
+    virtual bool isRunning(void) const;
+    /**
+      * @fn processFrame
+      * @brief run all stages on one raw frame in the calling thread
+      * @details this does not touch the queues and channels, it can be used after setConfig() and init()
+      * without starting the threads. It shares matchers and scratch images with the stage threads, so it fails
+      * while they are running, see isRunning(). Stage latencies are recorded to getStats() as well
+      * @param[in] raw raw frame, right image at the left half and left image at the right half
+      * @param[out] left rectified left image
+      * @param[out] right rectified right image
+      * @param[out] disparity CV_16SC1 disparity
+      * @param[out] depth depth in DepthFormat, pass nullptr to skip
+      * @param[out] cloud color point cloud, pass nullptr to skip
+      * @return true or false, if pipeline is initialized and stopped return true, otherwise return false
+      */
+    virtual bool processFrame(const cv::Mat &raw, cv::Mat &left, cv::Mat &right, cv::Mat &disparity,
+                              cv::Mat *depth, std::vector<PCLType> *cloud);
+    /**
+      * @fn processFrame
+      * @brief run all stages on one raw frame in the calling thread, point cloud in structure-of-arrays layout
+      * @param[in] raw raw frame, right image at the left half and left image at the right half
+      * @param[out] left rectified left image
+      * @param[out] right rectified right image
+      * @param[out] disparity CV_16SC1 disparity
+      * @param[out] depth depth in DepthFormat, pass nullptr to skip
+      * @param[out] cloud caller-owned point cloud, its arrays are reused between calls
+      * @return true or false, if pipeline is initialized and stopped return true, otherwise return false
+      * @attention not while the stage threads are running, see the other processFrame()
+      */
+    virtual bool processFrame(const cv::Mat &raw, cv::Mat &left, cv::Mat &right, cv::Mat &disparity,
+                              cv::Mat *depth, PointCloudSoAType &cloud);
+    /**
+      * @fn init
+      * @brief build rectification maps and disparity matcher, startPipeline() calls it
+      * @param[in] camera opened stereo camera, its calibration parameters are used
+      * @return true or false, if calibration parameters are valid return true, otherwise return false
+      */
+    virtual bool init(StereoCamera *camera);
+    /**
+      * @fn init
+      * @brief build rectification maps and disparity matcher without a camera, such as for recorded frames
+      * @param[in] leftParams left camera calibration parameters, see StereoCamera::getCalibParams()
+      * @param[in] rightParams right camera calibration parameters
+      * @param[in] rawFrameSize raw frame size, both images side by side
+      * @return true or false, if calibration parameters are valid return true, otherwise return false
+      * @note init() clears getStats() and getBandTimings()
+      */
+    virtual bool init(const std::vector<cv::Mat> &leftParams, const std::vector<cv::Mat> &rightParams,
+                      cv::Size rawFrameSize);
+    /**
+      * @fn waitForRectFrame
+      * @brief block until a rectified frame newer than the last consumed one arrives
+      * @param[out] lease left image lease.data1(), right image lease.data2()
+      * @param[in,out] sequence in: sequence number of the last consumed frame, out: sequence number of the leased frame
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a new frame is leased return true, false on timeout or after stopPipeline()
+      */
+    virtual bool waitForRectFrame(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout);
+    /**
+      * @fn waitForDisparity
+      * @brief block until a disparity newer than the last consumed one arrives
+      * @param[out] lease disparity lease.data1()
+      * @param[in,out] sequence in: sequence number of the last consumed frame, out: sequence number of the leased frame
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a new frame is leased return true, false on timeout or after stopPipeline()
+      */
+    virtual bool waitForDisparity(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout);
+    /**
+      * @fn waitForDepthFrame
+      * @brief block until a depth frame newer than the last consumed one arrives
+      * @param[out] lease depth lease.data1(), validity mask lease.data2() if DEPTH_MILLIMETER
+      * @param[in,out] sequence in: sequence number of the last consumed frame, out: sequence number of the leased frame
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a new frame is leased return true, false on timeout or after stopPipeline()
+      */
+    virtual bool waitForDepthFrame(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout);
+    /**
+      * @fn waitForPointCloud
+      * @brief block until a point cloud newer than the last consumed one arrives
+      * @param[out] lease point cloud lease.cloud()
+      * @param[in,out] sequence in: sequence number of the last consumed frame, out: sequence number of the leased frame
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a new point cloud is leased return true, false on timeout or after stopPipeline()
+      */
+    virtual bool waitForPointCloud(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout);
+    /**
+      * @fn waitForColorDepth
+      * @brief block until a colorized depth frame newer than the last consumed one arrives
+      * @param[out] lease colorized depth lease.data1()
+      * @param[in,out] sequence in: sequence number of the last consumed frame, out: sequence number of the leased frame
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a new frame is leased return true, false on timeout or after stopPipeline()
+      */
+    virtual bool waitForColorDepth(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout);
+    /**
+      * @fn registerCallback
+      * @brief push every new frame of a product to a callback, see StereoFrameGrabber::registerCallback()
+      * @param[in] product one of PipelineProduct
+      * @param[in] callback function called with a lease of the new frame
+      * @param[in] executor optional executor the callback is handed off to
+      * @return callback id, -1 if product is invalid
+      */
+    virtual int registerCallback(int product, FrameChannel::FrameCallbackType callback, CallbackExecutor *executor = nullptr);
+    /**
+      * @fn unregisterCallback
+      * @brief stop pushing frames to a callback
+      * @return true or false, if callback is found return true, otherwise return false
+      */
+    virtual bool unregisterCallback(int product, int id);
+    /**
+      * @fn findFrame
+      * @brief lease the kept frame of a product nearest to a time stamp, for fusing with late sensor data
+      * @details time stamps are those of the raw frames. The product is requested like waitFor*() does,
+      * so frames are kept from the first call on.
+      * @param[in] product one of PipelineProduct
+      * @param[in] timeStamp time since 1970-01-01 00:00:00, unit is microseconds
+      * @param[out] lease kept frame nearest to timeStamp
+      * @param[in] exact only lease a frame with exactly timeStamp
+      * @return true or false, if a frame is leased return true, otherwise return false
+      * @attention HistoryDepth must be set before startPipeline()
+      */
+    virtual bool findFrame(int product, std::chrono::microseconds timeStamp, FrameLease &lease, bool exact = false);
+    /**
+      * @fn findFrame
+      * @brief lease a kept frame of a product by its sequence number
+      * @return true or false, if the frame is still kept return true, otherwise return false
+      */
+    virtual bool findFrame(int product, uint64_t sequence, FrameLease &lease);
+    /**
+      * @fn getDropCount
+      * @brief get number of frames dropped by full stage queues
+      */
+    virtual uint64_t getDropCount(void) const;
+    /**
+      * @fn requestProducts
+      * @brief mark products as demanded for the next DemandFrames raw frames
+      * @details waitFor*() functions request their product themselves, call this to keep products computed
+      * when polling them another way, e.g. from a callback of another product
+      * @param[in] products PipelineProduct flags
+      */
+    virtual void requestProducts(int products);
+    /**
+      * @fn getDemandedProducts
+      * @brief get PipelineProduct flags computed for the next frame, dependencies included
+      */
+    virtual int getDemandedProducts(void);
+    /**
+      * @fn getBandTimings
+      * @brief get matching time of every disparity band of the last frame
+      * @param[out] timings matching time of each band from top to bottom, unit is millisecond
+      * @return true or false, if a disparity has been computed return true, otherwise return false
+      * @code
+      *     std::vector<double> timings;
+      *     if(pipeline.getBandTimings(timings))
+      *         for(size_t i = 0; i < timings.size(); i++)
+      *             std::cout << "band " << i << ": " << timings[i] << " ms" << std::endl;
+      * @endcode
+      */
+    virtual bool getBandTimings(std::vector<double> &timings) const;
+    /**
+      * @fn getStats
+      * @brief get latency histogram, frame counters and queue depth of the rectify, disparity and reproject stages
+      * @details stage latency is the processing time of one frame, queue drops count as dropped frames of the stage
+      * the queue feeds. Color depth is part of the reproject stage.
+      * @param[out] stats one entry per stage in pipeline order
+      * @code
+      *     std::vector<StageStatsType> stats;
+      *     pipeline.getStats(stats);
+      *     for(const StageStatsType &stage : stats)
+      *         std::cout << stage.name << " p99 " << stage.p99 << " ms" << std::endl;
+      * @endcode
+      */
+    virtual void getStats(std::vector<StageStatsType> &stats) const;
+    /**
+      * @fn setStatsLogInterval
+      * @brief write getStats() to the log periodically while the pipeline runs
+      * @param[in] interval time between two reports, 0 disables reports
+      */
+    virtual void setStatsLogInterval(std::chrono::milliseconds interval);
+
+private:
+    FrameChannel* productChannel(int product);
+    static int productIndex(int product);
+    void rectifyWorker(void);
+    void disparityWorker(void);
+    void reprojectWorker(void);
+    void publishColorDepth(const cv::Mat &depth, std::chrono::microseconds timeStamp);
+    void filterCloud(std::vector<PCLType> &cloud);
+    void filterCloud(PointCloudSoAType &cloud);
+    void logStats(void);
+    cv::Ptr<cv::StereoMatcher> createMatcher(void) const;
+    bool computeDisparity(const cv::Mat &left, const cv::Mat &right, cv::Mat &disparity);
+    void computeBand(int band, const cv::Mat &left, const cv::Mat &right, cv::Mat &disparity);
+};
+
+#endif //__STEREO_PIPELINE_HPP__
@@ -0,0 +1,169 @@
+/**
+  * @file StereoRectifier.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare stereo image rectification APIs.
+  * @details rectification maps are built from the Mei (unified omnidirectional) camera model calibration,
+  * for longitude-latitude or perspective rectified images.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __STEREO_RECTIFIER_HPP__
+#define __STEREO_RECTIFIER_HPP__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+/**
+  * @enum RectifyMode
+  * @brief rectification projection, same values as Depthmode of camera config file
+  */
+enum RectifyMode{
+    RECTIFY_LONGLAT = 1,      ///< longitude and latitude expansion of fisheye image
+    RECTIFY_PERSPECTIVE = 2,  ///< perspective distortion correction
+};
+
+/**
+  * @fn initMeiRectifyMap
+  * @brief build rectification map of one camera
+  * @details for every rectified pixel the viewing ray is rotated back by R and projected by the Mei model
+  * @param[in] K camera intrinsic matrix, 3x3
+  * @param[in] D camera distortion coefficients (k1, k2, p1, p2)
+  * @param[in] xi Mei model parameter
+  * @param[in] R rectification rotation matrix, 3x3
+  * @param[in] Knew rectified image intrinsic matrix, 3x3. For RECTIFY_LONGLAT fx and fy are pixels per radian
+  * of longitude and latitude.
+  * @param[in] size rectified image size
+  * @param[in] mode RECTIFY_LONGLAT or RECTIFY_PERSPECTIVE
+  * @param[out] mapX CV_32FC1 source x coordinate, -1 where the ray is not visible
+  * @param[out] mapY CV_32FC1 source y coordinate, -1 where the ray is not visible
+  * @return None
+  */
+void initMeiRectifyMap(const cv::Mat &K, const cv::Mat &D, const cv::Mat &xi, const cv::Mat &R,
+                       const cv::Mat &Knew, cv::Size size, int mode, cv::Mat &mapX, cv::Mat &mapY);
+
+/**
+  * @class StereoRectifier
+  * @brief rectify the side-by-side raw frame into left and right image
+  * @details calibration parameters are arranged the same as StereoCamera::getCalibParams():
+  * intrinsic, distortion, xi, rotation, translation, kfe.
+  * Maps are kept in the packed fixed-point form of cv::convertMaps(), CV_16SC2 coordinates and CV_16UC1
+  * interpolation table indices, which remap faster than float maps. They can be cached in a directory, one file
+  * per hash of calibration, image sizes and mode, a later init() memory-maps that file instead of rebuilding the maps.
+  */
+class StereoRectifier
+{
+private:
+    int m_mode = RECTIFY_LONGLAT;
+    double m_baseline = 0;
+    cv::Size m_rectSize;
+    cv::Mat m_kfe;
+    cv::Mat m_map[2][2];   ///< [0] left, [1] right, each CV_16SC2 coordinate and CV_16UC1 interpolation map
+    cv::Mat m_viewMap[2];  ///< optional perspective view of left camera
+    cv::Mat m_viewKfe;
+    std::vector<cv::Mat> m_leftParams;   ///< left intrinsic at raw size, distortion, xi and rotation
+
+    void *m_cacheData = nullptr;   ///< memory-mapped cache file the maps point into
+    size_t m_cacheSize = 0;
+
+public:
+    StereoRectifier(void);
+    ~StereoRectifier();
+    StereoRectifier(const StereoRectifier&) = delete;
+    StereoRectifier& operator=(const StereoRectifier&) = delete;
+
+public:
+    /**
+      * @fn init
+      * @brief build rectification maps of both cameras
+      * @param[in] leftParams left camera calibration parameters
+      * @param[in] rightParams right camera calibration parameters
+      * @param[in] calibSize single camera image size the calibration parameters belong to
+      * @param[in] rawSize single camera image size of raw frame
+      * @param[in] rectSize rectified image size
+      * @param[in] mode RECTIFY_LONGLAT or RECTIFY_PERSPECTIVE
+      * @param[in] hFov horizontal field of view of RECTIFY_PERSPECTIVE, unit is degree
+      * @param[in] cacheDir map cache directory, empty to always build the maps. The maps are stored in
+      * <cacheDir>/<key>.map, the directory is created if its parent exists. Several cameras can share it.
+      * @param[in] roi region of the rectSize image to build, empty for the whole image
+      * @param[in] decimation the region is built at 1 / decimation resolution
+      * @param[out] None
+      * @return true or false, if parameters are valid return true, otherwise return false
+      * @note a failure to write the cache file is not an error, the maps are still built
+      * @note with roi or decimation, getRectFrameSize() and getRectIntrinsic() describe the reduced image,
+      * no pixel outside the region is ever rectified
+      */
+    bool init(const std::vector<cv::Mat> &leftParams, const std::vector<cv::Mat> &rightParams,
+              cv::Size calibSize, cv::Size rawSize, cv::Size rectSize, int mode, double hFov,
+              const std::string &cacheDir = "", cv::Rect roi = cv::Rect(), int decimation = 1);
+    /**
+      * @fn rectify
+      * @brief rectify side-by-side raw frame
+      * @details one fused pass reads the raw frame and writes both rectified eyes, and the perspective view if
+      * initPerspectiveView() was called. Output rows are processed in tiles spread over cpu cores, each tile
+      * samples both eyes so the raw rows it touches are still in cache.
+      * @param[in] raw raw frame, right image at the left half and left image at the right half, CV_8UC3 or CV_8UC1
+      * @param[out] left rectified left image
+      * @param[out] right rectified right image
+      * @param[in] gray output CV_8UC1 gray images instead of raw frame channels, ready for disparity matching
+      * @param[out] view perspective view of left camera, pass nullptr to skip
+      * @return true or false, if maps are built and raw is not empty return true, otherwise return false
+      * @code
+      *     cv::Mat left, right;
+      *     rectifier.rectify(raw, left, right, true);
+      * @endcode
+      */
+    bool rectify(const cv::Mat &raw, cv::Mat &left, cv::Mat &right, bool gray = false, cv::Mat *view = nullptr) const;
+    /**
+      * @fn initPerspectiveView
+      * @brief build the map of an extra perspective view of left camera, written by rectify()
+      * @param[in] size view image size
+      * @param[in] hFov horizontal field of view, unit is degree
+      * @return true or false, if init() succeeded before return true, otherwise return false
+      */
+    bool initPerspectiveView(cv::Size size, double hFov);
+    /**
+      * @fn getViewIntrinsic
+      * @brief get perspective view intrinsic matrix, CV_64FC1 3x3, empty before initPerspectiveView()
+      */
+    cv::Mat getViewIntrinsic(void) const;
+    /**
+      * @fn isReady
+      * @brief tell whether rectification maps are built
+      */
+    bool isReady(void) const;
+    /**
+      * @fn getMode
+      * @brief get rectification projection, RECTIFY_LONGLAT or RECTIFY_PERSPECTIVE
+      */
+    int getMode(void) const;
+    /**
+      * @fn getBaseline
+      * @brief get stereo baseline, same unit as calibration translation
+      */
+    double getBaseline(void) const;
+    /**
+      * @fn getRectFrameSize
+      * @brief get rectified image size
+      */
+    cv::Size getRectFrameSize(void) const;
+    /**
+      * @fn getRectIntrinsic
+      * @brief get rectified image intrinsic matrix, CV_64FC1 3x3
+      */
+    cv::Mat getRectIntrinsic(void) const;
+    /**
+      * @fn isCached
+      * @brief tell whether the maps were loaded from a cache file by the last init()
+      */
+    bool isCached(void) const;
+
+private:
+    bool loadCache(const std::string &fileName, uint64_t key);
+    bool saveCache(const std::string &fileName, uint64_t key) const;
+    void releaseCache(void);
+};
+
+#endif //__STEREO_RECTIFIER_HPP__
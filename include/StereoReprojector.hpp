@@ -0,0 +1,127 @@
+/**
+  * @file StereoReprojector.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare disparity reprojection APIs.
+  * @details turn the disparity of rectified images into depth image and point cloud.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __STEREO_REPROJECTOR_HPP__
+#define __STEREO_REPROJECTOR_HPP__
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "PointCloudSoA.hpp"
+#include "ReprojectionKernel.hpp"
+#include "StereoCameraCommon.hpp"
+#include "StereoRectifier.hpp"
+
+/**
+  * @class StereoReprojector
+  * @brief reproject disparity of rectified left image into 3D
+  * @details every pixel has a viewing ray in the rectified left camera frame, the distance along this ray is
+  * baseline * (S * g(d) - C), where S and C only depend on the image column and g only on the disparity d:
+  * RECTIFY_LONGLAT: S = sin(lon), C = cos(lon), g = cot(d / fx), distance is the range from camera center.
+  * RECTIFY_PERSPECTIVE: S = 1, C = 0, g = fx / d, distance is the depth along optical axis.
+  * Points are in the rectified left camera frame, same unit as calibration translation, or in the frame given by
+  * setTransform(), which is applied inside the row kernel.
+  * g is looked up in a table over all raw disparity values, rows are reprojected by the vectorized ReprojectionKernel.
+  * @note row buffers are allocated by init() and reused by every call, call reproject() of one reprojector
+  * from one thread at a time
+  */
+class StereoReprojector
+{
+private:
+    int m_mode = RECTIFY_LONGLAT;
+    float m_baseline = 0;
+    cv::Size m_size;
+    std::vector<float> m_lut;                    ///< baseline * g of every raw disparity
+    std::vector<float> m_colA, m_colS, m_colC;   ///< ray x, ray scale and baseline * C of each column
+    std::vector<float> m_rowP, m_rowR;           ///< ray y and z factor of each row
+    std::vector<float> m_transform;              ///< 3x4 row-major point transform, empty for the camera frame
+    mutable std::vector<float> m_rowX, m_rowY, m_rowZ;   ///< points of one row, sized by init()
+    mutable std::vector<int> m_rowIndex;                 ///< column of every point of one row, sized by init()
+
+public:
+    StereoReprojector(void);
+    ~StereoReprojector();
+
+public:
+    /**
+      * @fn init
+      * @brief build viewing ray and disparity tables of rectified image
+      * @param[in] rectifier initialized stereo rectifier
+      * @param[in] numDisparities disparity search range of the matcher, larger disparities are invalid
+      * @return true or false, if rectifier is ready return true, otherwise return false
+      */
+    bool init(const StereoRectifier &rectifier, int numDisparities = 256);
+    /**
+      * @fn init
+      * @brief build viewing ray and disparity tables from rectified image parameters
+      * @param[in] mode RECTIFY_LONGLAT or RECTIFY_PERSPECTIVE
+      * @param[in] kfe rectified image intrinsic matrix, 3x3
+      * @param[in] baseline stereo baseline
+      * @param[in] size rectified image size
+      * @param[in] numDisparities disparity search range of the matcher, larger disparities are invalid
+      * @return true or false, if parameters are valid return true, otherwise return false
+      */
+    bool init(int mode, const cv::Mat &kfe, double baseline, cv::Size size, int numDisparities = 256);
+    /**
+      * @fn setTransform
+      * @brief set transform of point cloud output, such as the camera extrinsics in the robot body frame
+      * @details depth images keep the distance along the viewing ray
+      * @param[in] transform 4x4 or 3x4 matrix [R|t] mapping rectified left camera points to the target frame,
+      * empty to output camera frame points
+      * @return true or false, if transform is empty, 4x4 or 3x4 return true, otherwise return false
+      * @attention not thread safe against reproject() running on another thread
+      */
+    bool setTransform(const cv::Mat &transform);
+    /**
+      * @fn reproject
+      * @brief compute depth image and point cloud from disparity
+      * @param[in] disparity CV_16SC1 disparity of left image, fixed point with 4 fractional bits (StereoSGBM output)
+      * @param[in] color rectified left image, CV_8UC3 or CV_8UC1, used for point color
+      * @param[in] minDepth points closer than minDepth are dropped
+      * @param[in] maxDepth points farther than maxDepth are dropped
+      * @param[out] depth CV_32FC1 distance along the viewing ray, 0 where invalid, pass nullptr to skip
+      * @param[out] cloud valid points with color, pass nullptr to skip, reserved for one point per pixel so a
+      * reused vector is not reallocated
+      * @return true or false, if disparity matches the rectified image size return true, otherwise return false
+      */
+    bool reproject(const cv::Mat &disparity, const cv::Mat &color, float minDepth, float maxDepth,
+                   cv::Mat *depth, std::vector<PCLType> *cloud) const;
+    /**
+      * @fn reproject
+      * @brief compute depth image and structure-of-arrays point cloud from disparity
+      * @details cloud is reserved for one point per pixel on first use, later calls reuse its arrays
+      * @param[in] disparity CV_16SC1 disparity of left image, fixed point with 4 fractional bits (StereoSGBM output)
+      * @param[in] color rectified left image, CV_8UC3 or CV_8UC1, used for point color
+      * @param[in] minDepth points closer than minDepth are dropped
+      * @param[in] maxDepth points farther than maxDepth are dropped
+      * @param[out] depth CV_32FC1 distance along the viewing ray, 0 where invalid, pass nullptr to skip
+      * @param[out] cloud caller-owned point cloud, cloud.count is set to the number of valid points
+      * @return true or false, if disparity matches the rectified image size return true, otherwise return false
+      */
+    bool reproject(const cv::Mat &disparity, const cv::Mat &color, float minDepth, float maxDepth,
+                   cv::Mat *depth, PointCloudSoAType &cloud) const;
+    /**
+      * @fn computeDepth
+      * @brief compute 16 bit metric depth image from disparity, without point cloud or float depth
+      * @details the fractional disparity bits are kept, depth is rounded to whole millimeters only at the end.
+      * Calibration translation and depth range are in meter.
+      * @param[in] disparity CV_16SC1 disparity of left image, fixed point with 4 fractional bits (StereoSGBM output)
+      * @param[in] minDepth points closer than minDepth are invalid
+      * @param[in] maxDepth points farther than maxDepth are invalid, at most 65.535 meter
+      * @param[out] depth CV_16UC1 distance along the viewing ray in millimeter, 0 where invalid
+      * @param[out] mask CV_8UC1 validity mask, 255 where depth is valid, pass nullptr to skip
+      * @return true or false, if disparity matches the rectified image size return true, otherwise return false
+      */
+    bool computeDepth(const cv::Mat &disparity, float minDepth, float maxDepth, cv::Mat &depth, cv::Mat *mask) const;
+
+private:
+    bool prepare(const cv::Mat &disparity, cv::Mat *depth) const;
+    ReprojectRowArgsType rowArgs(const cv::Mat &disparity, int v, float minDepth, float maxDepth) const;
+};
+
+#endif //__STEREO_REPROJECTOR_HPP__
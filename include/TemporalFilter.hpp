@@ -0,0 +1,67 @@
+/**
+  * @file TemporalFilter.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare temporal disparity filter APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __TEMPORAL_FILTER_HPP__
+#define __TEMPORAL_FILTER_HPP__
+
+#include <opencv2/opencv.hpp>
+
+/**
+  * @class TemporalFilter
+  * @brief exponential filter of disparity over frames with edge-preserving reset
+  * @details every pixel keeps its filtered disparity and a confidence, the number of consecutive frames its
+  * disparity stayed within delta of the filtered value. A new disparity is blended in with weight
+  * max(alpha, 1 / (confidence + 1)), so fresh pixels settle quickly and stable pixels are smoothed the most.
+  * A jump larger than delta is a depth edge or a moving object, the pixel restarts from the new disparity.
+  * An invalid disparity keeps the filtered value for up to persistence frames.
+  * The state buffers are allocated on the first frame and reused, they are reset when the disparity size changes.
+  */
+class TemporalFilter
+{
+private:
+    float m_alpha = 0.4f;
+    float m_delta = 16.f;          ///< raw disparity units, 4 fractional bits
+    int m_persistence = 2;
+    cv::Mat m_state;               ///< CV_32FC1 filtered raw disparity, 0 where invalid
+    cv::Mat m_confidence;          ///< CV_8UC1 consistent frames of each pixel
+    cv::Mat m_missing;             ///< CV_8UC1 invalid frames the filtered value has been held for
+
+public:
+    TemporalFilter(void);
+    ~TemporalFilter();
+
+public:
+    /**
+      * @fn setParams
+      * @brief set filter parameters
+      * @param[in] alpha weight of the new disparity of a stable pixel, in (0, 1], 1 disables smoothing
+      * @param[in] delta largest change in disparity pixels still treated as noise
+      * @param[in] persistence frames an invalid pixel keeps its filtered disparity, 0 to drop it at once
+      * @return true or false, if parameters are valid return true, otherwise return false
+      */
+    bool setParams(float alpha, float delta, int persistence);
+    /**
+      * @fn isValidParams
+      * @brief check filter parameters without setting them, see setParams()
+      */
+    static bool isValidParams(float alpha, float delta, int persistence);
+    /**
+      * @fn reset
+      * @brief forget all previous frames
+      */
+    void reset(void);
+    /**
+      * @fn apply
+      * @brief filter a new disparity in place
+      * @param[in,out] disparity CV_16SC1 disparity with 4 fractional bits, replaced by the filtered disparity
+      * @return true or false, if disparity type is CV_16SC1 return true, otherwise return false
+      */
+    bool apply(cv::Mat &disparity);
+};
+
+#endif //__TEMPORAL_FILTER_HPP__
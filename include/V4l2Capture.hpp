@@ -0,0 +1,152 @@
+/**
+  * @file V4l2Capture.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare direct V4L2 capture APIs.
+  * @details frames are dequeued from mmap'd driver buffers and converted straight into the caller's image,
+  * time stamps come from the driver instead of the time the frame reached user space.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __V4L2_CAPTURE_HPP__
+#define __V4L2_CAPTURE_HPP__
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+/**
+  * @struct V4l2FrameInfo
+  * @brief driver timing of one captured frame
+  */
+typedef struct V4l2FrameInfo{
+    std::chrono::microseconds timeStamp;         ///< driver buffer time stamp, time since 1970-01-01 00:00:00
+    std::chrono::microseconds monotonicStamp;    ///< driver buffer time stamp, CLOCK_MONOTONIC
+    std::chrono::microseconds exposureMidpoint;  ///< estimated middle of exposure, time since 1970-01-01 00:00:00
+    std::chrono::microseconds exposure;          ///< exposure time, 0 if the driver does not report it
+    uint32_t sequence = 0;                       ///< driver frame sequence number
+    uint32_t dropped = 0;                        ///< frames lost by the driver since the previous frame
+    bool isStartOfExposure = false;              ///< time stamp is taken at start of exposure, otherwise at end of frame
+    bool isDriverStamp = false;                  ///< time stamp comes from the driver, otherwise from dequeue time
+}V4l2FrameInfoType;
+
+/**
+  * @class V4l2Capture
+  * @brief capture from a V4L2 device through mmap'd buffers
+  * @details MJPEG, YUYV and GREY devices are supported, frames are returned as CV_8UC3 BGR like cv::VideoCapture.
+  * Driver time stamps are CLOCK_MONOTONIC, they are converted to wall clock time with an offset sampled
+  * at every dequeue, so clock steps move the converted stamps but not the spacing of frames.
+  * Exposure is cached, it is updated by control change events, or read once a second if the driver has none.
+  * @note works with the vivid virtual driver: sudo modprobe vivid
+  */
+class V4l2Capture
+{
+private:
+    typedef struct Buffer{
+        void *start;
+        size_t length;
+    }BufferType;
+
+    int m_fd = -1;
+    std::string m_device;
+    uint32_t m_pixelFormat = 0;
+    cv::Size m_frameSize;
+    size_t m_bytesPerLine = 0;     ///< row step of the driver buffers, rows may be padded
+    double m_frameRate = 0;
+    std::vector<BufferType> m_buffers;
+    bool m_isStreaming = false;
+    bool m_hasExposure = false;
+    bool m_hasExposureEvents = false;   ///< the driver reports exposure changes, no polling needed
+    int64_t m_exposure = 0;             ///< cached exposure, unit is microseconds
+    int64_t m_exposureTime = 0;         ///< CLOCK_MONOTONIC microseconds of the last exposure read
+    bool m_hasSequence = false;
+    uint32_t m_lastSequence = 0;
+
+public:
+    V4l2Capture(void);
+    ~V4l2Capture();
+
+    V4l2Capture(const V4l2Capture&) = delete;
+    V4l2Capture& operator=(const V4l2Capture&) = delete;
+
+public:
+    /**
+      * @fn open
+      * @brief open a device and negotiate format, size and frame rate
+      * @details MJPEG is preferred, then YUYV, then GREY. The driver may pick the nearest size and rate it supports,
+      * see getFrameSize() and getFrameRate().
+      * @param[in] device device file, such as /dev/video0
+      * @param[in] frameSize requested frame size
+      * @param[in] frameRate requested frames per second
+      * @param[in] bufferCount driver buffers, at least 2
+      * @return true or false, if device is opened and buffers are mapped return true, otherwise return false
+      */
+    bool open(const std::string &device, cv::Size frameSize, double frameRate, int bufferCount = 4);
+    /**
+      * @fn close
+      * @brief stop streaming, unmap buffers and close the device
+      */
+    void close(void);
+    /**
+      * @fn isOpened
+      * @brief get device open state
+      */
+    bool isOpened(void) const;
+    /**
+      * @fn start
+      * @brief queue all buffers and start streaming
+      */
+    bool start(void);
+    /**
+      * @fn stop
+      * @brief stop streaming, queued frames are dropped
+      */
+    bool stop(void);
+    /**
+      * @fn isStreaming
+      * @brief get streaming state
+      */
+    bool isStreaming(void) const;
+    /**
+      * @fn read
+      * @brief wait for the next frame and convert it into frame
+      * @details the driver buffer is decoded or converted in place and queued again right away,
+      * there is no intermediate copy
+      * @param[out] frame CV_8UC3 BGR image, reused when size and type are unchanged
+      * @param[out] info driver timing of the frame
+      * @param[in] timeout maximum waiting time
+      * @return true or false, if a frame is read return true, false on timeout or device error
+      */
+    bool read(cv::Mat &frame, V4l2FrameInfoType &info, std::chrono::milliseconds timeout = std::chrono::milliseconds(1000));
+    /**
+      * @fn getFrameSize
+      * @brief get negotiated frame size
+      */
+    cv::Size getFrameSize(void) const;
+    /**
+      * @fn getFrameRate
+      * @brief get negotiated frame rate, 0 if the driver does not report it
+      */
+    double getFrameRate(void) const;
+    /**
+      * @fn getPixelFormat
+      * @brief get negotiated pixel format as fourcc string, such as "MJPG"
+      */
+    std::string getPixelFormat(void) const;
+    /**
+      * @fn getDevice
+      * @brief get device file
+      */
+    std::string getDevice(void) const;
+
+private:
+    bool setFormat(cv::Size frameSize);
+    void setFrameRate(double frameRate);
+    void readExposure(void);
+    void readEvents(void);
+    bool convertFrame(const BufferType &buffer, size_t bytesUsed, cv::Mat &frame) const;
+};
+
+#endif //__V4L2_CAPTURE_HPP__
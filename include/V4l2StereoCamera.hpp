@@ -0,0 +1,131 @@
+/**
+  * @file V4l2StereoCamera.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare V4L2 stereo camera APIs.
+  * @details a StereoCamera that reads the camera device through V4L2 directly instead of cv::VideoCapture,
+  * with driver time stamps, exposure midpoint and frame sequence of every raw frame.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __V4L2_STEREO_CAMERA_HPP__
+#define __V4L2_STEREO_CAMERA_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "HostStereoCamera.hpp"
+#include "V4l2Capture.hpp"
+
+/**
+  * @class V4l2StereoCamera
+  * @brief stereo camera captured through mmap'd V4L2 buffers
+  * @details raw frame time stamps are the driver buffer time stamps converted to time since 1970, not the time
+  * the frame was read, so they do not carry the scheduling delay of the reading thread.
+  * StereoFrameGrabber, StereoPipeline and getRectStereoFrame() work on it unchanged. The calibration stored in the
+  * camera is read by the prebuilt library only, load it from a file written by exportCalibParams().
+  * The camera's own depth and point cloud computation is not available, use StereoPipeline.
+  */
+class V4l2StereoCamera : public HostStereoCamera
+{
+private:
+    std::string m_device;
+    double m_frameRate = 30;
+    cv::Size m_frameSize;                       ///< requested raw frame size, both images side by side
+    V4l2Capture m_capture;
+    V4l2FrameInfoType m_lastInfo;
+    std::mutex m_infoLock;                      ///< m_lastInfo only, never held while waiting for a frame
+    std::mutex m_frameLock;                     ///< m_capture, getRawFrame() holds it for one short read slice
+    std::atomic<int> m_controlWaiters;          ///< control calls waiting for m_frameLock, getRawFrame() yields to them
+
+public:
+    /**
+      * @fn V4l2StereoCamera
+      * @brief V4l2StereoCamera constructor, open the device and negotiate format
+      * @param[in] device device file, such as /dev/video0
+      * @param[in] frameRate requested frames per second
+      * @param[in] frameSize requested raw frame size
+      * @code
+      *     V4l2StereoCamera cam("/dev/video0", 30, cv::Size(1856, 800));
+      *     cam.loadCalibParams("stereo_calib.yaml");
+      *     cam.startCapture();
+      * @endcode
+      */
+    V4l2StereoCamera(std::string device, double frameRate = 30, cv::Size frameSize = cv::Size(1856, 800));
+    /**
+      * @fn V4l2StereoCamera
+      * @brief V4l2StereoCamera constructor by device node number, like DeviceNode of the config file
+      */
+    V4l2StereoCamera(int deviceNode, double frameRate = 30, cv::Size frameSize = cv::Size(1856, 800));
+    virtual ~V4l2StereoCamera();
+
+public:
+    virtual bool isOpened(void);
+    /**
+      * @fn setRawFrameRate
+      * @brief reopen the device at another frame rate, streaming restarts if it was running
+      */
+    virtual bool setRawFrameRate(int frameRate);
+    /**
+      * @fn setRawFrameSize
+      * @brief reopen the device at another frame size, streaming restarts if it was running
+      */
+    virtual bool setRawFrameSize(cv::Size frameSize);
+    virtual float getRawFrameRate(void) const;
+    virtual cv::Size getRawFrameSize(void) const;
+    /**
+      * @fn getRawFrame
+      * @brief wait up to 1 s for the next frame, time stamp is the driver time stamp
+      */
+    virtual bool getRawFrame(cv::Mat &frame, std::chrono::microseconds &timeStamp);
+    virtual bool getStereoFrame(cv::Mat &left, cv::Mat &right, std::chrono::microseconds &timeStamp);
+    /**
+      * @fn startCapture
+      * @brief start streaming, udp and share memory output are not supported
+      */
+    virtual bool startCapture(bool udpFlag = false, bool shmFlag = false);
+    virtual bool stopCapture(void);
+    /**
+      * @fn startStereoCompute
+      * @brief not supported, use StereoPipeline for depth and point cloud
+      * @return false
+      */
+    virtual bool startStereoCompute(void);
+    virtual bool stopStereoCompute(void);
+    virtual bool getDepthFrame(cv::Mat &depth, bool color, std::chrono::microseconds &timeStamp);
+    virtual bool getPointCloud(std::vector<PCLType> &pcl, std::chrono::microseconds &timeStamp);
+
+public:
+    /**
+      * @fn getRawFrame
+      * @brief wait for the next frame with its driver timing
+      * @param[out] frame raw frame, right image at the left half and left image at the right half
+      * @param[out] info time stamp, exposure midpoint, driver sequence and dropped frames
+      * @return true or false, if a frame is read return true, otherwise return false
+      * @code
+      *     V4l2FrameInfoType info;
+      *     if(cam.getRawFrame(frame, info))
+      *         imuBuffer.interpolate(info.exposureMidpoint);
+      * @endcode
+      */
+    bool getRawFrame(cv::Mat &frame, V4l2FrameInfoType &info);
+    /**
+      * @fn getLastFrameInfo
+      * @brief get driver timing of the last frame read by any getRawFrame() call, such as the one of a grabber
+      */
+    V4l2FrameInfoType getLastFrameInfo(void);
+    /**
+      * @fn getPixelFormat
+      * @brief get negotiated pixel format as fourcc string
+      */
+    std::string getPixelFormat(void) const;
+
+private:
+    bool reopen(void);
+    std::unique_lock<std::mutex> lockControl(void);
+};
+
+#endif //__V4L2_STEREO_CAMERA_HPP__
@@ -0,0 +1,146 @@
+/**
+  * @file VirtualStereoCamera.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare virtual stereo camera APIs.
+  * @details a StereoCamera without the fisheye module: frames are replayed from a recorded side-by-side video or
+  * image sequence, or rendered from a synthetic scene with known ground-truth disparity.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __VIRTUAL_STEREO_CAMERA_HPP__
+#define __VIRTUAL_STEREO_CAMERA_HPP__
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "HostStereoCamera.hpp"
+
+/**
+  * @def VIRTUAL_SOURCE_SYNTHETIC
+  * @brief source name of the synthetic scene
+  */
+#define VIRTUAL_SOURCE_SYNTHETIC "synthetic"
+
+/**
+  * @class VirtualStereoCamera
+  * @brief stereo camera replaying recorded frames or rendering a synthetic scene
+  * @details raw frames have the same layout as the camera, right image at the left half and left image at the
+  * right half, and are paced at the frame rate. StereoFrameGrabber, StereoPipeline and getRectStereoFrame() work
+  * on it unchanged, the camera's own depth and point cloud computation is not available.
+  *
+  * The synthetic scene is a textured floor, a back wall and a moving ball seen by an ideal fisheye rig
+  * (Mei model, xi = 1, no distortion, parallel cameras, 3 cm baseline), its calibration is built in.
+  * Recorded sources need the calibration of the recording camera, see exportCalibParams() and loadCalibParams().
+  */
+class VirtualStereoCamera : public HostStereoCamera
+{
+private:
+    std::string m_source;
+    bool m_isSynthetic = false;
+    bool m_isOpened = false;
+    bool m_isCapturing = false;
+    double m_frameRate = 30;
+    cv::Size m_frameSize;                       ///< raw frame size, both images side by side
+    cv::VideoCapture m_capture;
+
+    std::chrono::microseconds m_startStamp;     ///< time stamp of scene time 0
+    std::chrono::steady_clock::time_point m_nextFrame;
+    std::mutex m_frameLock;
+    cv::Mat m_rays[2];                          ///< CV_32FC3 unit viewing ray of every raw pixel, left and right
+
+public:
+    /**
+      * @fn VirtualStereoCamera
+      * @brief VirtualStereoCamera constructor
+      * @param[in] source VIRTUAL_SOURCE_SYNTHETIC, a side-by-side video file, or an image sequence such as
+      * "frames/%04d.png", recorded sources loop at their end
+      * @param[in] frameRate frames per second, 0 returns frames as fast as they are read or rendered
+      * @param[in] frameSize raw frame size of the synthetic scene, recorded sources keep their own size
+      * @code
+      *     VirtualStereoCamera cam(VIRTUAL_SOURCE_SYNTHETIC, 30);
+      *     VirtualStereoCamera replay("recording.avi", 15);
+      *     replay.loadCalibParams("recording_calib.yaml");
+      * @endcode
+      */
+    VirtualStereoCamera(std::string source, double frameRate = 30, cv::Size frameSize = cv::Size(1856, 800));
+    virtual ~VirtualStereoCamera();
+
+public:
+    virtual bool isOpened(void);
+    virtual bool setRawFrameRate(int frameRate);
+    virtual bool setRawFrameSize(cv::Size frameSize);
+    virtual float getRawFrameRate(void) const;
+    virtual cv::Size getRawFrameSize(void) const;
+    /**
+      * @fn getRawFrame
+      * @brief block until the next frame is due and return it, time stamp is the time it is returned
+      */
+    virtual bool getRawFrame(cv::Mat &frame, std::chrono::microseconds &timeStamp);
+    virtual bool getStereoFrame(cv::Mat &left, cv::Mat &right, std::chrono::microseconds &timeStamp);
+    /**
+      * @fn startCapture
+      * @brief no device to start, udp and share memory output are not supported
+      */
+    virtual bool startCapture(bool udpFlag = false, bool shmFlag = false);
+    virtual bool stopCapture(void);
+    /**
+      * @fn startStereoCompute
+      * @brief not supported, use StereoPipeline for depth and point cloud of a virtual camera
+      * @return false
+      */
+    virtual bool startStereoCompute(void);
+    virtual bool stopStereoCompute(void);
+    virtual bool getDepthFrame(cv::Mat &depth, bool color, std::chrono::microseconds &timeStamp);
+    virtual bool getPointCloud(std::vector<PCLType> &pcl, std::chrono::microseconds &timeStamp);
+
+public:
+    /**
+      * @fn isSynthetic
+      * @brief get whether frames are rendered from the synthetic scene
+      */
+    bool isSynthetic(void) const;
+    /**
+      * @fn getGroundTruth
+      * @brief render ground truth of a synthetic frame in the rectified left image of a rectifier
+      * @param[in] rectifier rectifier initialized with the calibration of this camera
+      * @param[in] timeStamp time stamp of the frame, the scene moves with it
+      * @param[out] disparity CV_16SC1 disparity with 4 fractional bits like StereoSGBM, -16 where nothing is hit
+      * @param[out] distance CV_32FC1 distance as computed by StereoReprojector, 0 where nothing is hit,
+      * pass nullptr to skip
+      * @return true or false, if camera is synthetic and rectifier is ready return true, otherwise return false
+      * @code
+      *     cv::Mat truth;
+      *     cam.getGroundTruth(rectifier, lease.timeStamp(), truth);
+      *     double error = cv::norm(disparity, truth, cv::NORM_L1, truth > 0) / 16 / cv::countNonZero(truth > 0);
+      * @endcode
+      */
+    bool getGroundTruth(const StereoRectifier &rectifier, std::chrono::microseconds timeStamp,
+                        cv::Mat &disparity, cv::Mat *distance = nullptr) const;
+
+private:
+    void initSynthetic(void);
+    void renderFrame(double time, cv::Mat &frame) const;
+    bool readFrame(cv::Mat &frame);
+};
+
+/**
+  * @fn openStereoCamera
+  * @brief open a camera by config file, a negative DeviceNode opens a VirtualStereoCamera
+  * @details the virtual camera replays VirtualSource, or renders the synthetic scene if VirtualSource is
+  * "synthetic" or missing, at FrameRate and FrameSize. Other device nodes open a UnitreeCamera, or a
+  * V4l2StereoCamera if CaptureBackend is "v4l2". Virtual and V4L2 cameras load CalibParamsFile if it is set,
+  * and rectify at RectifyFrameSize with Depthmode and hFov.
+  * @param[in] fileName camera config file, such as stereo_camera_config.yaml
+  * @return new camera, the caller deletes it
+  * @code
+  *     StereoCamera *cam = openStereoCamera("stereo_camera_config.yaml");
+  *     if(!cam->isOpened())
+  *         exit(EXIT_FAILURE);
+  * @endcode
+  */
+StereoCamera* openStereoCamera(std::string fileName);
+
+#endif //__VIRTUAL_STEREO_CAMERA_HPP__
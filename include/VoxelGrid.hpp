@@ -0,0 +1,154 @@
+/**
+  * @file VoxelGrid.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare the hashed voxel grid APIs.
+  * @details points are binned into cubic voxels and every occupied voxel is reduced to the centroid and mean color
+  * of its points, for downsampling and merging the point clouds of several cameras.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __VOXEL_GRID_HPP__
+#define __VOXEL_GRID_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "PointCloudSoA.hpp"
+#include "StereoCameraCommon.hpp"
+
+/**
+  * @def VOXEL_INDEX_RANGE
+  * @brief voxel indices are kept in 21 bits, points farther than VOXEL_INDEX_RANGE voxels from the origin are dropped
+  */
+#define VOXEL_INDEX_RANGE (1 << 20)
+
+/**
+  * @def VOXEL_NONE
+  * @brief voxel number of a dropped point or an empty neighbor
+  */
+#define VOXEL_NONE UINT32_MAX
+
+/**
+  * @class VoxelGrid
+  * @brief sparse voxel grid in an open addressing hash table
+  * @details the table only grows, a cleared grid keeps its memory, so inserting the same amount of points every
+  * frame does not allocate. clear() is O(1), cells of older frames are told apart by a generation stamp.
+  * Occupied voxels are numbered from 0 in insertion order, extract() never scans empty cells.
+  * @code
+  *     VoxelGrid grid(0.02f);   // 2 cm voxels
+  *     grid.clear();
+  *     grid.insert(leftCloud);
+  *     grid.insert(rightCloud);
+  *     grid.extract(merged);
+  * @endcode
+  */
+class VoxelGrid
+{
+private:
+    typedef struct VoxelCell{
+        uint64_t key;          ///< packed voxel indices
+        uint32_t stamp;        ///< generation the cell belongs to, the cell is empty if it is not the current one
+        uint32_t count;        ///< number of points
+        uint32_t number;       ///< voxel number, index into m_occupied
+        float x, y, z;         ///< sum of point coordinates
+        uint32_t b, g, r;      ///< sum of point colors
+    }VoxelCellType;
+
+    float m_voxelSize = 0;
+    float m_inverseSize = 0;
+    uint32_t m_stamp = 1;
+    std::vector<VoxelCellType> m_cells;   ///< hash table, size is a power of 2
+    std::vector<uint32_t> m_occupied;     ///< cell index of every occupied voxel in insertion order
+
+public:
+    /**
+      * @fn VoxelGrid
+      * @brief VoxelGrid constructor
+      * @param[in] voxelSize voxel edge length, same unit as the points, 0 until setVoxelSize() is called
+      */
+    explicit VoxelGrid(float voxelSize = 0);
+    ~VoxelGrid();
+
+public:
+    /**
+      * @fn setVoxelSize
+      * @brief set voxel edge length, the grid is cleared
+      * @return true or false, if voxelSize is positive return true, otherwise return false
+      */
+    bool setVoxelSize(float voxelSize);
+    /**
+      * @fn getVoxelSize
+      * @brief get voxel edge length
+      */
+    float getVoxelSize(void) const;
+    /**
+      * @fn reserve
+      * @brief make room for at least voxels occupied voxels, so inserting does not grow the table
+      */
+    void reserve(size_t voxels);
+    /**
+      * @fn clear
+      * @brief drop all voxels, memory is kept
+      */
+    void clear(void);
+    /**
+      * @fn insert
+      * @brief add points to the grid
+      * @param[in] x point x array
+      * @param[in] y point y array
+      * @param[in] z point z array
+      * @param[in] color packed point colors, see PointCloudSoA::packColor(), nullptr for white
+      * @param[in] count number of points
+      * @param[out] voxels voxel number of every point, VOXEL_NONE if it is dropped, pass nullptr to skip
+      */
+    void insert(const float *x, const float *y, const float *z, const uint32_t *color, size_t count,
+                uint32_t *voxels = nullptr);
+    /**
+      * @fn insert
+      * @brief add the valid points of a point cloud to the grid
+      */
+    void insert(const PointCloudSoAType &cloud);
+    /**
+      * @fn insert
+      * @brief add the points of a color point cloud to the grid
+      */
+    void insert(const std::vector<PCLType> &cloud);
+    /**
+      * @fn size
+      * @brief get number of occupied voxels
+      */
+    size_t size(void) const;
+    /**
+      * @fn pointCount
+      * @brief get number of points in a voxel
+      * @param[in] voxel voxel number, less than size()
+      */
+    uint32_t pointCount(uint32_t voxel) const;
+    /**
+      * @fn neighbor
+      * @brief get the voxel at an offset from another one
+      * @param[in] voxel voxel number, less than size()
+      * @param[in] dx offset along x in voxels
+      * @param[in] dy offset along y in voxels
+      * @param[in] dz offset along z in voxels
+      * @return voxel number, VOXEL_NONE if that voxel holds no point
+      */
+    uint32_t neighbor(uint32_t voxel, int dx, int dy, int dz) const;
+    /**
+      * @fn extract
+      * @brief write one point per occupied voxel, the centroid and mean color of its points
+      * @param[out] cloud caller-owned point cloud, its arrays are reused, count is set to the number of points written
+      * @param[in] minPoints voxels with fewer points are skipped
+      * @return number of points written
+      */
+    size_t extract(PointCloudSoAType &cloud, uint32_t minPoints = 1) const;
+
+private:
+    bool voxelKey(float x, float y, float z, uint64_t &key) const;
+    uint32_t findCell(uint64_t key) const;
+    uint32_t addPoint(float x, float y, float z, uint32_t color);
+    void grow(void);
+};
+
+#endif //__VOXEL_GRID_HPP__
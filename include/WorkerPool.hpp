@@ -0,0 +1,153 @@
+/**
+  * @file WorkerPool.hpp
+  * @brief This file is part of UnitreeCameraSDK, which declare the worker thread pool APIs.
+  * @details grab, pipeline, rig and callback threads of the SDK are taken from a WorkerPool, so their cpu cores,
+  * scheduling priority and names are set in one place.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+#ifndef __WORKER_POOL_HPP__
+#define __WORKER_POOL_HPP__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SystemLog.hpp"
+
+/**
+  * @struct WorkerPoolConfig
+  * @brief thread attributes of a worker pool
+  */
+typedef struct WorkerPoolConfig{
+    int threadCount = 0;            ///< threads started with the pool, more are started when all are busy, never bounded
+    std::vector<int> cpus;          ///< cpu cores the threads run on, empty for all cores
+    int priority = 0;               ///< SCHED_FIFO priority 1 to 99, 0 keeps the default scheduler
+    std::string name = "camera";    ///< name of idle threads, followed by the thread index
+}WorkerPoolConfigType;
+
+/**
+  * @class WorkerPool
+  * @brief worker threads with cpu affinity, real time priority and names
+  * @details a WorkerPool is a factory of threads sharing one set of attributes, not a bounded pool that shares a few
+  * threads between tasks. A task runs on an idle thread of the pool, if every thread is busy another one is started
+  * with the same attributes, so the grab and stage loops that run until stopped never wait for each other. Every
+  * running loop holds its own thread: per camera one for each product passed to StereoFrameGrabber::startGrab(),
+  * raw frames included, three for StereoPipeline (rectify, disparity, reproject), plus the threads of
+  * CallbackExecutor and CameraRig. Cameras sharing a pool multiply these threads on the cores of the pool, size
+  * cpus for all of them. Threads stay in the pool until it is destroyed, a stopped loop leaves its thread idle for
+  * the next task. A running task renames its thread, names are cut to 15 characters.
+  * Components without a pool set use defaultPool().
+  * OpenCV parallel regions are not covered: the DisparityBands split, tiled rectification, reprojection, temporal
+  * filter, depth colorizing and the matchers themselves run on the single process wide thread pool of OpenCV. It is
+  * created by the first thread that enters a parallel region and is shared by all pools and cameras, its threads
+  * ignore the cpu cores and priority set here. Limit them with setParallelThreads().
+  * @note SCHED_FIFO needs CAP_SYS_NICE or root, without it the threads keep the default scheduler and a warning
+  * is logged.
+  * @attention a SCHED_FIFO thread that does not block starves every lower priority thread on its cores, including
+  * the consumers that must release frame leases before the producer can continue. Do not pin a real time pool onto
+  * the cores of lower priority consumers. The SDK loops block on the camera, on frame channels or on
+  * FramePool::waitFree(), except the grab threads of StereoFrameGrabber on a UnitreeCamera, which poll the
+  * prebuilt library every millisecond while it has no new frame.
+  */
+class WorkerPool
+{
+public:
+    typedef std::function<void(void)> TaskType;
+
+private:
+    typedef struct QueuedTask{
+        std::packaged_task<void(void)> task;
+        std::string name;
+    }QueuedTaskType;
+
+    WorkerPoolConfigType m_config;
+    std::mutex m_lock;
+    std::condition_variable m_trigger;
+    std::deque<QueuedTaskType> m_tasks;
+    std::vector<std::thread*> m_workers;
+    int m_idleCount = 0;
+    bool m_isClosed = false;
+    std::atomic<bool> m_isPriorityWarned;
+
+    SystemLog *m_log = nullptr;
+    std::string m_logName = "WorkerPool";
+
+public:
+    /**
+      * @fn WorkerPool
+      * @brief WorkerPool constructor
+      * @param[in] config thread attributes
+      * @code
+      *     WorkerPoolConfigType config;
+      *     config.cpus = {4, 5, 6, 7};   // the motion controller runs on 0 to 3
+      *     config.priority = 10;
+      *     config.name = "vision";
+      *     WorkerPool pool(config);
+      * @endcode
+      */
+    explicit WorkerPool(const WorkerPoolConfigType &config = WorkerPoolConfigType());
+    /**
+      * @fn ~WorkerPool
+      * @brief WorkerPool destructor, finish queued tasks and join the threads
+      * @attention components using the pool must be stopped before it is destroyed
+      */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+public:
+    /**
+      * @fn submit
+      * @brief run a task on a pool thread
+      * @param[in] task task to run, it may run until the component that submitted it stops
+      * @param[in] name thread name while the task runs, empty keeps the pool name
+      * @return future of the task to wait for it, invalid if the pool is being destroyed
+      * @code
+      *     std::future<void> done = pool.submit([]{ work(); }, "work");
+      *     done.wait();
+      * @endcode
+      */
+    std::future<void> submit(TaskType task, std::string name = "");
+    /**
+      * @fn threadCount
+      * @brief get number of threads started so far
+      */
+    int threadCount(void);
+    /**
+      * @fn getConfig
+      * @brief get thread attributes
+      */
+    WorkerPoolConfigType getConfig(void) const;
+    /**
+      * @fn defaultPool
+      * @brief get the process wide pool of components without a pool set, all cores and default scheduler
+      */
+    static WorkerPool* defaultPool(void);
+    /**
+      * @fn setParallelThreads
+      * @brief set the number of threads of OpenCV parallel regions, process wide, calls cv::setNumThreads()
+      * @param[in] threads 0 runs parallel regions on the calling thread only, so on the pool thread of the task,
+      * negative restores the OpenCV default of one thread per cpu core
+      * @code
+      *     WorkerPool::setParallelThreads(0);   // all stage work stays on the cores and priority of the pool
+      * @endcode
+      */
+    static void setParallelThreads(int threads);
+
+private:
+    void startWorker(void);
+    void taskWorker(int index);
+    void applyConfig(int index);
+    void setThreadName(const std::string &name);
+};
+
+#endif //__WORKER_POOL_HPP__
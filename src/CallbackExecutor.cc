@@ -0,0 +1,42 @@
+/**
+  * @file CallbackExecutor.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement the bounded callback executor.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "CallbackExecutor.hpp"
+
+CallbackExecutor::CallbackExecutor(int threadCount, int queueDepth, WorkerPool *pool) : m_tasks(queueDepth < 1 ? 1 : queueDepth){
+    if(threadCount < 1)
+        threadCount = 1;
+    if(!pool)
+        pool = WorkerPool::defaultPool();
+    for(int i = 0; i < threadCount; i++)
+        m_workers.push_back(pool->submit([this]{ taskWorker(); }, "callback" + std::to_string(i)));
+}
+
+CallbackExecutor::~CallbackExecutor(){
+    m_tasks.close();
+    for(std::future<void> &worker : m_workers)
+        if(worker.valid())
+            worker.wait();
+}
+
+bool CallbackExecutor::submit(TaskType task){
+    return m_tasks.push(std::move(task));
+}
+
+uint64_t CallbackExecutor::dropCount(void) const{
+    return m_tasks.dropCount();
+}
+
+void CallbackExecutor::taskWorker(void){
+    TaskType task;
+    while(m_tasks.pop(task)){
+        task();
+        task = nullptr;
+    }
+}
@@ -0,0 +1,496 @@
+/**
+  * @file CameraRig.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement the multi-camera rig APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "CameraRig.hpp"
+#include "VirtualStereoCamera.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+// product frames of every camera kept for matching frame sets
+#define RIG_HISTORY_DEPTH 4
+
+CameraRig::CameraRig(int workerCount, int poolSize) : m_workerCount(workerCount), m_poolSize(poolSize),
+                                                      m_isRunning(false), m_tolerance(0), m_syncTolerance(0),
+                                                      m_lastReference(0){
+    if(m_workerCount <= 0)
+        m_workerCount = std::max(1, (int)std::thread::hardware_concurrency());
+    m_log = new SystemLog(m_logName);
+    m_log->setLogLevel(1);
+}
+
+CameraRig::~CameraRig(){
+    stopRig();
+    for(RigCameraType *camera : m_cameras){
+        delete camera->pipeline;
+        delete camera->grabber;
+        if(camera->isOwned)
+            delete camera->camera;
+        delete camera;
+    }
+    delete m_log;
+}
+
+bool CameraRig::addCamera(int posNumber, std::string fileName, int priority){
+    if(m_isRunning || posNumber < 1 || posNumber > RIG_POSITION_MAX || findCamera(posNumber)){
+        m_log->runTimeError("Camera position %d is invalid or in use!", posNumber);
+        return false;
+    }
+    StereoCamera *camera = openStereoCamera(fileName);
+    if(!camera->isOpened()){
+        m_log->runTimeError("Open camera %d by %s failed!", posNumber, fileName.c_str());
+        delete camera;
+        return false;
+    }
+    if(!insertCamera(posNumber, camera, fileName, priority, true)){
+        delete camera;
+        return false;
+    }
+    return true;
+}
+
+bool CameraRig::addCamera(int posNumber, StereoCamera *camera, std::string fileName, int priority){
+    return insertCamera(posNumber, camera, fileName, priority, false);
+}
+
+bool CameraRig::insertCamera(int posNumber, StereoCamera *camera, std::string fileName, int priority, bool isOwned){
+    if(m_isRunning || posNumber < 1 || posNumber > RIG_POSITION_MAX || findCamera(posNumber)){
+        m_log->runTimeError("Camera position %d is invalid or in use!", posNumber);
+        return false;
+    }
+    if(!camera || !camera->isOpened()){
+        m_log->runTimeError("Camera %d is not opened!", posNumber);
+        return false;
+    }
+
+    StereoPipeline *pipeline = new StereoPipeline();
+    if(!fileName.empty() && !pipeline->loadConfig(fileName))
+        m_log->runTimeWarning("Read pipeline config %s failed, camera %d uses default parameters.",
+                              fileName.c_str(), posNumber);
+    // whole frames on one worker, the cameras keep the other workers busy
+    StereoPipelineConfigType config = pipeline->getConfig();
+    config.disparityBands = 1;
+    if(!pipeline->setConfig(config) || !pipeline->init(camera)){
+        m_log->runTimeError("Init pipeline of camera %d failed!", posNumber);
+        delete pipeline;
+        return false;
+    }
+    camera->setPosNumber(posNumber);
+
+    RigCameraType *rigCamera = new RigCameraType();
+    rigCamera->posNumber = posNumber;
+    rigCamera->priority = priority;
+    rigCamera->fileName = fileName;
+    rigCamera->isOwned = isOwned;
+    rigCamera->isCloudSoA = config.cloudSoA;
+    rigCamera->camera = camera;
+    rigCamera->grabber = new StereoFrameGrabber();
+    rigCamera->pipeline = pipeline;
+    m_cameras.insert(std::upper_bound(m_cameras.begin(), m_cameras.end(), rigCamera,
+                                      [](const RigCameraType *a, const RigCameraType *b){
+                                          return a->posNumber < b->posNumber;
+                                      }), rigCamera);
+    m_log->runTimeInfo("Add camera %d, priority %d.", posNumber, priority);
+    return true;
+}
+
+StereoCamera* CameraRig::getCamera(int posNumber){
+    RigCameraType *camera = findCamera(posNumber);
+    return camera ? camera->camera : nullptr;
+}
+
+std::vector<int> CameraRig::getPosNumbers(void) const{
+    std::vector<int> posNumbers;
+    for(const RigCameraType *camera : m_cameras)
+        posNumbers.push_back(camera->posNumber);
+    return posNumbers;
+}
+
+bool CameraRig::setProduct(int product){
+    if(m_isRunning || (product != PIPELINE_DISPARITY && product != PIPELINE_DEPTH_FRAME && product != PIPELINE_POINT_CLOUD))
+        return false;
+    m_product = product;
+    return true;
+}
+
+bool CameraRig::setSchedule(int schedule){
+    if(schedule != RIG_SCHEDULE_FAIR && schedule != RIG_SCHEDULE_PRIORITY)
+        return false;
+    std::lock_guard<std::mutex> lock(m_jobLock);
+    m_schedule = schedule;
+    return true;
+}
+
+bool CameraRig::setPriority(int posNumber, int priority){
+    RigCameraType *camera = findCamera(posNumber);
+    if(!camera)
+        return false;
+    std::lock_guard<std::mutex> lock(m_jobLock);
+    camera->priority = priority;
+    return true;
+}
+
+void CameraRig::setSyncTolerance(std::chrono::microseconds tolerance){
+    std::lock_guard<std::mutex> lock(m_setLock);
+    m_tolerance = std::max(std::chrono::microseconds(0), tolerance);
+    m_syncTolerance = m_tolerance;
+}
+
+bool CameraRig::setExtrinsics(int posNumber, const cv::Mat &transform){
+    RigCameraType *camera = findCamera(posNumber);
+    if(m_isRunning || !camera){
+        m_log->runTimeError("Rig is running or camera %d is not found!", posNumber);
+        return false;
+    }
+    if(!camera->pipeline->setBodyTransform(transform)){
+        m_log->runTimeError("Invalid extrinsics of camera %d!", posNumber);
+        return false;
+    }
+    return true;
+}
+
+bool CameraRig::setFusionVoxelSize(float voxelSize){
+    if(voxelSize < 0)
+        return false;
+    std::lock_guard<std::mutex> lock(m_fuseLock);
+    m_fusionVoxelSize = voxelSize;
+    if(voxelSize > 0)
+        m_fuseGrid.setVoxelSize(voxelSize);
+    return true;
+}
+
+bool CameraRig::fuseCloud(const RigFrameSetType &frameSet, PointCloudSoAType &cloud){
+    cloud.count = 0;
+    if(m_product != PIPELINE_POINT_CLOUD || frameSet.sequence == 0 || frameSet.frames.size() != frameSet.posNumbers.size())
+        return false;
+    std::vector<const RigCameraType*> cameras;
+    size_t total = 0;
+    for(size_t i = 0; i < frameSet.frames.size(); i++){
+        const RigCameraType *camera = findCamera(frameSet.posNumbers[i]);
+        if(!camera || !frameSet.frames[i].isValid())
+            return false;
+        cameras.push_back(camera);
+        total += camera->isCloudSoA ? frameSet.frames[i].cloudSoA().count : frameSet.frames[i].cloud().size();
+    }
+
+    std::lock_guard<std::mutex> lock(m_fuseLock);
+    if(m_fusionVoxelSize > 0){
+        m_fuseGrid.clear();
+        for(size_t i = 0; i < frameSet.frames.size(); i++){
+            if(cameras[i]->isCloudSoA)
+                m_fuseGrid.insert(frameSet.frames[i].cloudSoA());
+            else
+                m_fuseGrid.insert(frameSet.frames[i].cloud());
+        }
+        m_fuseGrid.extract(cloud);
+        return true;
+    }
+
+    cloud.reserve(total);
+    for(size_t i = 0; i < frameSet.frames.size(); i++){
+        if(cameras[i]->isCloudSoA){
+            const PointCloudSoAType &points = frameSet.frames[i].cloudSoA();
+            std::copy(points.x.begin(), points.x.begin() + points.count, cloud.x.begin() + cloud.count);
+            std::copy(points.y.begin(), points.y.begin() + points.count, cloud.y.begin() + cloud.count);
+            std::copy(points.z.begin(), points.z.begin() + points.count, cloud.z.begin() + cloud.count);
+            std::copy(points.color.begin(), points.color.begin() + points.count, cloud.color.begin() + cloud.count);
+            cloud.count += points.count;
+            continue;
+        }
+        for(const PCLType &point : frameSet.frames[i].cloud()){
+            cloud.x[cloud.count] = point.pts[0];
+            cloud.y[cloud.count] = point.pts[1];
+            cloud.z[cloud.count] = point.pts[2];
+            cloud.color[cloud.count] = PointCloudSoAType::packColor(point.clr[0], point.clr[1], point.clr[2]);
+            cloud.count++;
+        }
+    }
+    return true;
+}
+
+bool CameraRig::setWorkerPool(WorkerPool *pool){
+    if(m_isRunning){
+        m_log->runTimeWarning("Rig is running, stop it before changing worker pool!");
+        return false;
+    }
+    m_workerPool = pool;
+    return true;
+}
+
+bool CameraRig::startRig(void){
+    if(m_isRunning){
+        m_log->runTimeWarning("Rig is already running!");
+        return false;
+    }
+    if(m_cameras.empty()){
+        m_log->runTimeError("Rig has no camera!");
+        return false;
+    }
+
+    float minFrameRate = 0;
+    for(RigCameraType *camera : m_cameras){
+        float frameRate = camera->camera->getRawFrameRate();
+        if(frameRate > 0 && (minFrameRate == 0 || frameRate < minFrameRate))
+            minFrameRate = frameRate;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_setLock);
+        m_syncTolerance = m_tolerance;
+        if(m_syncTolerance.count() == 0)
+            m_syncTolerance = std::chrono::microseconds((int64_t)(500000 / (minFrameRate > 0 ? minFrameRate : 30)));
+        m_frameSet = RigFrameSetType();
+        m_lastReference = std::chrono::microseconds(0);
+        m_mismatchCount = 0;
+    }
+
+    for(RigCameraType *camera : m_cameras){
+        camera->pool = new FramePool(m_poolSize + RIG_HISTORY_DEPTH);
+        camera->channel.setHistoryDepth(RIG_HISTORY_DEPTH);
+        camera->channel.open();
+        camera->stats.reset();
+        camera->served = 0;
+    }
+    m_isRunning = true;
+    WorkerPool *workerPool = m_workerPool ? m_workerPool : WorkerPool::defaultPool();
+    int workerCount = std::min(m_workerCount, (int)m_cameras.size());
+    for(int i = 0; i < workerCount; i++)
+        m_workers.push_back(workerPool->submit([this]{ rigWorker(); }, "rig" + std::to_string(i)));
+
+    for(RigCameraType *camera : m_cameras){
+        camera->grabber->setWorkerPool(m_workerPool);
+        if(!camera->camera->startCapture() || !camera->grabber->startGrab(camera->camera)){
+            m_log->runTimeError("Start camera %d failed!", camera->posNumber);
+            stopRig();
+            return false;
+        }
+        // the grab thread only hands the raw lease over, a newer frame replaces a waiting one
+        camera->rawCallback = camera->grabber->registerCallback(GRAB_RAW_FRAME, [this, camera](const FrameLease &raw){
+            {
+                std::lock_guard<std::mutex> lock(m_jobLock);
+                if(camera->pending.isValid())
+                    camera->stats.drop();
+                camera->pending = raw;
+            }
+            m_jobTrigger.notify_one();
+        });
+    }
+
+    m_log->runTimeInfo("Start camera rig, %d cameras on %d workers ...", (int)m_cameras.size(), workerCount);
+    return true;
+}
+
+bool CameraRig::stopRig(void){
+    if(!m_isRunning)
+        return false;
+
+    for(RigCameraType *camera : m_cameras){
+        if(camera->rawCallback >= 0)
+            camera->grabber->unregisterCallback(GRAB_RAW_FRAME, camera->rawCallback);
+        camera->rawCallback = -1;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_jobLock);
+        m_isRunning = false;
+    }
+    m_jobTrigger.notify_all();
+    for(std::future<void> &worker : m_workers)
+        if(worker.valid())
+            worker.wait();
+    m_workers.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_setLock);
+        m_frameSet = RigFrameSetType();
+    }
+    m_setTrigger.notify_all();
+
+    for(RigCameraType *camera : m_cameras){
+        camera->pending.release();
+        camera->channel.close();
+        if(camera->grabber->isGrabbing())
+            camera->grabber->stopGrab();
+        camera->camera->stopCapture();
+        if(camera->pool->freeCount() != camera->pool->size())
+            m_log->runTimeError("Frame leases of camera %d are still held while stopping rig!", camera->posNumber);
+        delete camera->pool;
+        camera->pool = nullptr;
+    }
+
+    m_log->runTimeInfo("Stop camera rig done.");
+    return true;
+}
+
+bool CameraRig::isRunning(void) const{
+    return m_isRunning;
+}
+
+bool CameraRig::waitForFrame(int posNumber, FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout){
+    RigCameraType *camera = findCamera(posNumber);
+    return camera && camera->channel.waitNewer(lease, sequence, timeout);
+}
+
+bool CameraRig::waitForFrameSet(RigFrameSetType &frameSet, uint64_t &sequence, std::chrono::microseconds timeout){
+    std::unique_lock<std::mutex> lock(m_setLock);
+    uint64_t last = sequence;
+    if(!m_setTrigger.wait_for(lock, timeout, [this, last]{ return !m_isRunning || m_frameSet.sequence > last; }))
+        return false;
+    if(!m_isRunning)
+        return false;
+    frameSet = m_frameSet;
+    sequence = frameSet.sequence;
+    return true;
+}
+
+uint64_t CameraRig::getMismatchCount(void){
+    std::lock_guard<std::mutex> lock(m_setLock);
+    return m_mismatchCount;
+}
+
+void CameraRig::getStats(std::vector<StageStatsType> &stats) const{
+    stats.clear();
+    for(const RigCameraType *camera : m_cameras){
+        StageStatsType stage;
+        stage.name = "pos" + std::to_string(camera->posNumber);
+        camera->stats.snapshot(stage);
+        stats.push_back(stage);
+    }
+}
+
+CameraRig::RigCameraType* CameraRig::findCamera(int posNumber) const{
+    for(RigCameraType *camera : m_cameras)
+        if(camera->posNumber == posNumber)
+            return camera;
+    return nullptr;
+}
+
+CameraRig::RigCameraType* CameraRig::nextCamera(void){
+    RigCameraType *next = nullptr;
+    for(RigCameraType *camera : m_cameras){
+        if(camera->isBusy || !camera->pending.isValid())
+            continue;
+        if(!next){
+            next = camera;
+            continue;
+        }
+        if(m_schedule == RIG_SCHEDULE_PRIORITY && camera->priority != next->priority){
+            if(camera->priority > next->priority)
+                next = camera;
+            continue;
+        }
+        if(camera->served < next->served ||
+           (camera->served == next->served && camera->pending.timeStamp() < next->pending.timeStamp()))
+            next = camera;
+    }
+    return next;
+}
+
+void CameraRig::rigWorker(void){
+    std::unique_lock<std::mutex> lock(m_jobLock);
+    while(m_isRunning){
+        RigCameraType *camera = nextCamera();
+        if(!camera){
+            m_jobTrigger.wait(lock);
+            continue;
+        }
+        FrameLease raw = std::move(camera->pending);
+        camera->isBusy = true;
+        camera->served++;
+        lock.unlock();
+
+        processFrame(camera, raw);
+        raw.release();
+
+        lock.lock();
+        camera->isBusy = false;
+        // a frame of this camera that came in meanwhile was skipped by the other workers
+        if(camera->pending.isValid())
+            m_jobTrigger.notify_one();
+    }
+}
+
+void CameraRig::processFrame(RigCameraType *camera, const FrameLease &raw){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int index = -1;
+    PooledFrameType *slot = camera->pool->acquire(index);
+    if(!slot){
+        camera->stats.drop();
+        m_log->debugTimeWarning("All buffers of camera %d are leased, drop frame.", camera->posNumber);
+        return;
+    }
+
+    bool isDone;
+    switch(m_product){
+    case PIPELINE_DISPARITY:
+        isDone = camera->pipeline->processFrame(raw.data1(), camera->left, camera->right, slot->data1, nullptr, nullptr);
+        break;
+    case PIPELINE_DEPTH_FRAME:
+        isDone = camera->pipeline->processFrame(raw.data1(), camera->left, camera->right, camera->disparity,
+                                                &slot->data1, nullptr);
+        break;
+    default:
+        if(camera->isCloudSoA)
+            isDone = camera->pipeline->processFrame(raw.data1(), camera->left, camera->right, camera->disparity,
+                                                    nullptr, slot->cloudSoA);
+        else
+            isDone = camera->pipeline->processFrame(raw.data1(), camera->left, camera->right, camera->disparity,
+                                                    nullptr, &slot->cloud);
+        break;
+    }
+    if(!isDone){
+        camera->pool->discard(index);
+        camera->stats.drop();
+        return;
+    }
+    slot->timeStamp = raw.timeStamp();
+    slot->sequence = camera->channel.nextSequence();
+    camera->channel.publish(camera->pool->commit(index));
+    camera->stats.record(start);
+    updateFrameSet();
+}
+
+void CameraRig::updateFrameSet(void){
+    std::lock_guard<std::mutex> lock(m_setLock);
+    if(!m_isRunning)
+        return;
+
+    // the slowest camera decides when a frame set is complete
+    std::chrono::microseconds reference(INT64_MAX);
+    for(RigCameraType *camera : m_cameras){
+        FrameLease latest;
+        if(!camera->channel.latest(latest))
+            return;
+        reference = std::min(reference, latest.timeStamp());
+    }
+    if(reference <= m_lastReference)
+        return;
+    m_lastReference = reference;
+
+    RigFrameSetType frameSet;
+    frameSet.timeStamp = reference;
+    frameSet.sequence = m_frameSet.sequence + 1;
+    std::chrono::microseconds earliest = reference, latest = reference;
+    for(RigCameraType *camera : m_cameras){
+        FrameLease frame;
+        if(!camera->channel.findFrame(reference, frame))
+            return;
+        std::chrono::microseconds distance = frame.timeStamp() - reference;
+        if(std::abs(distance.count()) > m_syncTolerance.count()){
+            // skip this reference, the next frame of the slowest camera tries again
+            m_mismatchCount++;
+            m_log->debugTimeWarning("Camera %d is %.1f ms off the frame set, drop frame set.", camera->posNumber,
+                                    distance.count() / 1000.0);
+            return;
+        }
+        earliest = std::min(earliest, frame.timeStamp());
+        latest = std::max(latest, frame.timeStamp());
+        frameSet.posNumbers.push_back(camera->posNumber);
+        frameSet.frames.push_back(std::move(frame));
+    }
+    frameSet.spread = latest - earliest;
+    m_frameSet = std::move(frameSet);
+    m_setTrigger.notify_all();
+}
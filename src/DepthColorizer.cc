@@ -0,0 +1,198 @@
+/**
+  * @file DepthColorizer.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement lookup-table depth colorization APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "DepthColorizer.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#include <arm_neon.h>
+#define COLORIZE_NEON
+#endif
+
+static inline float clamp01(float value){
+    return std::min(1.f, std::max(0.f, value));
+}
+
+// color of position t in [0, 1] as red, green, blue in [0, 1]
+static void paletteColor(int palette, float t, float rgb[3]){
+    switch(palette){
+    case PALETTE_TURBO:{
+        // polynomial fit of the turbo colormap
+        const float r[] = {0.13572138f, 4.61539260f, -42.66032258f, 132.13108234f, -152.94239396f, 59.28637943f};
+        const float g[] = {0.09140261f, 2.19418839f, 4.84296658f, -14.18503333f, 4.27729857f, 2.82956604f};
+        const float b[] = {0.10667330f, 12.64194608f, -60.58204836f, 110.36276771f, -89.90310912f, 27.34824973f};
+        float sum[3] = {0, 0, 0}, power = 1;
+        for(int i = 0; i < 6; i++, power *= t){
+            sum[0] += r[i] * power;
+            sum[1] += g[i] * power;
+            sum[2] += b[i] * power;
+        }
+        for(int c = 0; c < 3; c++)
+            rgb[c] = clamp01(sum[c]);
+        break;
+    }
+    case PALETTE_HOT:
+        rgb[0] = clamp01(3 * t);
+        rgb[1] = clamp01(3 * t - 1);
+        rgb[2] = clamp01(3 * t - 2);
+        break;
+    case PALETTE_GRAY:
+        rgb[0] = rgb[1] = rgb[2] = t;
+        break;
+    default:
+        rgb[0] = clamp01(1.5f - std::fabs(4 * t - 3));
+        rgb[1] = clamp01(1.5f - std::fabs(4 * t - 2));
+        rgb[2] = clamp01(1.5f - std::fabs(4 * t - 1));
+        break;
+    }
+}
+
+static inline uint32_t packColor(const float rgb[3]){
+    return (uint32_t)std::lround(rgb[2] * 255) | ((uint32_t)std::lround(rgb[1] * 255) << 8) |
+           ((uint32_t)std::lround(rgb[0] * 255) << 16);
+}
+
+static inline void storeColor(unsigned char *out, uint32_t color){
+    out[0] = (unsigned char)color;
+    out[1] = (unsigned char)(color >> 8);
+    out[2] = (unsigned char)(color >> 16);
+}
+
+// widest row whose scratch buffers stay on the stack, raw frames are 1856 columns at most
+#define COLORIZE_ROW_STACK 2048
+
+// table index of float depth, DEPTH_LUT_SIZE for invalid depth
+static void depthIndex(const float *depth, int count, float minDepth, float scale, int *index){
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128 zero = _mm_setzero_ps(), minV = _mm_set1_ps(minDepth), scaleV = _mm_set1_ps(scale);
+    const __m128 last = _mm_set1_ps(DEPTH_LUT_SIZE - 1);
+    const __m128i invalid = _mm_set1_epi32(DEPTH_LUT_SIZE);
+    for(; i + 4 <= count; i += 4){
+        __m128 d = _mm_loadu_ps(depth + i);
+        __m128 t = _mm_min_ps(last, _mm_max_ps(zero, _mm_mul_ps(_mm_sub_ps(d, minV), scaleV)));
+        __m128i valid = _mm_castps_si128(_mm_cmpgt_ps(d, zero));
+        // add one half and truncate like the scalar and NEON paths, _mm_cvtps_epi32() would round half to even
+        __m128i idx = _mm_cvttps_epi32(_mm_add_ps(t, _mm_set1_ps(0.5f)));
+        _mm_storeu_si128((__m128i*)(index + i), _mm_or_si128(_mm_and_si128(valid, idx), _mm_andnot_si128(valid, invalid)));
+    }
+#elif defined(COLORIZE_NEON)
+    const float32x4_t zero = vdupq_n_f32(0), minV = vdupq_n_f32(minDepth), scaleV = vdupq_n_f32(scale);
+    const float32x4_t last = vdupq_n_f32(DEPTH_LUT_SIZE - 1);
+    const int32x4_t invalid = vdupq_n_s32(DEPTH_LUT_SIZE);
+    for(; i + 4 <= count; i += 4){
+        float32x4_t d = vld1q_f32(depth + i);
+        float32x4_t t = vminq_f32(last, vmaxq_f32(zero, vmulq_f32(vsubq_f32(d, minV), scaleV)));
+        uint32x4_t valid = vcgtq_f32(d, zero);
+        int32x4_t idx = vcvtq_s32_f32(vaddq_f32(t, vdupq_n_f32(0.5f)));
+        vst1q_s32(index + i, vbslq_s32(valid, idx, invalid));
+    }
+#endif
+    for(; i < count; i++){
+        if(!(depth[i] > 0)){
+            index[i] = DEPTH_LUT_SIZE;
+            continue;
+        }
+        float t = std::min((float)(DEPTH_LUT_SIZE - 1), std::max(0.f, (depth[i] - minDepth) * scale));
+        index[i] = (int)(t + 0.5f);
+    }
+}
+
+DepthColorizer::DepthColorizer(int palette, float minDepth, float maxDepth){
+    m_palette = palette;
+    if(minDepth < maxDepth){
+        m_minDepth = minDepth;
+        m_maxDepth = maxDepth;
+    }
+    buildTable();
+}
+
+DepthColorizer::~DepthColorizer(){
+}
+
+bool DepthColorizer::setPalette(int palette, bool inverted){
+    if(palette < PALETTE_JET || palette > PALETTE_GRAY)
+        return false;
+    m_palette = palette;
+    m_isInverted = inverted;
+    buildTable();
+    return true;
+}
+
+bool DepthColorizer::setDepthRange(float minDepth, float maxDepth){
+    if(!(minDepth < maxDepth))
+        return false;
+    m_minDepth = minDepth;
+    m_maxDepth = maxDepth;
+    return true;
+}
+
+int DepthColorizer::getPalette(void) const{
+    return m_palette;
+}
+
+void DepthColorizer::buildTable(void){
+    float rgb[3];
+    m_lut.resize(DEPTH_LUT_SIZE + 1);
+    for(int i = 0; i < DEPTH_LUT_SIZE; i++){
+        float t = (float)i / (DEPTH_LUT_SIZE - 1);
+        paletteColor(m_palette, m_isInverted ? 1 - t : t, rgb);
+        m_lut[i] = packColor(rgb);
+    }
+    m_lut[DEPTH_LUT_SIZE] = 0;
+
+    m_lut8.resize(256);
+    m_lut8[0] = 0;
+    for(int i = 1; i < 256; i++)
+        m_lut8[i] = m_lut[(i * (DEPTH_LUT_SIZE - 1) + 127) / 255];
+}
+
+bool DepthColorizer::colorize(const cv::Mat &depth, cv::Mat &color) const{
+    if(depth.empty() || depth.channels() != 1)
+        return false;
+    if(depth.type() != CV_32FC1 && depth.type() != CV_16UC1 && depth.type() != CV_8UC1)
+        return false;
+
+    color.create(depth.size(), CV_8UC3);
+    float scale = (DEPTH_LUT_SIZE - 1) / (m_maxDepth - m_minDepth);
+    const uint32_t *lut = m_lut.data(), *lut8 = m_lut8.data();
+
+    cv::parallel_for_(cv::Range(0, depth.rows), [&](const cv::Range &range){
+        // one buffer per stripe, on the stack up to COLORIZE_ROW_STACK columns
+        cv::AutoBuffer<int, COLORIZE_ROW_STACK> index(depth.cols);
+        cv::AutoBuffer<float, COLORIZE_ROW_STACK> meter(depth.type() == CV_16UC1 ? depth.cols : 0);
+        for(int v = range.start; v < range.end; v++){
+            unsigned char *out = color.ptr<unsigned char>(v);
+            if(depth.type() == CV_8UC1){
+                const unsigned char *gray = depth.ptr<unsigned char>(v);
+                for(int u = 0; u < depth.cols; u++)
+                    storeColor(out + 3 * u, lut8[gray[u]]);
+                continue;
+            }
+
+            const float *row;
+            if(depth.type() == CV_16UC1){
+                const unsigned short *mm = depth.ptr<unsigned short>(v);
+                for(int u = 0; u < depth.cols; u++)
+                    meter[u] = mm[u] * 0.001f;
+                row = meter.data();
+            }
+            else{
+                row = depth.ptr<float>(v);
+            }
+            depthIndex(row, depth.cols, m_minDepth, scale, index.data());
+            for(int u = 0; u < depth.cols; u++)
+                storeColor(out + 3 * u, lut[index[u]]);
+        }
+    });
+    return true;
+}
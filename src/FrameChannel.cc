@@ -0,0 +1,273 @@
+/**
+  * @file FrameChannel.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement the latest-frame channel APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "FrameChannel.hpp"
+#include <cstdlib>
+#include <thread>
+
+static uint64_t packSlot(uint64_t sequence, int index){
+    return sequence << 16 | (uint64_t)(index + 1);
+}
+
+FrameChannel::FrameChannel(void) : m_isClosed(false), m_sequence(0), m_latestSlot(0), m_latestPool(nullptr),
+                                   m_readers(0), m_historyDepth(0), m_callbackCount(0), m_waiters(0){
+    for(HistoryEntryType &entry : m_history){
+        entry.slot.store(0);
+        entry.timeStamp.store(0);
+    }
+}
+
+FrameChannel::~FrameChannel(){
+    close();
+}
+
+void FrameChannel::open(void){
+    std::lock_guard<std::mutex> lock(m_lock);
+    clearLatest();
+    m_isClosed = false;
+}
+
+void FrameChannel::close(void){
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_isClosed = true;
+        clearLatest();
+    }
+    wakeWaiters();
+}
+
+uint64_t FrameChannel::nextSequence(void) const{
+    return m_sequence.load(std::memory_order_relaxed) + 1;
+}
+
+void FrameChannel::publish(FrameLease &&lease){
+    FrameLease previous, current, evicted;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if(m_isClosed || !lease.isValid())
+            return;
+        uint64_t sequence = lease.sequence();
+        previous = std::move(m_latest);
+        m_latest = std::move(lease);
+        current = m_latest;
+        uint64_t slot = packSlot(sequence, m_latest.m_index);
+        m_latestPool.store(m_latest.m_pool);
+
+        int depth = m_historyDepth;
+        if(depth > 0){
+            HistoryEntryType &entry = m_history[sequence % depth];
+            entry.slot.store(0);
+            entry.timeStamp.store(current.timeStamp().count());
+            entry.slot.store(slot);
+            evicted = std::move(entry.lease);
+            entry.lease = current;
+        }
+        m_latestSlot.store(slot);
+        m_sequence.store(sequence);
+    }
+    // replaced slots are released after they are unpublished, consumers still holding them keep them alive
+    previous.release();
+    evicted.release();
+    if(m_waiters.load() > 0)
+        wakeWaiters();
+    pushCallbacks(current);
+}
+
+bool FrameChannel::latest(FrameLease &lease) const{
+    uint64_t sequence;
+    if(leaseLatest(lease, sequence))
+        return true;
+    lease.release();
+    return false;
+}
+
+bool FrameChannel::waitNewer(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout){
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+    uint64_t last = sequence;
+    while(!m_isClosed){
+        uint64_t current;
+        if((m_latestSlot.load() >> 16) > last && leaseLatest(lease, current) && current > last){
+            sequence = current;
+            return true;
+        }
+
+        // the producer reads m_waiters after it stores m_latestSlot, one of both sees the other
+        std::unique_lock<std::mutex> lock(m_waitLock);
+        m_waiters++;
+        bool ready = m_trigger.wait_until(lock, deadline, [this, last]{
+            return m_isClosed || (m_latestSlot.load() >> 16) > last;
+        });
+        m_waiters--;
+        if(!ready)
+            return false;
+    }
+    return false;
+}
+
+bool FrameChannel::setHistoryDepth(int depth){
+    if(depth < 0 || depth > FRAME_HISTORY_MAX)
+        return false;
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_historyDepth = 0;
+    for(HistoryEntryType &entry : m_history)
+        entry.slot.store(0);
+    while(m_readers.load() > 0)
+        std::this_thread::yield();
+    for(HistoryEntryType &entry : m_history)
+        entry.lease.release();
+    m_historyDepth = depth;
+    return true;
+}
+
+int FrameChannel::historyDepth(void) const{
+    return m_historyDepth;
+}
+
+bool FrameChannel::findFrame(std::chrono::microseconds timeStamp, FrameLease &lease, bool exact) const{
+    bool isLeased = false, isFound = true;
+    m_readers++;
+    while(!isLeased && isFound){
+        // a time stamp belongs to a slot if the slot reads the same before and after it
+        uint64_t best = 0;
+        int64_t bestDistance = 0;
+        int depth = m_historyDepth;
+        for(int i = 0; i < depth; i++){
+            uint64_t slot = m_history[i].slot.load();
+            int64_t stamp = m_history[i].timeStamp.load();
+            if(slot == 0 || m_history[i].slot.load() != slot)
+                continue;
+            int64_t distance = std::abs(stamp - (int64_t)timeStamp.count());
+            if((exact && distance != 0) || (best != 0 && (distance > bestDistance || (distance == bestDistance && slot < best))))
+                continue;
+            best = slot;
+            bestDistance = distance;
+        }
+        isFound = best != 0;
+        // a slot recycled since the scan fails, scan again
+        isLeased = isFound && leaseSlot(best, lease);
+    }
+    m_readers--;
+    return isLeased;
+}
+
+bool FrameChannel::findFrame(uint64_t sequence, FrameLease &lease) const{
+    int depth = m_historyDepth;
+    if(depth == 0 || sequence == 0)
+        return false;
+    m_readers++;
+    uint64_t slot = m_history[sequence % depth].slot.load();
+    bool isLeased = (slot >> 16) == sequence && leaseSlot(slot, lease);
+    m_readers--;
+    return isLeased;
+}
+
+bool FrameChannel::leaseLatest(FrameLease &lease, uint64_t &sequence) const{
+    bool isLeased = false;
+    m_readers++;
+    while(!isLeased){
+        uint64_t slot = m_latestSlot.load();
+        if(slot == 0)
+            break;
+        sequence = slot >> 16;
+        // fails only if the producer replaced the frame after the load, the next load sees the new one
+        isLeased = leaseSlot(slot, lease);
+    }
+    m_readers--;
+    return isLeased;
+}
+
+bool FrameChannel::leaseSlot(uint64_t slot, FrameLease &lease) const{
+    FramePool *pool = m_latestPool.load();
+    return pool && pool->tryLease((int)(slot & 0xffff) - 1, slot >> 16, lease);
+}
+
+void FrameChannel::clearLatest(void){
+    m_latestSlot.store(0);
+    for(HistoryEntryType &entry : m_history)
+        entry.slot.store(0);
+    // consumers that loaded an old slot may still touch its pool, wait until they are out
+    while(m_readers.load() > 0)
+        std::this_thread::yield();
+    m_latestPool.store(nullptr);
+    m_latest.release();
+    for(HistoryEntryType &entry : m_history)
+        entry.lease.release();
+}
+
+void FrameChannel::wakeWaiters(void){
+    {
+        std::lock_guard<std::mutex> lock(m_waitLock);
+    }
+    m_trigger.notify_all();
+}
+
+int FrameChannel::addCallback(FrameCallbackType callback, CallbackExecutor *executor){
+    std::shared_ptr<CallbackEntryType> entry = std::make_shared<CallbackEntryType>();
+    entry->callback = std::move(callback);
+    entry->executor = executor;
+    std::lock_guard<std::mutex> lock(m_callbackLock);
+    entry->id = ++m_callbackId;
+    m_callbacks.push_back(entry);
+    m_callbackCount = (int)m_callbacks.size();
+    return entry->id;
+}
+
+bool FrameChannel::removeCallback(int id){
+    std::unique_lock<std::mutex> lock(m_callbackLock);
+    for(auto it = m_callbacks.begin(); it != m_callbacks.end(); ++it){
+        if((*it)->id == id){
+            (*it)->isRemoved = true;
+            m_callbacks.erase(it);
+            m_callbackCount = (int)m_callbacks.size();
+            // the producer thread is the one running it, waiting there would never end
+            if(std::this_thread::get_id() != m_pushThread)
+                m_callbackDone.wait(lock, [this, id]{ return m_runningId != id; });
+            return true;
+        }
+    }
+    return false;
+}
+
+int FrameChannel::callbackCount(void) const{
+    return m_callbackCount;
+}
+
+void FrameChannel::pushCallbacks(const FrameLease &lease){
+    if(m_callbackCount == 0)
+        return;
+    {
+        // callbacks run unlocked, so they can register and unregister callbacks without a deadlock
+        std::lock_guard<std::mutex> lock(m_callbackLock);
+        m_pushList.assign(m_callbacks.begin(), m_callbacks.end());
+        m_pushThread = std::this_thread::get_id();
+    }
+    for(const std::shared_ptr<CallbackEntryType> &entry : m_pushList){
+        {
+            std::lock_guard<std::mutex> lock(m_callbackLock);
+            if(entry->isRemoved)
+                continue;
+            // queued under the lock, nothing is queued after removeCallback() returns
+            if(entry->executor){
+                FrameCallbackType callback = entry->callback;
+                FrameLease frame = lease;
+                entry->executor->submit([callback, frame]{ callback(frame); });
+                continue;
+            }
+            m_runningId = entry->id;
+        }
+        entry->callback(lease);
+        {
+            std::lock_guard<std::mutex> lock(m_callbackLock);
+            m_runningId = 0;
+        }
+        m_callbackDone.notify_all();
+    }
+    // drop the references, the list keeps its capacity for the next frame
+    m_pushList.clear();
+}
@@ -0,0 +1,188 @@
+/**
+  * @file FramePool.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement the pooled frame buffers and frame lease APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "FramePool.hpp"
+
+FrameLease::FrameLease(void){
+}
+
+FrameLease::FrameLease(FramePool *pool, int index) : m_pool(pool), m_index(index){
+}
+
+FrameLease::FrameLease(const FrameLease &other) : m_pool(other.m_pool), m_index(other.m_index){
+    if(m_pool)
+        m_pool->retain(m_index);
+}
+
+FrameLease::FrameLease(FrameLease &&other) : m_pool(other.m_pool), m_index(other.m_index){
+    other.m_pool = nullptr;
+    other.m_index = -1;
+}
+
+FrameLease& FrameLease::operator=(const FrameLease &other){
+    if(this == &other)
+        return *this;
+    if(other.m_pool)
+        other.m_pool->retain(other.m_index);
+    release();
+    m_pool = other.m_pool;
+    m_index = other.m_index;
+    return *this;
+}
+
+FrameLease& FrameLease::operator=(FrameLease &&other){
+    if(this == &other)
+        return *this;
+    release();
+    m_pool = other.m_pool;
+    m_index = other.m_index;
+    other.m_pool = nullptr;
+    other.m_index = -1;
+    return *this;
+}
+
+FrameLease::~FrameLease(){
+    release();
+}
+
+bool FrameLease::isValid(void) const{
+    return m_pool != nullptr;
+}
+
+const PooledFrameType& FrameLease::frame(void) const{
+    return m_pool->frame(m_index);
+}
+
+const cv::Mat& FrameLease::data1(void) const{
+    return frame().data1;
+}
+
+const cv::Mat& FrameLease::data2(void) const{
+    return frame().data2;
+}
+
+const std::vector<PCLType>& FrameLease::cloud(void) const{
+    return frame().cloud;
+}
+
+const PointCloudSoAType& FrameLease::cloudSoA(void) const{
+    return frame().cloudSoA;
+}
+
+std::chrono::microseconds FrameLease::timeStamp(void) const{
+    return isValid() ? frame().timeStamp : std::chrono::microseconds(0);
+}
+
+uint64_t FrameLease::sequence(void) const{
+    return isValid() ? frame().sequence : 0;
+}
+
+void FrameLease::release(void){
+    if(!m_pool)
+        return;
+    m_pool->release(m_index);
+    m_pool = nullptr;
+    m_index = -1;
+}
+
+FramePool::FramePool(int size){
+    m_waiters.store(0);
+    m_size = size < 2 ? 2 : size;
+    m_slots = new SlotType[m_size];
+    for(int i = 0; i < m_size; i++)
+        m_slots[i].refCount.store(0);
+}
+
+FramePool::~FramePool(){
+    delete [] m_slots;
+}
+
+int FramePool::size(void) const{
+    return m_size;
+}
+
+int FramePool::freeCount(void) const{
+    int count = 0;
+    for(int i = 0; i < m_size; i++)
+        if(m_slots[i].refCount.load(std::memory_order_relaxed) == 0)
+            count++;
+    return count;
+}
+
+PooledFrameType* FramePool::acquire(int &index){
+    for(int n = 0; n < m_size; n++){
+        int i = (m_cursor + n) % m_size;
+        int expected = 0;
+        if(m_slots[i].refCount.compare_exchange_strong(expected, -1, std::memory_order_acquire)){
+            m_cursor = (i + 1) % m_size;
+            index = i;
+            return &m_slots[i].frame;
+        }
+    }
+    index = -1;
+    return nullptr;
+}
+
+FrameLease FramePool::commit(int index){
+    m_slots[index].refCount.store(1, std::memory_order_release);
+    return FrameLease(this, index);
+}
+
+void FramePool::discard(int index){
+    m_slots[index].refCount.store(0, std::memory_order_release);
+}
+
+bool FramePool::waitFree(std::chrono::microseconds timeout){
+    std::unique_lock<std::mutex> lock(m_freeLock);
+    // announce the waiter before checking, release() either sees it or its buffer is seen free here
+    m_waiters.fetch_add(1, std::memory_order_seq_cst);
+    bool isFree = m_freeSignal.wait_for(lock, timeout, [this]{ return hasFree(); });
+    m_waiters.fetch_sub(1, std::memory_order_relaxed);
+    return isFree;
+}
+
+bool FramePool::tryLease(int index, uint64_t sequence, FrameLease &lease){
+    if(index < 0 || index >= m_size)
+        return false;
+    std::atomic<int> &refCount = m_slots[index].refCount;
+    int count = refCount.load(std::memory_order_relaxed);
+    do{
+        if(count <= 0)
+            return false;
+    }while(!refCount.compare_exchange_weak(count, count + 1, std::memory_order_acquire, std::memory_order_relaxed));
+
+    FrameLease frame(this, index);
+    if(m_slots[index].frame.sequence != sequence)
+        return false;
+    lease = std::move(frame);
+    return true;
+}
+
+void FramePool::retain(int index){
+    m_slots[index].refCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FramePool::release(int index){
+    if(m_slots[index].refCount.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+       m_waiters.load(std::memory_order_seq_cst) > 0){
+        std::lock_guard<std::mutex> lock(m_freeLock);
+        m_freeSignal.notify_all();
+    }
+}
+
+bool FramePool::hasFree(void) const{
+    for(int i = 0; i < m_size; i++)
+        if(m_slots[i].refCount.load(std::memory_order_seq_cst) == 0)
+            return true;
+    return false;
+}
+
+const PooledFrameType& FramePool::frame(int index) const{
+    return m_slots[index].frame;
+}
@@ -0,0 +1,138 @@
+/**
+  * @file HostStereoCamera.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement the base of stereo cameras rectified on the host.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "HostStereoCamera.hpp"
+
+const cv::Size HostStereoCamera::CALIB_SIZE(928, 800);
+
+static const char *CALIB_KEYS[] = {"Intrinsic", "Distortion", "Xi", "Rotation", "Translation", "Kfe"};
+
+HostStereoCamera::HostStereoCamera(std::string logName) : StereoCamera(){
+    m_log = new SystemLog(logName);
+    m_log->setLogLevel(1);
+}
+
+HostStereoCamera::~HostStereoCamera(){
+    delete m_log;
+}
+
+bool HostStereoCamera::getRectStereoFrame(cv::Mat &left, cv::Mat &right){
+    cv::Mat frame;
+    std::chrono::microseconds timeStamp;
+    if(!getRawFrame(frame, timeStamp))
+        return false;
+    return rectifyFrame(frame, left, right);
+}
+
+bool HostStereoCamera::getRectStereoFrame(cv::Mat &left, cv::Mat &right, cv::Mat &feim){
+    m_log->runTimeWarning("Camera has no feim output!");
+    return false;
+}
+
+bool HostStereoCamera::getRectStereoFrame(cv::Mat &left, cv::Mat &right, cv::Mat &feim,
+                                          std::chrono::microseconds &timeStamp){
+    m_log->runTimeWarning("Camera has no feim output!");
+    return false;
+}
+
+bool HostStereoCamera::getCalibParams(std::vector<cv::Mat> &paramsArray, bool flag){
+    std::lock_guard<std::mutex> lock(m_rectLock);
+    const std::vector<cv::Mat> &params = flag ? m_rightParams : m_leftParams;
+    if(params.empty())
+        return false;
+    paramsArray.clear();
+    for(const cv::Mat &param : params)
+        paramsArray.push_back(param.clone());
+    return true;
+}
+
+bool HostStereoCamera::setCalibParams(std::vector<cv::Mat> paramsArray, bool flag){
+    if(paramsArray.size() < 6)
+        return false;
+    std::lock_guard<std::mutex> lock(m_rectLock);
+    (flag ? m_rightParams : m_leftParams) = paramsArray;
+    m_isRectInit = false;
+    return true;
+}
+
+bool HostStereoCamera::loadCalibParams(std::string fileName){
+    std::vector<cv::Mat> leftParams, rightParams;
+    if(!importCalibParams(fileName, leftParams, rightParams)){
+        m_log->runTimeError("Read calibration file %s failed!", fileName.c_str());
+        return false;
+    }
+    return setCalibParams(leftParams, false) && setCalibParams(rightParams, true);
+}
+
+bool HostStereoCamera::saveCalibParams(std::string fileName){
+    return exportCalibParams(*this, fileName);
+}
+
+bool HostStereoCamera::setRectParams(cv::Size rectSize, int mode, double hFov){
+    if(rectSize.width <= 0 || rectSize.height <= 0 || (mode != RECTIFY_LONGLAT && mode != RECTIFY_PERSPECTIVE) ||
+       !(hFov > 0 && hFov < 180)){
+        m_log->runTimeError("Invalid rectify parameters, size %dx%d, mode %d, hFov %.1f!", rectSize.width,
+                            rectSize.height, mode, hFov);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_rectLock);
+    m_rectSize = rectSize;
+    m_rectMode = mode;
+    m_hFov = hFov;
+    m_isRectInit = false;
+    return true;
+}
+
+bool HostStereoCamera::rectifyFrame(const cv::Mat &frame, cv::Mat &left, cv::Mat &right){
+    if(frame.empty())
+        return false;
+    std::lock_guard<std::mutex> lock(m_rectLock);
+    cv::Size rawSize(frame.cols / 2, frame.rows);
+    if(!m_isRectInit || rawSize != m_rectRawSize){
+        if(!m_rectifier.init(m_leftParams, m_rightParams, CALIB_SIZE, rawSize, m_rectSize, m_rectMode, m_hFov)){
+            m_log->runTimeError("No calibration parameters to rectify with, load them first!");
+            return false;
+        }
+        m_rectRawSize = rawSize;
+        m_isRectInit = true;
+    }
+    return m_rectifier.rectify(frame, left, right);
+}
+
+bool HostStereoCamera::exportCalibParams(StereoCamera &camera, std::string fileName){
+    std::vector<cv::Mat> params[2];
+    if(!camera.getCalibParams(params[0], false) || !camera.getCalibParams(params[1], true))
+        return false;
+    cv::FileStorage fs(fileName, cv::FileStorage::WRITE);
+    if(!fs.isOpened())
+        return false;
+    const char *sides[] = {"Left", "Right"};
+    for(int i = 0; i < 2; i++)
+        for(size_t j = 0; j < params[i].size() && j < 6; j++)
+            fs << std::string(sides[i]) + CALIB_KEYS[j] << params[i][j];
+    return true;
+}
+
+bool HostStereoCamera::importCalibParams(std::string fileName, std::vector<cv::Mat> &leftParams,
+                                         std::vector<cv::Mat> &rightParams){
+    cv::FileStorage fs(fileName, cv::FileStorage::READ);
+    if(!fs.isOpened())
+        return false;
+    std::vector<cv::Mat> *params[] = {&leftParams, &rightParams};
+    const char *sides[] = {"Left", "Right"};
+    for(int i = 0; i < 2; i++){
+        params[i]->clear();
+        for(const char *key : CALIB_KEYS){
+            cv::Mat param;
+            fs[std::string(sides[i]) + key] >> param;
+            params[i]->push_back(param);
+        }
+    }
+    return !leftParams[0].empty() && !rightParams[0].empty();
+}
@@ -0,0 +1,144 @@
+/**
+  * @file PointCloudFilter.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement point cloud downsampling and outlier filter APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "PointCloudFilter.hpp"
+
+PointCloudFilter::PointCloudFilter(void){
+}
+
+PointCloudFilter::~PointCloudFilter(){
+}
+
+bool PointCloudFilter::setParams(float voxelSize, float radius, int minNeighbors){
+    if(!isValidParams(voxelSize, radius, minNeighbors))
+        return false;
+    m_voxelSize = voxelSize;
+    m_radius = radius;
+    m_minNeighbors = minNeighbors;
+    if(voxelSize > 0)
+        m_voxelGrid.setVoxelSize(voxelSize);
+    if(radius > 0)
+        m_radiusGrid.setVoxelSize(radius);
+    return true;
+}
+
+bool PointCloudFilter::isValidParams(float voxelSize, float radius, int minNeighbors){
+    return voxelSize >= 0 && radius >= 0 && minNeighbors >= 1;
+}
+
+bool PointCloudFilter::isEnabled(void) const{
+    return m_voxelSize > 0 || m_radius > 0;
+}
+
+void PointCloudFilter::apply(PointCloudSoAType &cloud){
+    if(m_voxelSize > 0){
+        m_voxelGrid.clear();
+        m_voxelGrid.insert(cloud);
+        m_voxelGrid.extract(cloud);
+    }
+    if(m_radius > 0)
+        removeOutliers(cloud);
+}
+
+void PointCloudFilter::apply(std::vector<PCLType> &cloud){
+    if(!isEnabled())
+        return;
+    if(m_voxelSize > 0){
+        m_voxelGrid.clear();
+        m_voxelGrid.insert(cloud);
+        m_voxelGrid.extract(m_scratch);
+    }
+    else{
+        m_scratch.reserve(cloud.size());
+        for(size_t i = 0; i < cloud.size(); i++){
+            m_scratch.x[i] = cloud[i].pts[0];
+            m_scratch.y[i] = cloud[i].pts[1];
+            m_scratch.z[i] = cloud[i].pts[2];
+            m_scratch.color[i] = PointCloudSoAType::packColor(cloud[i].clr[0], cloud[i].clr[1], cloud[i].clr[2]);
+        }
+        m_scratch.count = cloud.size();
+    }
+    if(m_radius > 0)
+        removeOutliers(m_scratch);
+
+    cloud.resize(m_scratch.count);
+    for(size_t i = 0; i < m_scratch.count; i++){
+        uint32_t c = m_scratch.color[i];
+        cloud[i].pts = cv::Vec3f(m_scratch.x[i], m_scratch.y[i], m_scratch.z[i]);
+        cloud[i].clr = cv::Vec3b(c & 0xff, (c >> 8) & 0xff, (c >> 16) & 0xff);
+    }
+}
+
+void PointCloudFilter::removeOutliers(PointCloudSoAType &cloud){
+    size_t count = cloud.count;
+    if(count == 0)
+        return;
+    if(m_voxels.size() < count){
+        m_voxels.resize(count);
+        m_order.resize(count);
+    }
+    m_radiusGrid.clear();
+    m_radiusGrid.insert(cloud.x.data(), cloud.y.data(), cloud.z.data(), nullptr, count, m_voxels.data());
+
+    // counting sort of the points by cell, cell v holds m_order[m_starts[v]] to m_order[m_starts[v + 1] - 1]
+    size_t cells = m_radiusGrid.size();
+    if(m_starts.size() < cells + 1)
+        m_starts.resize(cells + 1);
+    uint32_t start = 0;
+    for(size_t v = 0; v < cells; v++){
+        m_starts[v] = start;
+        start += m_radiusGrid.pointCount((uint32_t)v);
+    }
+    m_starts[cells] = start;
+    for(size_t i = 0; i < count; i++)
+        if(m_voxels[i] != VOXEL_NONE)
+            m_order[m_starts[m_voxels[i]]++] = (uint32_t)i;
+    // the fill moved every start to the next cell
+    for(size_t v = cells; v > 0; v--)
+        m_starts[v] = m_starts[v - 1];
+    m_starts[0] = 0;
+
+    // outliers are marked first, their neighbors still count them
+    float radius2 = m_radius * m_radius;
+    for(size_t i = 0; i < count; i++){
+        uint32_t voxel = m_voxels[i];
+        if(voxel == VOXEL_NONE)
+            continue;
+        float x = cloud.x[i], y = cloud.y[i], z = cloud.z[i];
+        // the point itself is found as a neighbor too
+        int found = -1;
+        // own cell first, most points have enough neighbors there
+        for(int n = 0; n < 27 && found < m_minNeighbors; n++){
+            int d = (n + 13) % 27;
+            uint32_t cell = m_radiusGrid.neighbor(voxel, d % 3 - 1, d / 3 % 3 - 1, d / 9 - 1);
+            if(cell == VOXEL_NONE)
+                continue;
+            for(uint32_t k = m_starts[cell]; k < m_starts[cell + 1] && found < m_minNeighbors; k++){
+                uint32_t j = m_order[k];
+                float dx = cloud.x[j] - x, dy = cloud.y[j] - y, dz = cloud.z[j] - z;
+                if(dx * dx + dy * dy + dz * dz <= radius2)
+                    found++;
+            }
+        }
+        if(found < m_minNeighbors)
+            m_voxels[i] = VOXEL_NONE;
+    }
+
+    size_t kept = 0;
+    for(size_t i = 0; i < count; i++){
+        if(m_voxels[i] == VOXEL_NONE)
+            continue;
+        cloud.x[kept] = cloud.x[i];
+        cloud.y[kept] = cloud.y[i];
+        cloud.z[kept] = cloud.z[i];
+        cloud.color[kept] = cloud.color[i];
+        kept++;
+    }
+    cloud.count = kept;
+}
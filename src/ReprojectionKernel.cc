@@ -0,0 +1,278 @@
+/**
+  * @file ReprojectionKernel.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement the row kernel of disparity reprojection.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "ReprojectionKernel.hpp"
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define REPROJECT_AVX2
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define REPROJECT_SSE2
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#include <arm_neon.h>
+#define REPROJECT_NEON
+#endif
+
+/**
+  * @struct RowTransform
+  * @brief transform of one row, a point with ray terms a = colA * r and s = colS * r moves to
+  * (ax * a + bx * s + tx, ay * a + by * s + ty, az * a + bz * s + tz)
+  */
+typedef struct RowTransform{
+    float ax, ay, az;
+    float bx, by, bz;
+    float tx, ty, tz;
+}RowTransformType;
+
+static inline RowTransformType rowTransform(const ReprojectRowArgsType &args){
+    const float *m = args.transform;
+    RowTransformType row;
+    row.ax = m[0];
+    row.ay = m[4];
+    row.az = m[8];
+    row.bx = m[1] * args.rowP + m[2] * args.rowR;
+    row.by = m[5] * args.rowP + m[6] * args.rowR;
+    row.bz = m[9] * args.rowP + m[10] * args.rowR;
+    row.tx = m[3];
+    row.ty = m[7];
+    row.tz = m[11];
+    return row;
+}
+
+static inline int reprojectPixels(const ReprojectRowArgsType &args, int start, int count, float *depth,
+                                  float *x, float *y, float *z, int *index){
+    RowTransformType row = {};
+    if(args.transform)
+        row = rowTransform(args);
+    for(int u = start; u < args.width; u++){
+        int d = args.disparity[u];
+        float r = 0;
+        bool isValid = false;
+        if(d > 0 && d < args.lutSize){
+            r = args.colS[u] * args.lut[d] - args.colC[u];
+            isValid = r >= args.minDepth && r <= args.maxDepth;
+        }
+        if(depth)
+            depth[u] = isValid ? r : 0.f;
+        if(!isValid)
+            continue;
+
+        float a = args.colA[u] * r, s = args.colS[u] * r;
+        if(args.transform){
+            x[count] = row.ax * a + row.bx * s + row.tx;
+            y[count] = row.ay * a + row.by * s + row.ty;
+            z[count] = row.az * a + row.bz * s + row.tz;
+        }
+        else{
+            x[count] = a;
+            y[count] = s * args.rowP;
+            z[count] = s * args.rowR;
+        }
+        index[count] = u;
+        count++;
+    }
+    return count;
+}
+
+int reprojectRowScalar(const ReprojectRowArgsType &args, float *depth, float *x, float *y, float *z, int *index){
+    return reprojectPixels(args, 0, 0, depth, x, y, z, index);
+}
+
+#if defined(REPROJECT_AVX2)
+
+// lane permutation moving the set lanes of an 8 bit mask to the front
+static const int32_t* compactTable(void){
+    static struct Table{
+        int32_t lanes[256][8];
+        Table(void){
+            for(int mask = 0; mask < 256; mask++){
+                int count = 0;
+                for(int lane = 0; lane < 8; lane++)
+                    if(mask & (1 << lane))
+                        lanes[mask][count++] = lane;
+                while(count < 8)
+                    lanes[mask][count++] = 0;
+            }
+        }
+    }table;
+    return &table.lanes[0][0];
+}
+
+int reprojectRow(const ReprojectRowArgsType &args, float *depth, float *x, float *y, float *z, int *index){
+    const int32_t *table = compactTable();
+    const __m256i zero = _mm256_setzero_si256(), lutSize = _mm256_set1_epi32(args.lutSize);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256 minDepth = _mm256_set1_ps(args.minDepth), maxDepth = _mm256_set1_ps(args.maxDepth);
+    const __m256 rowP = _mm256_set1_ps(args.rowP), rowR = _mm256_set1_ps(args.rowR);
+    RowTransformType row = {};
+    if(args.transform)
+        row = rowTransform(args);
+    const __m256 ax = _mm256_set1_ps(row.ax), ay = _mm256_set1_ps(row.ay), az = _mm256_set1_ps(row.az);
+    const __m256 bx = _mm256_set1_ps(row.bx), by = _mm256_set1_ps(row.by), bz = _mm256_set1_ps(row.bz);
+    const __m256 tx = _mm256_set1_ps(row.tx), ty = _mm256_set1_ps(row.ty), tz = _mm256_set1_ps(row.tz);
+
+    int count = 0, u = 0;
+    for(; u + 8 <= args.width; u += 8){
+        __m256i d = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(args.disparity + u)));
+        __m256i inRange = _mm256_and_si256(_mm256_cmpgt_epi32(d, zero), _mm256_cmpgt_epi32(lutSize, d));
+        __m256 g = _mm256_i32gather_ps(args.lut, _mm256_and_si256(d, inRange), 4);
+
+        __m256 s = _mm256_loadu_ps(args.colS + u);
+        __m256 r = _mm256_sub_ps(_mm256_mul_ps(s, g), _mm256_loadu_ps(args.colC + u));
+        __m256 valid = _mm256_and_ps(_mm256_castsi256_ps(inRange),
+                                     _mm256_and_ps(_mm256_cmp_ps(r, minDepth, _CMP_GE_OQ),
+                                                   _mm256_cmp_ps(r, maxDepth, _CMP_LE_OQ)));
+        if(depth)
+            _mm256_storeu_ps(depth + u, _mm256_and_ps(r, valid));
+
+        int mask = _mm256_movemask_ps(valid);
+        if(!mask)
+            continue;
+        __m256i permute = _mm256_loadu_si256((const __m256i*)(table + mask * 8));
+        __m256 ar = _mm256_mul_ps(_mm256_loadu_ps(args.colA + u), r), sr = _mm256_mul_ps(s, r);
+        __m256 px, py, pz;
+        if(args.transform){
+            px = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, ar), _mm256_mul_ps(bx, sr)), tx);
+            py = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ay, ar), _mm256_mul_ps(by, sr)), ty);
+            pz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(az, ar), _mm256_mul_ps(bz, sr)), tz);
+        }
+        else{
+            px = ar;
+            py = _mm256_mul_ps(sr, rowP);
+            pz = _mm256_mul_ps(sr, rowR);
+        }
+        _mm256_storeu_ps(x + count, _mm256_permutevar8x32_ps(px, permute));
+        _mm256_storeu_ps(y + count, _mm256_permutevar8x32_ps(py, permute));
+        _mm256_storeu_ps(z + count, _mm256_permutevar8x32_ps(pz, permute));
+        _mm256_storeu_si256((__m256i*)(index + count),
+                            _mm256_permutevar8x32_epi32(_mm256_add_epi32(lanes, _mm256_set1_epi32(u)), permute));
+        count += __builtin_popcount(mask);
+    }
+    return reprojectPixels(args, u, count, depth, x, y, z, index);
+}
+
+const char* reprojectKernelName(void){
+    return "avx2";
+}
+
+#elif defined(REPROJECT_SSE2) || defined(REPROJECT_NEON)
+
+int reprojectRow(const ReprojectRowArgsType &args, float *depth, float *x, float *y, float *z, int *index){
+    int count = 0, u = 0;
+    alignas(16) int32_t d[4];
+    alignas(16) float g[4], px[4], py[4], pz[4];
+    RowTransformType row = {};
+    if(args.transform)
+        row = rowTransform(args);
+
+#if defined(REPROJECT_SSE2)
+    const __m128i zero = _mm_setzero_si128(), lutSize = _mm_set1_epi32(args.lutSize);
+    const __m128 minDepth = _mm_set1_ps(args.minDepth), maxDepth = _mm_set1_ps(args.maxDepth);
+    const __m128 rowP = _mm_set1_ps(args.rowP), rowR = _mm_set1_ps(args.rowR);
+    const __m128 ax = _mm_set1_ps(row.ax), ay = _mm_set1_ps(row.ay), az = _mm_set1_ps(row.az);
+    const __m128 bx = _mm_set1_ps(row.bx), by = _mm_set1_ps(row.by), bz = _mm_set1_ps(row.bz);
+    const __m128 tx = _mm_set1_ps(row.tx), ty = _mm_set1_ps(row.ty), tz = _mm_set1_ps(row.tz);
+#else
+    const int32x4_t zero = vdupq_n_s32(0), lutSize = vdupq_n_s32(args.lutSize);
+    const float32x4_t minDepth = vdupq_n_f32(args.minDepth), maxDepth = vdupq_n_f32(args.maxDepth);
+#endif
+
+    for(; u + 4 <= args.width; u += 4){
+        int mask;
+#if defined(REPROJECT_SSE2)
+        __m128i raw = _mm_loadl_epi64((const __m128i*)(args.disparity + u));
+        __m128i disp = _mm_srai_epi32(_mm_unpacklo_epi16(raw, raw), 16);
+        __m128i inRange = _mm_and_si128(_mm_cmpgt_epi32(disp, zero), _mm_cmpgt_epi32(lutSize, disp));
+        _mm_store_si128((__m128i*)d, _mm_and_si128(disp, inRange));
+        for(int i = 0; i < 4; i++)
+            g[i] = args.lut[d[i]];
+
+        __m128 s = _mm_loadu_ps(args.colS + u);
+        __m128 r = _mm_sub_ps(_mm_mul_ps(s, _mm_load_ps(g)), _mm_loadu_ps(args.colC + u));
+        __m128 valid = _mm_and_ps(_mm_castsi128_ps(inRange),
+                                  _mm_and_ps(_mm_cmpge_ps(r, minDepth), _mm_cmple_ps(r, maxDepth)));
+        if(depth)
+            _mm_storeu_ps(depth + u, _mm_and_ps(r, valid));
+        mask = _mm_movemask_ps(valid);
+        if(!mask)
+            continue;
+        __m128 ar = _mm_mul_ps(_mm_loadu_ps(args.colA + u), r), sr = _mm_mul_ps(s, r);
+        if(args.transform){
+            _mm_store_ps(px, _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, ar), _mm_mul_ps(bx, sr)), tx));
+            _mm_store_ps(py, _mm_add_ps(_mm_add_ps(_mm_mul_ps(ay, ar), _mm_mul_ps(by, sr)), ty));
+            _mm_store_ps(pz, _mm_add_ps(_mm_add_ps(_mm_mul_ps(az, ar), _mm_mul_ps(bz, sr)), tz));
+        }
+        else{
+            _mm_store_ps(px, ar);
+            _mm_store_ps(py, _mm_mul_ps(sr, rowP));
+            _mm_store_ps(pz, _mm_mul_ps(sr, rowR));
+        }
+#else
+        int32x4_t disp = vmovl_s16(vld1_s16(args.disparity + u));
+        uint32x4_t inRange = vandq_u32(vcgtq_s32(disp, zero), vcltq_s32(disp, lutSize));
+        vst1q_s32(d, vandq_s32(disp, vreinterpretq_s32_u32(inRange)));
+        for(int i = 0; i < 4; i++)
+            g[i] = args.lut[d[i]];
+
+        float32x4_t s = vld1q_f32(args.colS + u);
+        float32x4_t r = vsubq_f32(vmulq_f32(s, vld1q_f32(g)), vld1q_f32(args.colC + u));
+        uint32x4_t valid = vandq_u32(inRange, vandq_u32(vcgeq_f32(r, minDepth), vcleq_f32(r, maxDepth)));
+        if(depth)
+            vst1q_f32(depth + u, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(r), valid)));
+        alignas(16) uint32_t lanes[4];
+        vst1q_u32(lanes, valid);
+        mask = (lanes[0] & 1) | (lanes[1] & 2) | (lanes[2] & 4) | (lanes[3] & 8);
+        if(!mask)
+            continue;
+        float32x4_t ar = vmulq_f32(vld1q_f32(args.colA + u), r), sr = vmulq_f32(s, r);
+        if(args.transform){
+            vst1q_f32(px, vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(row.tx), ar, row.ax), sr, row.bx));
+            vst1q_f32(py, vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(row.ty), ar, row.ay), sr, row.by));
+            vst1q_f32(pz, vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(row.tz), ar, row.az), sr, row.bz));
+        }
+        else{
+            vst1q_f32(px, ar);
+            vst1q_f32(py, vmulq_n_f32(sr, args.rowP));
+            vst1q_f32(pz, vmulq_n_f32(sr, args.rowR));
+        }
+#endif
+        for(int i = 0; i < 4; i++){
+            if(!(mask & (1 << i)))
+                continue;
+            x[count] = px[i];
+            y[count] = py[i];
+            z[count] = pz[i];
+            index[count] = u + i;
+            count++;
+        }
+    }
+    return reprojectPixels(args, u, count, depth, x, y, z, index);
+}
+
+const char* reprojectKernelName(void){
+#if defined(REPROJECT_SSE2)
+    return "sse2";
+#else
+    return "neon";
+#endif
+}
+
+#else
+
+int reprojectRow(const ReprojectRowArgsType &args, float *depth, float *x, float *y, float *z, int *index){
+    return reprojectRowScalar(args, depth, x, y, z, index);
+}
+
+const char* reprojectKernelName(void){
+    return "scalar";
+}
+
+#endif
@@ -0,0 +1,95 @@
+/**
+  * @file ShmFramePublisher.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement the shared memory frame publisher APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "ShmFramePublisher.hpp"
+
+ShmFramePublisher::ShmFramePublisher(void){
+    m_log = new SystemLog(m_logName);
+    m_log->setLogLevel(1);
+}
+
+ShmFramePublisher::~ShmFramePublisher(){
+    stopPublish();
+    delete m_log;
+}
+
+bool ShmFramePublisher::startPublish(int posNumber, StereoFrameGrabber *grabber, StereoPipeline *pipeline,
+                                     int streams, int slotCount, CallbackExecutor *executor){
+    if(m_grabber){
+        m_log->runTimeWarning("Publisher is running, stop it before starting again!");
+        return false;
+    }
+    if(!grabber || (streams & 0x07) == 0){
+        m_log->runTimeError("Nothing to publish for camera %d!", posNumber);
+        return false;
+    }
+    m_posNumber = posNumber;
+    m_grabber = grabber;
+    m_pipeline = pipeline;
+
+    // depth frames of the grabber are the gray depth frames of the camera
+    const int grabProducts[] = {GRAB_RAW_FRAME, GRAB_RECT_FRAME, GRAB_DEPTH_FRAME};
+    const int pipelineProducts[] = {GRAB_RAW_FRAME, PIPELINE_RECT_FRAME, PIPELINE_DEPTH_FRAME};
+    for(int stream = SHM_STREAM_RAW; stream <= SHM_STREAM_DEPTH; stream++){
+        if(!(streams & (1 << stream)))
+            continue;
+        ShmPublishStreamType &target = m_streams[stream];
+        if(!target.writer.open(posNumber, stream, slotCount)){
+            stopPublish();
+            return false;
+        }
+        target.isPipeline = pipeline && stream != SHM_STREAM_RAW;
+        target.product = target.isPipeline ? pipelineProducts[stream] : grabProducts[stream];
+        FrameChannel::FrameCallbackType callback = [this, stream](const FrameLease &lease){
+            publish(stream, lease);
+        };
+        target.callback = target.isPipeline ? pipeline->registerCallback(target.product, callback, executor) :
+                                              grabber->registerCallback(target.product, callback, executor);
+        if(target.callback < 0){
+            stopPublish();
+            return false;
+        }
+    }
+    m_log->runTimeInfo("Start publishing frames of camera %d ...", posNumber);
+    return true;
+}
+
+void ShmFramePublisher::stopPublish(void){
+    if(!m_grabber)
+        return;
+    for(ShmPublishStreamType &target : m_streams){
+        // removeCallback() waits for a running callback, nothing is written after this
+        if(target.callback >= 0){
+            if(target.isPipeline)
+                m_pipeline->unregisterCallback(target.product, target.callback);
+            else
+                m_grabber->unregisterCallback(target.product, target.callback);
+            target.callback = -1;
+        }
+        std::lock_guard<std::mutex> lock(target.lock);
+        target.writer.close();
+    }
+    m_grabber = nullptr;
+    m_pipeline = nullptr;
+    m_log->runTimeInfo("Stop publishing frames of camera %d.", m_posNumber);
+}
+
+uint64_t ShmFramePublisher::getSequence(int stream){
+    if(stream < SHM_STREAM_RAW || stream > SHM_STREAM_DEPTH)
+        return 0;
+    std::lock_guard<std::mutex> lock(m_streams[stream].lock);
+    return m_streams[stream].writer.getSequence();
+}
+
+void ShmFramePublisher::publish(int stream, const FrameLease &lease){
+    ShmPublishStreamType &target = m_streams[stream];
+    std::lock_guard<std::mutex> lock(target.lock);
+    // the writer logs failed segment creation itself, frames are not queued for a retry
+    target.writer.write(lease.data1(), lease.data2(), lease.timeStamp());
+}
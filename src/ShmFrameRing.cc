@@ -0,0 +1,347 @@
+/**
+  * @file ShmFrameRing.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement the shared memory frame ring APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "ShmFrameRing.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <thread>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+static_assert(sizeof(std::atomic<uint32_t>) == 4 && sizeof(std::atomic<uint64_t>) == 8,
+              "ring atomics must have the size of their plain type");
+
+// every offset and size of the ring is a multiple of 64 bytes
+static inline uint64_t alignSize(uint64_t size){
+    return (size + 63) & ~(uint64_t)63;
+}
+
+static inline uint64_t imageBytes(const cv::Mat &image){
+    return image.empty() ? 0 : alignSize((uint64_t)image.cols * image.elemSize() * image.rows);
+}
+
+// futex word shared between processes, no FUTEX_PRIVATE_FLAG
+static void futexWait(const std::atomic<uint32_t> *word, uint32_t value, std::chrono::microseconds timeout){
+    struct timespec ts;
+    ts.tv_sec = timeout.count() / 1000000;
+    ts.tv_nsec = (timeout.count() % 1000000) * 1000;
+    syscall(SYS_futex, (const uint32_t*)word, FUTEX_WAIT, value, &ts, nullptr, 0);
+}
+
+static void futexWake(std::atomic<uint32_t> *word){
+    syscall(SYS_futex, (uint32_t*)word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+int shmRingKey(int posNumber, int stream){
+    return SHM_RING_KEY_BASE + 10 * posNumber + stream;
+}
+
+ShmFrameWriter::ShmFrameWriter(void){
+    m_log = new SystemLog(m_logName);
+    m_log->setLogLevel(1);
+}
+
+ShmFrameWriter::~ShmFrameWriter(){
+    close();
+    delete m_log;
+}
+
+bool ShmFrameWriter::open(int posNumber, int stream, int slotCount){
+    if(posNumber < 1 || posNumber > 9 || stream < SHM_STREAM_RAW || stream > SHM_STREAM_DEPTH || slotCount < 2){
+        m_log->runTimeError("Invalid ring of camera %d, stream %d, %d slots!", posNumber, stream, slotCount);
+        return false;
+    }
+    close();
+    m_posNumber = posNumber;
+    m_stream = stream;
+    m_slotCount = slotCount;
+    m_retryTime = std::chrono::steady_clock::time_point();
+    return true;
+}
+
+bool ShmFrameWriter::removeStale(int shmId, int key){
+    struct shmid_ds info;
+    void *memory = (void*)-1;
+    if(shmctl(shmId, IPC_STAT, &info) == 0 && info.shm_segsz >= sizeof(ShmRingHeaderType))
+        memory = shmat(shmId, nullptr, 0);
+    if(memory == (void*)-1){
+        m_log->runTimeError("Share memory %d is in use by something else than a frame ring!", key);
+        return false;
+    }
+    ShmRingHeaderType *header = (ShmRingHeaderType*)memory;
+    if(header->magic != SHM_RING_MAGIC || header->version != SHM_RING_VERSION){
+        m_log->runTimeError("Share memory %d is in use by something else than a version %d frame ring!", key,
+                            SHM_RING_VERSION);
+        shmdt(memory);
+        return false;
+    }
+    // a live writer of another process or of this one keeps its ring, EPERM means the process exists too
+    int writerPid = header->writerPid;
+    if(writerPid <= 0 || !(kill(writerPid, 0) != 0 && errno == ESRCH)){
+        m_log->runTimeError("Frame ring %d is written by process %d already!", key, writerPid);
+        shmdt(memory);
+        return false;
+    }
+    header->isOpen.store(0, std::memory_order_release);
+    header->notify.fetch_add(1, std::memory_order_release);
+    futexWake(&header->notify);
+    shmdt(memory);
+    shmctl(shmId, IPC_RMID, nullptr);
+    m_log->runTimeWarning("Removed frame ring %d left by process %d.", key, writerPid);
+    return true;
+}
+
+bool ShmFrameWriter::create(uint64_t slotSize){
+    close();
+    key_t key = shmRingKey(m_posNumber, m_stream);
+
+    // only a ring left by a writer that died is replaced, its readers are told to move on
+    int staleId = shmget(key, 0, 0);
+    if(staleId >= 0 && !removeStale(staleId, key))
+        return false;
+
+    size_t size = sizeof(ShmRingHeaderType) + (size_t)slotSize * m_slotCount;
+    m_shmId = shmget(key, size, IPC_CREAT | IPC_EXCL | 0666);
+    if(m_shmId < 0){
+        m_log->runTimeError("Create share memory %d of %zu bytes failed: %s", key, size, strerror(errno));
+        return false;
+    }
+    void *memory = shmat(m_shmId, nullptr, 0);
+    if(memory == (void*)-1){
+        m_log->runTimeError("Attach share memory %d failed: %s", key, strerror(errno));
+        shmctl(m_shmId, IPC_RMID, nullptr);
+        m_shmId = -1;
+        return false;
+    }
+
+    // new segments are zero filled, every slot state is 0 and no frame is complete
+    m_header = (ShmRingHeaderType*)memory;
+    m_header->version = SHM_RING_VERSION;
+    m_header->headerSize = sizeof(ShmRingHeaderType);
+    m_header->slotCount = m_slotCount;
+    m_header->slotSize = slotSize;
+    m_header->posNumber = m_posNumber;
+    m_header->stream = m_stream;
+    m_header->writerPid = getpid();
+    m_header->isOpen.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_header->magic = SHM_RING_MAGIC;
+    m_log->runTimeInfo("Share frames of camera %d stream %d at key %d, %d slots of %llu bytes.", m_posNumber, m_stream,
+                       key, m_slotCount, (unsigned long long)slotSize);
+    return true;
+}
+
+bool ShmFrameWriter::write(const cv::Mat &image0, const cv::Mat &image1, std::chrono::microseconds timeStamp){
+    if(m_posNumber == 0 || image0.empty())
+        return false;
+    uint64_t size0 = imageBytes(image0), size1 = imageBytes(image1);
+    uint64_t slotSize = sizeof(ShmSlotHeaderType) + size0 + size1;
+    if(!m_header || m_header->slotSize < slotSize){
+        // a refused key is tried again once a second, not at every frame
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if(now < m_retryTime)
+            return false;
+        if(!create(slotSize)){
+            m_retryTime = now + std::chrono::seconds(1);
+            return false;
+        }
+    }
+
+    uint64_t sequence = ++m_sequence;
+    uint8_t *base = (uint8_t*)m_header + m_header->headerSize + (sequence % m_header->slotCount) * m_header->slotSize;
+    ShmSlotHeaderType *slot = (ShmSlotHeaderType*)base;
+    slot->state.store(sequence * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const cv::Mat *images[2] = {&image0, &image1};
+    uint64_t offset = sizeof(ShmSlotHeaderType);
+    for(int i = 0; i < 2; i++){
+        const cv::Mat &image = *images[i];
+        ShmImageInfoType &info = slot->images[i];
+        info.rows = image.rows;
+        info.cols = image.cols;
+        info.type = image.type();
+        info.step = (uint32_t)(image.cols * image.elemSize());
+        info.offset = offset;
+        if(image.empty())
+            continue;
+        if(image.isContinuous()){
+            memcpy(base + offset, image.data, (size_t)info.step * image.rows);
+        }
+        else{
+            for(int row = 0; row < image.rows; row++)
+                memcpy(base + offset + (size_t)row * info.step, image.ptr(row), info.step);
+        }
+        offset += imageBytes(image);
+    }
+    slot->sequence = sequence;
+    slot->timeStamp = timeStamp.count();
+
+    slot->state.store(sequence * 2, std::memory_order_release);
+    m_header->latest.store(sequence, std::memory_order_release);
+    m_header->notify.fetch_add(1, std::memory_order_release);
+    futexWake(&m_header->notify);
+    return true;
+}
+
+void ShmFrameWriter::close(void){
+    if(!m_header)
+        return;
+    m_header->isOpen.store(0, std::memory_order_release);
+    m_header->notify.fetch_add(1, std::memory_order_release);
+    futexWake(&m_header->notify);
+    shmdt(m_header);
+    shmctl(m_shmId, IPC_RMID, nullptr);
+    m_header = nullptr;
+    m_shmId = -1;
+}
+
+uint64_t ShmFrameWriter::getSequence(void) const{
+    return m_sequence;
+}
+
+ShmFrameReader::ShmFrameReader(void){
+    m_log = new SystemLog(m_logName);
+    m_log->setLogLevel(1);
+}
+
+ShmFrameReader::~ShmFrameReader(){
+    close();
+    delete m_log;
+}
+
+bool ShmFrameReader::open(int posNumber, int stream){
+    close();
+    m_posNumber = posNumber;
+    m_stream = stream;
+    return attach();
+}
+
+void ShmFrameReader::close(void){
+    if(!m_header)
+        return;
+    shmdt(m_header);
+    m_header = nullptr;
+}
+
+bool ShmFrameReader::isOpened(void) const{
+    return m_header && m_header->isOpen.load(std::memory_order_acquire);
+}
+
+bool ShmFrameReader::attach(void){
+    close();
+    int shmId = shmget(shmRingKey(m_posNumber, m_stream), 0, 0);
+    if(shmId < 0)
+        return false;
+    // read only, a reader can never corrupt frames of other readers
+    void *memory = shmat(shmId, nullptr, SHM_RDONLY);
+    if(memory == (void*)-1){
+        m_log->runTimeError("Attach share memory of camera %d stream %d failed: %s", m_posNumber, m_stream,
+                            strerror(errno));
+        return false;
+    }
+    const ShmRingHeaderType *header = (const ShmRingHeaderType*)memory;
+    bool isReady = header->magic == SHM_RING_MAGIC;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(!isReady || header->version != SHM_RING_VERSION || !header->isOpen.load(std::memory_order_acquire)){
+        if(isReady && header->version != SHM_RING_VERSION)
+            m_log->runTimeError("Ring protocol version %u of camera %d stream %d is not supported!",
+                                header->version, m_posNumber, m_stream);
+        shmdt(memory);
+        return false;
+    }
+    m_header = header;
+    m_ringId++;
+    return true;
+}
+
+const ShmSlotHeaderType* ShmFrameReader::slotHeader(uint64_t sequence) const{
+    const uint8_t *base = (const uint8_t*)m_header + m_header->headerSize;
+    return (const ShmSlotHeaderType*)(base + (sequence % m_header->slotCount) * m_header->slotSize);
+}
+
+bool ShmFrameReader::readSlot(uint64_t sequence, ShmFrameType &frame) const{
+    const ShmSlotHeaderType *slot = slotHeader(sequence);
+    uint64_t state = slot->state.load(std::memory_order_acquire);
+    if(state != sequence * 2)
+        return false;
+
+    ShmImageInfoType infos[2] = {slot->images[0], slot->images[1]};
+    int64_t timeStamp = slot->timeStamp;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(slot->state.load(std::memory_order_relaxed) != state)
+        return false;
+
+    cv::Mat *images[2] = {&frame.data1, &frame.data2};
+    for(int i = 0; i < 2; i++){
+        const ShmImageInfoType &info = infos[i];
+        if(info.rows <= 0 || info.offset + (uint64_t)info.rows * info.step > m_header->slotSize){
+            images[i]->release();
+            continue;
+        }
+        *images[i] = cv::Mat(info.rows, info.cols, info.type, (uint8_t*)slot + info.offset, info.step);
+    }
+    frame.sequence = sequence;
+    frame.timeStamp = std::chrono::microseconds(timeStamp);
+    frame.ringId = m_ringId;
+    return true;
+}
+
+bool ShmFrameReader::waitFrame(ShmFrameType &frame, uint64_t &sequence, std::chrono::microseconds timeout){
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+    uint64_t last = sequence;
+    while(true){
+        if(!isOpened()){
+            if(!attach()){
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                if(now >= deadline)
+                    return false;
+                // no writer yet, look again every 10 milliseconds
+                std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(deadline - now,
+                                                                                           std::chrono::milliseconds(10)));
+                continue;
+            }
+            // a restarted writer counts from 1 again
+            last = 0;
+        }
+
+        uint32_t notify = m_header->notify.load(std::memory_order_acquire);
+        uint64_t latest = m_header->latest.load(std::memory_order_acquire);
+        // a failed read means the writer is rewriting the slot, the next notify brings a newer frame
+        if(latest > last && readSlot(latest, frame)){
+            if(last > 0)
+                m_lostCount += latest - last - 1;
+            sequence = latest;
+            return true;
+        }
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if(now >= deadline)
+            return false;
+        futexWait(&m_header->notify, notify, std::chrono::duration_cast<std::chrono::microseconds>(deadline - now));
+    }
+}
+
+bool ShmFrameReader::isValid(const ShmFrameType &frame) const{
+    if(!m_header || frame.ringId != m_ringId || frame.sequence == 0)
+        return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slotHeader(frame.sequence)->state.load(std::memory_order_relaxed) == frame.sequence * 2;
+}
+
+uint64_t ShmFrameReader::getLostCount(void) const{
+    return m_lostCount;
+}
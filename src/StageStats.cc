@@ -0,0 +1,107 @@
+/**
+  * @file StageStats.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement hot path timing statistics APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "StageStats.hpp"
+#include <algorithm>
+
+static int bucketOf(uint64_t us){
+    if(us < 16)
+        return (int)us;
+    int exponent = 63 - __builtin_clzll(us);
+    int index = 16 + (exponent - 4) * 8 + (int)((us >> (exponent - 3)) & 7);
+    return std::min(index, STATS_BUCKETS - 1);
+}
+
+// middle of a bucket, unit is microsecond
+static double bucketValue(int index){
+    if(index < 16)
+        return index;
+    int exponent = (index - 16) / 8 + 4;
+    double width = (double)(1ull << (exponent - 3));
+    return (8 + (index - 16) % 8) * width + width / 2;
+}
+
+StageStatsRecorder::StageStatsRecorder(void){
+    reset();
+}
+
+StageStatsRecorder::~StageStatsRecorder(){
+}
+
+void StageStatsRecorder::record(std::chrono::microseconds latency){
+    uint64_t us = latency.count() > 0 ? (uint64_t)latency.count() : 0;
+    m_buckets[bucketOf(us)].fetch_add(1, std::memory_order_relaxed);
+    m_processed.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(us, std::memory_order_relaxed);
+    uint64_t max = m_max.load(std::memory_order_relaxed);
+    while(us > max && !m_max.compare_exchange_weak(max, us, std::memory_order_relaxed)){
+    }
+}
+
+void StageStatsRecorder::record(std::chrono::steady_clock::time_point start){
+    record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+}
+
+void StageStatsRecorder::drop(uint64_t count){
+    m_dropped.fetch_add(count, std::memory_order_relaxed);
+}
+
+void StageStatsRecorder::skip(void){
+    m_skipped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StageStatsRecorder::reset(void){
+    for(std::atomic<uint64_t> &bucket : m_buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    m_processed = 0;
+    m_dropped = 0;
+    m_skipped = 0;
+    m_sum = 0;
+    m_max = 0;
+}
+
+void StageStatsRecorder::snapshot(StageStatsType &stats) const{
+    // counters are read one by one while stages keep recording, the snapshot may be off by a frame
+    uint64_t counts[STATS_BUCKETS], total = 0;
+    for(int i = 0; i < STATS_BUCKETS; i++){
+        counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    stats.processed = m_processed.load(std::memory_order_relaxed);
+    stats.dropped = m_dropped.load(std::memory_order_relaxed);
+    stats.skipped = m_skipped.load(std::memory_order_relaxed);
+    stats.max = m_max.load(std::memory_order_relaxed) / 1000.0;
+    stats.mean = total ? m_sum.load(std::memory_order_relaxed) / 1000.0 / total : 0;
+    stats.p50 = stats.p99 = 0;
+
+    uint64_t p50 = (total + 1) / 2, p99 = total - total / 100, seen = 0;
+    bool hasP50 = false;
+    for(int i = 0; i < STATS_BUCKETS && total; i++){
+        seen += counts[i];
+        if(!hasP50 && seen >= p50){
+            stats.p50 = bucketValue(i) / 1000.0;
+            hasP50 = true;
+        }
+        if(seen >= p99){
+            stats.p99 = bucketValue(i) / 1000.0;
+            break;
+        }
+    }
+    stats.p50 = std::min(stats.p50, stats.max);
+    stats.p99 = std::min(stats.p99, stats.max);
+}
+
+void logStageStats(SystemLog *log, const std::vector<StageStatsType> &stats){
+    for(const StageStatsType &stage : stats){
+        log->runTimeInfo("%-10s processed %llu dropped %llu skipped %llu queue %d/%d p50 %.2f p99 %.2f max %.2f ms",
+                         stage.name.c_str(), (unsigned long long)stage.processed, (unsigned long long)stage.dropped,
+                         (unsigned long long)stage.skipped, (int)stage.queueDepth, (int)stage.queueCapacity,
+                         stage.p50, stage.p99, stage.max);
+    }
+}
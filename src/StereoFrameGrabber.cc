@@ -0,0 +1,324 @@
+/**
+  * @file StereoFrameGrabber.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement zero-copy frame handoff APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "StereoFrameGrabber.hpp"
+#include "HostStereoCamera.hpp"
+#include <unistd.h>
+
+StereoFrameGrabber::StereoFrameGrabber(int poolSize) : m_poolSize(poolSize), m_isGrabbing(false), m_statsInterval(0){
+    m_log = new SystemLog(m_logName);
+    m_log->setLogLevel(1);
+}
+
+StereoFrameGrabber::~StereoFrameGrabber(){
+    stopGrab();
+    delete m_log;
+}
+
+bool StereoFrameGrabber::startGrab(StereoCamera *camera, int products){
+    if(m_grabWorker.valid()){
+        m_log->runTimeWarning("Grab threads are already running!");
+        return false;
+    }
+    if(!camera || !camera->isOpened()){
+        m_log->runTimeError("Camera is not opened!");
+        return false;
+    }
+
+    m_camera = camera;
+    m_hostCamera = dynamic_cast<HostStereoCamera*>(camera);
+    m_products = products | GRAB_RAW_FRAME;
+    m_isGrabbing = true;
+    StageStatsRecorder *recorders[] = {&m_rawStats, &m_rectStats, &m_depthStats, &m_cloudStats};
+    for(StageStatsRecorder *recorder : recorders)
+        recorder->reset();
+    m_lastStatsLog = std::chrono::steady_clock::now();
+    WorkerPool *workerPool = m_workerPool ? m_workerPool : WorkerPool::defaultPool();
+    std::string name = "cam" + std::to_string(camera->getPosNumber()) + "-";
+
+    m_rawPool = new FramePool(m_poolSize + m_historyDepth);
+    m_rawChannel.setHistoryDepth(m_historyDepth);
+    m_rawChannel.open();
+    m_grabWorker = workerPool->submit([this]{
+        productWorker(m_rawPool, &m_rawChannel, &m_rawStats, [this](PooledFrameType &frame){
+            logStats();
+            // getRawFrame() writes into frame.data1 in place when size and type are unchanged
+            return m_camera->getRawFrame(frame.data1, frame.timeStamp) && !frame.data1.empty();
+        });
+    }, name + "grab");
+
+    if(m_products & GRAB_RECT_FRAME){
+        m_rectPool = new FramePool(m_poolSize + m_historyDepth);
+        m_rectChannel.setHistoryDepth(m_historyDepth);
+        m_rectChannel.open();
+        m_rectWorker = workerPool->submit([this]{
+            uint64_t rawSequence = 0;
+            productWorker(m_rectPool, &m_rectChannel, &m_rectStats, [this, &rawSequence](PooledFrameType &frame){
+                return fillRectFrame(frame, rawSequence);
+            });
+        }, name + "rect");
+    }
+
+    if(m_products & (GRAB_DEPTH_FRAME | GRAB_COLOR_DEPTH)){
+        bool color = (m_products & GRAB_COLOR_DEPTH) != 0;
+        m_depthPool = new FramePool(m_poolSize + m_historyDepth);
+        m_depthChannel.setHistoryDepth(m_historyDepth);
+        m_depthChannel.open();
+        m_depthWorker = workerPool->submit([this, color]{
+            // color depth is gray depth through the palette table, not colored pixel by pixel in the camera
+            cv::Mat gray;
+            productWorker(m_depthPool, &m_depthChannel, &m_depthStats, [this, color, &gray](PooledFrameType &frame){
+                if(!color)
+                    return m_camera->getDepthFrame(frame.data1, false, frame.timeStamp) && !frame.data1.empty();
+                return m_camera->getDepthFrame(gray, false, frame.timeStamp) && m_colorizer.colorize(gray, frame.data1);
+            });
+        }, name + "depth");
+    }
+
+    if(m_products & GRAB_POINT_CLOUD){
+        m_cloudPool = new FramePool(m_poolSize + m_historyDepth);
+        m_cloudChannel.setHistoryDepth(m_historyDepth);
+        m_cloudChannel.open();
+        m_cloudWorker = workerPool->submit([this]{
+            productWorker(m_cloudPool, &m_cloudChannel, &m_cloudStats, [this](PooledFrameType &frame){
+                return m_camera->getPointCloud(frame.cloud, frame.timeStamp);
+            });
+        }, name + "cloud");
+    }
+
+    m_log->runTimeInfo("Start grab frame ...");
+    return true;
+}
+
+bool StereoFrameGrabber::stopGrab(void){
+    if(!m_grabWorker.valid())
+        return false;
+
+    m_isGrabbing = false;
+    m_rawChannel.close();
+    m_rectChannel.close();
+    m_depthChannel.close();
+    m_cloudChannel.close();
+
+    std::future<void> *workers[] = {&m_grabWorker, &m_rectWorker, &m_depthWorker, &m_cloudWorker};
+    for(std::future<void> *worker : workers){
+        if(!worker->valid())
+            continue;
+        worker->wait();
+        *worker = std::future<void>();
+    }
+
+    FramePool **pools[] = {&m_rawPool, &m_rectPool, &m_depthPool, &m_cloudPool};
+    for(FramePool **pool : pools){
+        if(!*pool)
+            continue;
+        if((*pool)->freeCount() != (*pool)->size())
+            m_log->runTimeError("Frame leases are still held while stopping grab!");
+        delete *pool;
+        *pool = nullptr;
+    }
+
+    m_camera = nullptr;
+    m_log->runTimeInfo("Stop grab frame done.");
+    return true;
+}
+
+bool StereoFrameGrabber::isGrabbing(void) const{
+    return m_isGrabbing;
+}
+
+bool StereoFrameGrabber::setDepthPalette(int palette, bool inverted){
+    if(m_grabWorker.valid()){
+        m_log->runTimeWarning("Grab threads are running, stop them before changing palette!");
+        return false;
+    }
+    if(!m_colorizer.setPalette(palette, inverted)){
+        m_log->runTimeError("Invalid depth palette %d!", palette);
+        return false;
+    }
+    return true;
+}
+
+bool StereoFrameGrabber::getRawFrame(FrameLease &lease){
+    return m_rawChannel.latest(lease);
+}
+
+bool StereoFrameGrabber::getStereoFrame(FrameLease &lease, cv::Mat &left, cv::Mat &right){
+    if(!getRawFrame(lease))
+        return false;
+    splitStereoFrame(lease.data1(), left, right);
+    return true;
+}
+
+bool StereoFrameGrabber::waitForRawFrame(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout){
+    return m_rawChannel.waitNewer(lease, sequence, timeout);
+}
+
+bool StereoFrameGrabber::waitForStereoFrame(FrameLease &lease, cv::Mat &left, cv::Mat &right,
+                                            uint64_t &sequence, std::chrono::microseconds timeout){
+    if(!waitForRawFrame(lease, sequence, timeout))
+        return false;
+    splitStereoFrame(lease.data1(), left, right);
+    return true;
+}
+
+bool StereoFrameGrabber::waitForRectFrame(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout){
+    return m_rectChannel.waitNewer(lease, sequence, timeout);
+}
+
+bool StereoFrameGrabber::waitForDepthFrame(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout){
+    return m_depthChannel.waitNewer(lease, sequence, timeout);
+}
+
+bool StereoFrameGrabber::waitForPointCloud(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout){
+    return m_cloudChannel.waitNewer(lease, sequence, timeout);
+}
+
+int StereoFrameGrabber::registerCallback(int product, FrameChannel::FrameCallbackType callback, CallbackExecutor *executor){
+    FrameChannel *channel = productChannel(product);
+    if(!channel){
+        m_log->runTimeError("Invalid grab product %d!", product);
+        return -1;
+    }
+    return channel->addCallback(std::move(callback), executor);
+}
+
+bool StereoFrameGrabber::unregisterCallback(int product, int id){
+    FrameChannel *channel = productChannel(product);
+    return channel ? channel->removeCallback(id) : false;
+}
+
+bool StereoFrameGrabber::setHistoryDepth(int depth){
+    if(m_grabWorker.valid()){
+        m_log->runTimeWarning("Grab threads are running, stop them before changing history depth!");
+        return false;
+    }
+    if(depth < 0 || depth > FRAME_HISTORY_MAX){
+        m_log->runTimeError("History depth must be 0 to %d!", FRAME_HISTORY_MAX);
+        return false;
+    }
+    m_historyDepth = depth;
+    return true;
+}
+
+bool StereoFrameGrabber::setWorkerPool(WorkerPool *pool){
+    if(m_grabWorker.valid()){
+        m_log->runTimeWarning("Grab threads are running, stop them before changing worker pool!");
+        return false;
+    }
+    m_workerPool = pool;
+    return true;
+}
+
+bool StereoFrameGrabber::findFrame(int product, std::chrono::microseconds timeStamp, FrameLease &lease, bool exact){
+    FrameChannel *channel = productChannel(product);
+    return channel ? channel->findFrame(timeStamp, lease, exact) : false;
+}
+
+bool StereoFrameGrabber::findFrame(int product, uint64_t sequence, FrameLease &lease){
+    FrameChannel *channel = productChannel(product);
+    return channel ? channel->findFrame(sequence, lease) : false;
+}
+
+FrameChannel* StereoFrameGrabber::productChannel(int product){
+    switch(product){
+    case GRAB_RAW_FRAME:
+        return &m_rawChannel;
+    case GRAB_RECT_FRAME:
+        return &m_rectChannel;
+    case GRAB_DEPTH_FRAME:
+    case GRAB_COLOR_DEPTH:
+        return &m_depthChannel;
+    case GRAB_POINT_CLOUD:
+        return &m_cloudChannel;
+    default:
+        return nullptr;
+    }
+}
+
+void StereoFrameGrabber::productWorker(FramePool *pool, FrameChannel *channel, StageStatsRecorder *stats,
+                                       FillFrameType fillFrame){
+    PooledFrameType scratch;   ///< frames dropped while every buffer is leased, keeps its allocation
+    while(m_isGrabbing){
+        int index = -1;
+        PooledFrameType *slot = pool->acquire(index);
+        if(!slot){
+            // every buffer is leased, sleep until a consumer releases one
+            if(pool->waitFree(std::chrono::milliseconds(10)))
+                continue;
+            // still leased, drop this frame but keep the camera queue moving
+            if(fillFrame(scratch))
+                stats->drop();
+            else
+                usleep(1000);
+            m_log->debugTimeWarning("All frame buffers are leased, drop frame.");
+            continue;
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if(!fillFrame(*slot)){
+            pool->discard(index);
+            usleep(1000);
+            continue;
+        }
+        stats->record(start);
+        slot->sequence = channel->nextSequence();
+        channel->publish(pool->commit(index));
+    }
+}
+
+void StereoFrameGrabber::getStats(std::vector<StageStatsType> &stats) const{
+    const StageStatsRecorder *recorders[] = {&m_rawStats, &m_rectStats, &m_depthStats, &m_cloudStats};
+    const int products[] = {GRAB_RAW_FRAME, GRAB_RECT_FRAME, GRAB_DEPTH_FRAME | GRAB_COLOR_DEPTH, GRAB_POINT_CLOUD};
+    const char *names[] = {"capture", "rectify", "depth", "cloud"};
+    stats.clear();
+    for(int i = 0; i < 4; i++){
+        if(!(m_products & products[i]))
+            continue;
+        StageStatsType stage;
+        stage.name = names[i];
+        recorders[i]->snapshot(stage);
+        stats.push_back(stage);
+    }
+}
+
+void StereoFrameGrabber::setStatsLogInterval(std::chrono::milliseconds interval){
+    m_statsInterval = std::max<int64_t>(0, interval.count());
+}
+
+void StereoFrameGrabber::logStats(void){
+    int64_t interval = m_statsInterval;
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if(interval <= 0 || now - m_lastStatsLog < std::chrono::milliseconds(interval))
+        return;
+    m_lastStatsLog = now;
+    std::vector<StageStatsType> stats;
+    getStats(stats);
+    logStageStats(m_log, stats);
+}
+
+bool StereoFrameGrabber::fillRectFrame(PooledFrameType &frame, uint64_t &rawSequence){
+    // rectify once per raw frame instead of polling getRectStereoFrame()
+    FrameLease raw;
+    if(!m_rawChannel.waitNewer(raw, rawSequence, std::chrono::milliseconds(100)))
+        return false;
+    frame.timeStamp = raw.timeStamp();
+    // host rectified cameras rectify the leased frame itself, getRectStereoFrame() would read another raw frame
+    if(m_hostCamera)
+        return m_hostCamera->rectifyFrame(raw.data1(), frame.data1, frame.data2);
+    raw.release();
+    return m_camera->getRectStereoFrame(frame.data1, frame.data2);
+}
+
+void StereoFrameGrabber::splitStereoFrame(const cv::Mat &frame, cv::Mat &left, cv::Mat &right){
+    // raw frame keeps the right image at the left half, see example_getRawFrame.cc
+    int halfWidth = frame.cols / 2;
+    right = frame(cv::Rect(0, 0, halfWidth, frame.rows));
+    left = frame(cv::Rect(halfWidth, 0, halfWidth, frame.rows));
+}
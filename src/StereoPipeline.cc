@@ -0,0 +1,809 @@
+/**
+  * @file StereoPipeline.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement the staged stereo compute pipeline APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "StereoPipeline.hpp"
+
+static bool readValue(const cv::FileStorage &fs, const char *key, double &value){
+    cv::Mat data;
+    fs[key] >> data;
+    if(data.empty())
+        return false;
+    data.convertTo(data, CV_64F);
+    value = data.at<double>(0);
+    return true;
+}
+
+static void readValue(const cv::FileStorage &fs, const char *key, int &value){
+    double data;
+    if(readValue(fs, key, data))
+        value = (int)data;
+}
+
+static void readValue(const cv::FileStorage &fs, const char *key, cv::Size &value){
+    cv::Mat data;
+    fs[key] >> data;
+    if(data.total() < 2)
+        return;
+    data.convertTo(data, CV_64F);
+    value = cv::Size((int)data.at<double>(0), (int)data.at<double>(1));
+}
+
+static void readValue(const cv::FileStorage &fs, const char *key, cv::Rect &value){
+    cv::Mat data;
+    fs[key] >> data;
+    if(data.total() < 4)
+        return;
+    data.convertTo(data, CV_64F);
+    value = cv::Rect((int)data.at<double>(0), (int)data.at<double>(1), (int)data.at<double>(2), (int)data.at<double>(3));
+}
+
+static void readValue(const cv::FileStorage &fs, const char *key, cv::Mat &value){
+    cv::Mat data;
+    fs[key] >> data;
+    if(!data.empty())
+        value = data;
+}
+
+static void readValue(const cv::FileStorage &fs, const char *key, std::string &value){
+    cv::FileNode node = fs[key];
+    if(!node.empty() && node.isString())
+        node >> value;
+}
+
+// sentinel of a product never requested
+#define NEVER_REQUESTED UINT64_MAX
+
+StereoPipeline::StereoPipeline(int poolSize) : m_poolSize(poolSize), m_isRunning(false), m_frameCount(0),
+                                                m_statsInterval(0){
+    for(std::atomic<uint64_t> &request : m_requestFrame)
+        request = NEVER_REQUESTED;
+    m_log = new SystemLog(m_logName);
+    m_log->setLogLevel(1);
+}
+
+StereoPipeline::~StereoPipeline(){
+    stopPipeline();
+    delete m_log;
+}
+
+bool StereoPipeline::loadConfig(std::string fileName){
+    cv::FileStorage fs(fileName, cv::FileStorage::READ);
+    if(!fs.isOpened()){
+        m_log->runTimeError("Open config file %s failed!", fileName.c_str());
+        return false;
+    }
+
+    StereoPipelineConfigType config = m_config;
+    readValue(fs, "CalibFrameSize", config.calibFrameSize);
+    readValue(fs, "RectifyFrameSize", config.rectFrameSize);
+    readValue(fs, "Depthmode", config.depthMode);
+    readValue(fs, "hFov", config.hFov);
+    readValue(fs, "RectifyMapCache", config.mapCacheDir);
+    double rectifyGray = config.rectifyGray ? 1 : 0;
+    readValue(fs, "RectifyGray", rectifyGray);
+    config.rectifyGray = rectifyGray != 0;
+    readValue(fs, "DepthRoi", config.depthRoi);
+    readValue(fs, "DepthDecimation", config.decimation);
+    double cloudSoA = config.cloudSoA ? 1 : 0;
+    readValue(fs, "CloudSoA", cloudSoA);
+    config.cloudSoA = cloudSoA != 0;
+    readValue(fs, "BodyTransform", config.bodyTransform);
+    readValue(fs, "CloudVoxelSize", config.cloudVoxelSize);
+    readValue(fs, "OutlierRadius", config.outlierRadius);
+    readValue(fs, "OutlierMinNeighbors", config.outlierMinNeighbors);
+    readValue(fs, "DisparityAlgorithm", config.algorithm);
+    readValue(fs, "NumDisparities", config.numDisparities);
+    readValue(fs, "BlockSize", config.blockSize);
+    readValue(fs, "DisparityBands", config.disparityBands);
+    readValue(fs, "DisparityBandOverlap", config.bandOverlap);
+    double temporalFilter = config.temporalFilter ? 1 : 0;
+    readValue(fs, "TemporalFilter", temporalFilter);
+    config.temporalFilter = temporalFilter != 0;
+    readValue(fs, "TemporalAlpha", config.temporalAlpha);
+    readValue(fs, "TemporalDelta", config.temporalDelta);
+    readValue(fs, "TemporalPersistence", config.temporalPersistence);
+    readValue(fs, "MinDepth", config.minDepth);
+    readValue(fs, "MaxDepth", config.maxDepth);
+    readValue(fs, "DepthFormat", config.depthFormat);
+    readValue(fs, "DepthPalette", config.depthPalette);
+    readValue(fs, "ColorMinDepth", config.colorMinDepth);
+    readValue(fs, "ColorMaxDepth", config.colorMaxDepth);
+    readValue(fs, "RectQueueDepth", config.rectQueueDepth);
+    readValue(fs, "DisparityQueueDepth", config.disparityQueueDepth);
+    readValue(fs, "ReprojectQueueDepth", config.reprojectQueueDepth);
+    readValue(fs, "DemandFrames", config.demandFrames);
+    readValue(fs, "HistoryDepth", config.historyDepth);
+    fs.release();
+    return setConfig(config);
+}
+
+bool StereoPipeline::setConfig(const StereoPipelineConfigType &config){
+    if(m_isRunning){
+        m_log->runTimeWarning("Pipeline is running, stop it before changing config!");
+        return false;
+    }
+    if(config.numDisparities <= 0 || config.numDisparities % 16 != 0){
+        m_log->runTimeError("NumDisparities must be a positive multiple of 16!");
+        return false;
+    }
+    if(config.blockSize < 1 || config.blockSize % 2 == 0){
+        m_log->runTimeError("BlockSize must be odd!");
+        return false;
+    }
+    if(config.rectFrameSize.area() <= 0 || config.calibFrameSize.area() <= 0){
+        m_log->runTimeError("Invalid frame size!");
+        return false;
+    }
+    if(config.disparityBands < 0 || config.bandOverlap < 0){
+        m_log->runTimeError("DisparityBands and DisparityBandOverlap must not be negative!");
+        return false;
+    }
+    if(config.decimation < 1 || config.depthRoi.x < 0 || config.depthRoi.y < 0 ||
+       config.depthRoi.width < 0 || config.depthRoi.height < 0){
+        m_log->runTimeError("Invalid DepthRoi or DepthDecimation!");
+        return false;
+    }
+    if(config.depthFormat != DEPTH_METER && config.depthFormat != DEPTH_MILLIMETER){
+        m_log->runTimeError("Invalid DepthFormat %d!", config.depthFormat);
+        return false;
+    }
+    if(config.depthPalette < PALETTE_JET || config.depthPalette > PALETTE_GRAY){
+        m_log->runTimeError("Invalid DepthPalette %d!", config.depthPalette);
+        return false;
+    }
+    if(!(config.minDepth > 0) || !(config.minDepth < config.maxDepth)){
+        m_log->runTimeError("MinDepth must be positive and less than MaxDepth!");
+        return false;
+    }
+    double colorMin = config.colorMinDepth > 0 ? config.colorMinDepth : config.minDepth;
+    double colorMax = config.colorMaxDepth > 0 ? config.colorMaxDepth : config.maxDepth;
+    if(!(colorMin < colorMax)){
+        m_log->runTimeError("ColorMinDepth must be less than ColorMaxDepth!");
+        return false;
+    }
+    if(config.historyDepth < 0 || config.historyDepth > FRAME_HISTORY_MAX){
+        m_log->runTimeError("HistoryDepth must be 0 to %d!", FRAME_HISTORY_MAX);
+        return false;
+    }
+    if(!config.bodyTransform.empty() && ((config.bodyTransform.rows != 3 && config.bodyTransform.rows != 4) ||
+                                         config.bodyTransform.cols != 4 || config.bodyTransform.channels() != 1)){
+        m_log->runTimeError("BodyTransform must be a 4x4 or 3x4 matrix!");
+        return false;
+    }
+    if(!PointCloudFilter::isValidParams((float)config.cloudVoxelSize, (float)config.outlierRadius,
+                                        config.outlierMinNeighbors)){
+        m_log->runTimeError("CloudVoxelSize and OutlierRadius must not be negative, OutlierMinNeighbors must be positive!");
+        return false;
+    }
+    if(!TemporalFilter::isValidParams((float)config.temporalAlpha, (float)config.temporalDelta,
+                                      config.temporalPersistence)){
+        m_log->runTimeError("TemporalAlpha must be in (0, 1], TemporalDelta and TemporalPersistence must not be negative!");
+        return false;
+    }
+
+    // everything is checked, a rejected config leaves the filters unchanged
+    m_cloudFilter.setParams((float)config.cloudVoxelSize, (float)config.outlierRadius, config.outlierMinNeighbors);
+    m_temporalFilter.setParams((float)config.temporalAlpha, (float)config.temporalDelta, config.temporalPersistence);
+    m_config = config;
+    m_config.bodyTransform = config.bodyTransform.clone();
+    m_config.rectQueueDepth = std::max(1, config.rectQueueDepth);
+    m_config.disparityQueueDepth = std::max(1, config.disparityQueueDepth);
+    m_config.reprojectQueueDepth = std::max(1, config.reprojectQueueDepth);
+    return true;
+}
+
+StereoPipelineConfigType StereoPipeline::getConfig(void) const{
+    return m_config;
+}
+
+bool StereoPipeline::setDepthRoi(cv::Rect roi, int decimation){
+    StereoPipelineConfigType config = m_config;
+    config.depthRoi = roi;
+    config.decimation = decimation;
+    return setConfig(config);
+}
+
+bool StereoPipeline::setBodyTransform(const cv::Mat &transform){
+    StereoPipelineConfigType config = m_config;
+    config.bodyTransform = transform;
+    if(!setConfig(config))
+        return false;
+    return m_reprojector.setTransform(m_config.bodyTransform);
+}
+
+bool StereoPipeline::init(StereoCamera *camera){
+    std::vector<cv::Mat> leftParams, rightParams;
+    if(!camera || !camera->getCalibParams(leftParams, false) || !camera->getCalibParams(rightParams, true)){
+        m_log->runTimeError("Get camera calibration parameters failed!");
+        return false;
+    }
+    return init(leftParams, rightParams, camera->getRawFrameSize());
+}
+
+bool StereoPipeline::init(const std::vector<cv::Mat> &leftParams, const std::vector<cv::Mat> &rightParams,
+                          cv::Size rawFrameSize){
+    cv::Size rawSize(rawFrameSize.width / 2, rawFrameSize.height);
+    if(!m_rectifier.init(leftParams, rightParams, m_config.calibFrameSize, rawSize, m_config.rectFrameSize,
+                         m_config.depthMode, m_config.hFov, m_config.mapCacheDir,
+                         m_config.depthRoi, m_config.decimation) || !m_reprojector.init(m_rectifier, m_config.numDisparities)){
+        m_log->runTimeError("Build rectification maps failed!");
+        return false;
+    }
+    m_reprojector.setTransform(m_config.bodyTransform);
+    m_colorizer.setPalette(m_config.depthPalette);
+    m_colorizer.setDepthRange((float)(m_config.colorMinDepth > 0 ? m_config.colorMinDepth : m_config.minDepth),
+                              (float)(m_config.colorMaxDepth > 0 ? m_config.colorMaxDepth : m_config.maxDepth));
+    if(m_rectifier.isCached())
+        m_log->runTimeInfo("Rectification maps loaded from %s.", m_config.mapCacheDir.c_str());
+
+    // every band is at least one block plus the overlap high
+    int bands = m_config.disparityBands > 0 ? m_config.disparityBands : cv::getNumberOfCPUs();
+    int rows = m_rectifier.getRectFrameSize().height;
+    bands = std::max(1, std::min(bands, rows / (m_config.blockSize + m_config.bandOverlap)));
+    m_matchers.resize(bands);
+    for(cv::Ptr<cv::StereoMatcher> &matcher : m_matchers)
+        matcher = createMatcher();
+    m_bandDisparity.resize(bands);
+    m_temporalFilter.reset();
+    {
+        std::lock_guard<std::mutex> lock(m_timingLock);
+        m_bandTimings.clear();
+    }
+    m_rectStats.reset();
+    m_dispStats.reset();
+    m_reprojStats.reset();
+    return true;
+}
+
+bool StereoPipeline::setWorkerPool(WorkerPool *pool){
+    if(m_rectWorker.valid()){
+        m_log->runTimeWarning("Pipeline is running, stop it before changing worker pool!");
+        return false;
+    }
+    m_workerPool = pool;
+    return true;
+}
+
+bool StereoPipeline::startPipeline(StereoCamera *camera, StereoFrameGrabber *grabber){
+    if(m_rectWorker.valid()){
+        m_log->runTimeWarning("Pipeline is already running!");
+        return false;
+    }
+    if(!grabber || !grabber->isGrabbing()){
+        m_log->runTimeError("Frame grabber is not grabbing!");
+        return false;
+    }
+    if(!init(camera))
+        return false;
+
+    // kept frames stay in their pooled buffers
+    int poolSize = m_poolSize + m_config.historyDepth;
+    m_rectPool = new FramePool(poolSize);
+    m_dispPool = new FramePool(poolSize);
+    m_depthPool = new FramePool(poolSize);
+    m_cloudPool = new FramePool(poolSize);
+    m_colorPool = new FramePool(poolSize);
+    m_rectQueue = new BoundedQueue<PipelineJobType>(m_config.rectQueueDepth);
+    m_dispQueue = new BoundedQueue<PipelineJobType>(m_config.disparityQueueDepth);
+    m_reprojQueue = new BoundedQueue<PipelineJobType>(m_config.reprojectQueueDepth);
+    FrameChannel *channels[] = {&m_rectChannel, &m_dispChannel, &m_depthChannel, &m_cloudChannel, &m_colorChannel};
+    for(FrameChannel *channel : channels){
+        channel->setHistoryDepth(m_config.historyDepth);
+        channel->open();
+    }
+
+    m_frameCount = 0;
+    for(std::atomic<uint64_t> &request : m_requestFrame)
+        request = NEVER_REQUESTED;
+    m_lastStatsLog = std::chrono::steady_clock::now();
+    m_isRunning = true;
+    WorkerPool *workerPool = m_workerPool ? m_workerPool : WorkerPool::defaultPool();
+    std::string name = "cam" + std::to_string(camera->getPosNumber()) + "-";
+    m_rectWorker = workerPool->submit([this]{ rectifyWorker(); }, name + "rectify");
+    m_dispWorker = workerPool->submit([this]{ disparityWorker(); }, name + "disparity");
+    m_reprojWorker = workerPool->submit([this]{ reprojectWorker(); }, name + "reproject");
+
+    // the grab thread only queues the raw lease, rectification runs on the pipeline thread
+    m_grabber = grabber;
+    m_rawCallback = m_grabber->registerCallback(GRAB_RAW_FRAME, [this](const FrameLease &raw){
+        m_frameCount++;
+        PipelineJobType job;
+        job.raw = raw;
+        m_rectQueue->push(std::move(job));
+    });
+
+    m_log->runTimeInfo("Start stereo pipeline ...");
+    return true;
+}
+
+bool StereoPipeline::stopPipeline(void){
+    if(!m_rectWorker.valid())
+        return false;
+
+    // removeCallback() waits for a running callback, no raw frame is queued after this
+    m_grabber->unregisterCallback(GRAB_RAW_FRAME, m_rawCallback);
+    m_grabber = nullptr;
+    m_rawCallback = -1;
+
+    m_isRunning = false;
+    m_rectQueue->close();
+    m_dispQueue->close();
+    m_reprojQueue->close();
+    m_rectChannel.close();
+    m_dispChannel.close();
+    m_depthChannel.close();
+    m_cloudChannel.close();
+    m_colorChannel.close();
+
+    std::future<void> *workers[] = {&m_rectWorker, &m_dispWorker, &m_reprojWorker};
+    for(std::future<void> *worker : workers){
+        worker->wait();
+        *worker = std::future<void>();
+    }
+
+    BoundedQueue<PipelineJobType> **queues[] = {&m_rectQueue, &m_dispQueue, &m_reprojQueue};
+    for(BoundedQueue<PipelineJobType> **queue : queues){
+        delete *queue;
+        *queue = nullptr;
+    }
+
+    FramePool **pools[] = {&m_rectPool, &m_dispPool, &m_depthPool, &m_cloudPool, &m_colorPool};
+    for(FramePool **pool : pools){
+        if((*pool)->freeCount() != (*pool)->size())
+            m_log->runTimeError("Frame leases are still held while stopping pipeline!");
+        delete *pool;
+        *pool = nullptr;
+    }
+
+    m_log->runTimeInfo("Stop stereo pipeline done.");
+    return true;
+}
+
+bool StereoPipeline::isRunning(void) const{
+    return m_isRunning;
+}
+
+bool StereoPipeline::processFrame(const cv::Mat &raw, cv::Mat &left, cv::Mat &right, cv::Mat &disparity,
+                                  cv::Mat *depth, std::vector<PCLType> *cloud){
+    // the stage threads own the matchers, scratch images and filters while running
+    if(m_isRunning){
+        m_log->runTimeWarning("Pipeline is running, stop it before processing frames directly!");
+        return false;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if(!m_rectifier.rectify(raw, left, right, m_config.rectifyGray))
+        return false;
+    m_rectStats.record(start);
+    start = std::chrono::steady_clock::now();
+    if(!computeDisparity(left, right, disparity))
+        return false;
+    m_dispStats.record(start);
+    if(!depth && !cloud)
+        return true;
+    start = std::chrono::steady_clock::now();
+    float minDepth = (float)m_config.minDepth, maxDepth = (float)m_config.maxDepth;
+    if(m_config.depthFormat != DEPTH_MILLIMETER){
+        if(!m_reprojector.reproject(disparity, left, minDepth, maxDepth, depth, cloud))
+            return false;
+    }
+    else{
+        if(depth && !m_reprojector.computeDepth(disparity, minDepth, maxDepth, *depth, nullptr))
+            return false;
+        if(cloud && !m_reprojector.reproject(disparity, left, minDepth, maxDepth, nullptr, cloud))
+            return false;
+    }
+    if(cloud)
+        filterCloud(*cloud);
+    m_reprojStats.record(start);
+    return true;
+}
+
+bool StereoPipeline::processFrame(const cv::Mat &raw, cv::Mat &left, cv::Mat &right, cv::Mat &disparity,
+                                  cv::Mat *depth, PointCloudSoAType &cloud){
+    if(m_isRunning){
+        m_log->runTimeWarning("Pipeline is running, stop it before processing frames directly!");
+        return false;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if(!m_rectifier.rectify(raw, left, right, m_config.rectifyGray))
+        return false;
+    m_rectStats.record(start);
+    start = std::chrono::steady_clock::now();
+    if(!computeDisparity(left, right, disparity))
+        return false;
+    m_dispStats.record(start);
+    start = std::chrono::steady_clock::now();
+    float minDepth = (float)m_config.minDepth, maxDepth = (float)m_config.maxDepth;
+    if(m_config.depthFormat != DEPTH_MILLIMETER){
+        if(!m_reprojector.reproject(disparity, left, minDepth, maxDepth, depth, cloud))
+            return false;
+    }
+    else{
+        if(depth && !m_reprojector.computeDepth(disparity, minDepth, maxDepth, *depth, nullptr))
+            return false;
+        if(!m_reprojector.reproject(disparity, left, minDepth, maxDepth, nullptr, cloud))
+            return false;
+    }
+    filterCloud(cloud);
+    m_reprojStats.record(start);
+    return true;
+}
+
+bool StereoPipeline::waitForRectFrame(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout){
+    requestProducts(PIPELINE_RECT_FRAME);
+    return m_rectChannel.waitNewer(lease, sequence, timeout);
+}
+
+bool StereoPipeline::waitForDisparity(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout){
+    requestProducts(PIPELINE_DISPARITY);
+    return m_dispChannel.waitNewer(lease, sequence, timeout);
+}
+
+bool StereoPipeline::waitForDepthFrame(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout){
+    requestProducts(PIPELINE_DEPTH_FRAME);
+    return m_depthChannel.waitNewer(lease, sequence, timeout);
+}
+
+bool StereoPipeline::waitForPointCloud(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout){
+    requestProducts(PIPELINE_POINT_CLOUD);
+    return m_cloudChannel.waitNewer(lease, sequence, timeout);
+}
+
+bool StereoPipeline::waitForColorDepth(FrameLease &lease, uint64_t &sequence, std::chrono::microseconds timeout){
+    requestProducts(PIPELINE_COLOR_DEPTH);
+    return m_colorChannel.waitNewer(lease, sequence, timeout);
+}
+
+int StereoPipeline::registerCallback(int product, FrameChannel::FrameCallbackType callback, CallbackExecutor *executor){
+    FrameChannel *channel = productChannel(product);
+    if(!channel){
+        m_log->runTimeError("Invalid pipeline product %d!", product);
+        return -1;
+    }
+    return channel->addCallback(std::move(callback), executor);
+}
+
+bool StereoPipeline::unregisterCallback(int product, int id){
+    FrameChannel *channel = productChannel(product);
+    return channel ? channel->removeCallback(id) : false;
+}
+
+bool StereoPipeline::findFrame(int product, std::chrono::microseconds timeStamp, FrameLease &lease, bool exact){
+    FrameChannel *channel = productChannel(product);
+    if(!channel)
+        return false;
+    requestProducts(product);
+    return channel->findFrame(timeStamp, lease, exact);
+}
+
+bool StereoPipeline::findFrame(int product, uint64_t sequence, FrameLease &lease){
+    FrameChannel *channel = productChannel(product);
+    if(!channel)
+        return false;
+    requestProducts(product);
+    return channel->findFrame(sequence, lease);
+}
+
+uint64_t StereoPipeline::getDropCount(void) const{
+    if(!m_rectQueue)
+        return 0;
+    return m_rectQueue->dropCount() + m_dispQueue->dropCount() + m_reprojQueue->dropCount();
+}
+
+void StereoPipeline::requestProducts(int products){
+    uint64_t frame = m_frameCount;
+    for(int product = PIPELINE_RECT_FRAME; product <= PIPELINE_COLOR_DEPTH; product <<= 1)
+        if(products & product)
+            m_requestFrame[productIndex(product)] = frame;
+}
+
+int StereoPipeline::getDemandedProducts(void){
+    int products = 0;
+    uint64_t frame = m_frameCount;
+    for(int product = PIPELINE_RECT_FRAME; product <= PIPELINE_COLOR_DEPTH; product <<= 1){
+        uint64_t request = m_requestFrame[productIndex(product)];
+        if(m_config.demandFrames <= 0 || productChannel(product)->callbackCount() > 0 ||
+           (request != NEVER_REQUESTED && frame - request <= (uint64_t)m_config.demandFrames))
+            products |= product;
+    }
+
+    // depth, point cloud and color depth need disparity, disparity needs rectified frames
+    if(products & (PIPELINE_DEPTH_FRAME | PIPELINE_POINT_CLOUD | PIPELINE_COLOR_DEPTH))
+        products |= PIPELINE_DISPARITY;
+    if(products & PIPELINE_DISPARITY)
+        products |= PIPELINE_RECT_FRAME;
+    return products;
+}
+
+int StereoPipeline::productIndex(int product){
+    switch(product){
+    case PIPELINE_RECT_FRAME:
+        return 0;
+    case PIPELINE_DISPARITY:
+        return 1;
+    case PIPELINE_DEPTH_FRAME:
+        return 2;
+    case PIPELINE_POINT_CLOUD:
+        return 3;
+    case PIPELINE_COLOR_DEPTH:
+        return 4;
+    default:
+        return -1;
+    }
+}
+
+FrameChannel* StereoPipeline::productChannel(int product){
+    switch(product){
+    case PIPELINE_RECT_FRAME:
+        return &m_rectChannel;
+    case PIPELINE_DISPARITY:
+        return &m_dispChannel;
+    case PIPELINE_DEPTH_FRAME:
+        return &m_depthChannel;
+    case PIPELINE_POINT_CLOUD:
+        return &m_cloudChannel;
+    case PIPELINE_COLOR_DEPTH:
+        return &m_colorChannel;
+    default:
+        return nullptr;
+    }
+}
+
+void StereoPipeline::rectifyWorker(void){
+    PipelineJobType job;
+    while(m_rectQueue->pop(job)){
+        logStats();
+        if(!(getDemandedProducts() & PIPELINE_RECT_FRAME)){
+            m_rectStats.skip();
+            continue;
+        }
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        int index = -1;
+        PooledFrameType *slot = m_rectPool->acquire(index);
+        if(!slot){
+            m_rectStats.drop();
+            m_log->debugTimeWarning("All rectified frame buffers are leased, drop frame.");
+            continue;
+        }
+        if(!m_rectifier.rectify(job.raw.data1(), slot->data1, slot->data2, m_config.rectifyGray)){
+            m_rectPool->discard(index);
+            continue;
+        }
+        slot->timeStamp = job.raw.timeStamp();
+        slot->sequence = m_rectChannel.nextSequence();
+        job.raw.release();
+        job.rect = m_rectPool->commit(index);
+        m_rectStats.record(start);
+        m_rectChannel.publish(FrameLease(job.rect));
+        m_dispQueue->push(std::move(job));
+    }
+}
+
+void StereoPipeline::disparityWorker(void){
+    PipelineJobType job;
+    while(m_dispQueue->pop(job)){
+        if(!(getDemandedProducts() & PIPELINE_DISPARITY)){
+            m_dispStats.skip();
+            continue;
+        }
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        int index = -1;
+        PooledFrameType *slot = m_dispPool->acquire(index);
+        if(!slot){
+            m_dispStats.drop();
+            m_log->debugTimeWarning("All disparity buffers are leased, drop frame.");
+            continue;
+        }
+        if(!computeDisparity(job.rect.data1(), job.rect.data2(), slot->data1)){
+            m_dispPool->discard(index);
+            continue;
+        }
+        slot->timeStamp = job.rect.timeStamp();
+        slot->sequence = m_dispChannel.nextSequence();
+        job.disparity = m_dispPool->commit(index);
+        m_dispStats.record(start);
+        m_dispChannel.publish(FrameLease(job.disparity));
+        m_reprojQueue->push(std::move(job));
+    }
+}
+
+void StereoPipeline::reprojectWorker(void){
+    PipelineJobType job;
+    while(m_reprojQueue->pop(job)){
+        int products = getDemandedProducts();
+        if(!(products & (PIPELINE_DEPTH_FRAME | PIPELINE_POINT_CLOUD | PIPELINE_COLOR_DEPTH))){
+            m_reprojStats.skip();
+            continue;
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        int depthIndex = -1, cloudIndex = -1;
+        PooledFrameType *depth = (products & PIPELINE_DEPTH_FRAME) ? m_depthPool->acquire(depthIndex) : nullptr;
+        PooledFrameType *cloud = (products & PIPELINE_POINT_CLOUD) ? m_cloudPool->acquire(cloudIndex) : nullptr;
+        bool isColored = (products & PIPELINE_COLOR_DEPTH) != 0;
+        if(!depth && !cloud && !isColored){
+            m_reprojStats.drop();
+            m_log->debugTimeWarning("All depth and point cloud buffers are leased, drop frame.");
+            continue;
+        }
+
+        bool isDone = true;
+        bool isMillimeter = m_config.depthFormat == DEPTH_MILLIMETER;
+        float minDepth = (float)m_config.minDepth, maxDepth = (float)m_config.maxDepth;
+        cv::Mat *depthImage = depth ? &depth->data1 : (isColored ? &m_colorSource : nullptr);
+        if(depthImage && isMillimeter){
+            // millimeter depth comes straight from the disparity, the point cloud pass writes no float depth
+            isDone = m_reprojector.computeDepth(job.disparity.data1(), minDepth, maxDepth, *depthImage,
+                                                depth ? &depth->data2 : nullptr);
+        }
+        cv::Mat *floatDepth = isMillimeter ? nullptr : depthImage;
+        if(isDone && cloud && m_config.cloudSoA){
+            isDone = m_reprojector.reproject(job.disparity.data1(), job.rect.data1(), minDepth, maxDepth,
+                                             floatDepth, cloud->cloudSoA);
+        }
+        else if(isDone && (cloud || floatDepth)){
+            isDone = m_reprojector.reproject(job.disparity.data1(), job.rect.data1(), minDepth, maxDepth,
+                                             floatDepth, cloud ? &cloud->cloud : nullptr);
+        }
+        if(isDone && cloud){
+            if(m_config.cloudSoA)
+                filterCloud(cloud->cloudSoA);
+            else
+                filterCloud(cloud->cloud);
+        }
+        if(isDone && isColored)
+            publishColorDepth(*depthImage, job.disparity.timeStamp());
+        if(isDone)
+            m_reprojStats.record(start);
+        if(depth){
+            if(isDone){
+                depth->timeStamp = job.disparity.timeStamp();
+                depth->sequence = m_depthChannel.nextSequence();
+                m_depthChannel.publish(m_depthPool->commit(depthIndex));
+            }
+            else{
+                m_depthPool->discard(depthIndex);
+            }
+        }
+        if(cloud){
+            if(isDone){
+                cloud->timeStamp = job.disparity.timeStamp();
+                cloud->sequence = m_cloudChannel.nextSequence();
+                m_cloudChannel.publish(m_cloudPool->commit(cloudIndex));
+            }
+            else{
+                m_cloudPool->discard(cloudIndex);
+            }
+        }
+    }
+}
+
+void StereoPipeline::filterCloud(std::vector<PCLType> &cloud){
+    if(m_cloudFilter.isEnabled())
+        m_cloudFilter.apply(cloud);
+}
+
+void StereoPipeline::filterCloud(PointCloudSoAType &cloud){
+    if(m_cloudFilter.isEnabled())
+        m_cloudFilter.apply(cloud);
+}
+
+void StereoPipeline::publishColorDepth(const cv::Mat &depth, std::chrono::microseconds timeStamp){
+    int index = -1;
+    PooledFrameType *color = m_colorPool->acquire(index);
+    if(!color){
+        m_log->debugTimeWarning("All color depth buffers are leased, drop frame.");
+        return;
+    }
+    if(!m_colorizer.colorize(depth, color->data1)){
+        m_colorPool->discard(index);
+        return;
+    }
+    color->timeStamp = timeStamp;
+    color->sequence = m_colorChannel.nextSequence();
+    m_colorChannel.publish(m_colorPool->commit(index));
+}
+
+void StereoPipeline::getStats(std::vector<StageStatsType> &stats) const{
+    const StageStatsRecorder *recorders[] = {&m_rectStats, &m_dispStats, &m_reprojStats};
+    BoundedQueue<PipelineJobType> *queues[] = {m_rectQueue, m_dispQueue, m_reprojQueue};
+    const char *names[] = {"rectify", "disparity", "reproject"};
+    stats.resize(3);
+    for(int i = 0; i < 3; i++){
+        stats[i].name = names[i];
+        recorders[i]->snapshot(stats[i]);
+        stats[i].queueDepth = queues[i] ? queues[i]->size() : 0;
+        stats[i].queueCapacity = queues[i] ? queues[i]->capacity() : 0;
+        stats[i].dropped += queues[i] ? queues[i]->dropCount() : 0;
+    }
+}
+
+void StereoPipeline::setStatsLogInterval(std::chrono::milliseconds interval){
+    m_statsInterval = std::max<int64_t>(0, interval.count());
+}
+
+void StereoPipeline::logStats(void){
+    int64_t interval = m_statsInterval;
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if(interval <= 0 || now - m_lastStatsLog < std::chrono::milliseconds(interval))
+        return;
+    m_lastStatsLog = now;
+    std::vector<StageStatsType> stats;
+    getStats(stats);
+    logStageStats(m_log, stats);
+}
+
+bool StereoPipeline::getBandTimings(std::vector<double> &timings) const{
+    std::lock_guard<std::mutex> lock(m_timingLock);
+    timings = m_bandTimings;
+    return !timings.empty();
+}
+
+cv::Ptr<cv::StereoMatcher> StereoPipeline::createMatcher(void) const{
+    if(m_config.algorithm == DISPARITY_BM)
+        return cv::StereoBM::create(m_config.numDisparities, std::max(5, m_config.blockSize));
+
+    int area = m_config.blockSize * m_config.blockSize;
+    return cv::StereoSGBM::create(0, m_config.numDisparities, m_config.blockSize, 8 * area, 32 * area,
+                                  1, 0, 10, 100, 1, cv::StereoSGBM::MODE_SGBM_3WAY);
+}
+
+bool StereoPipeline::computeDisparity(const cv::Mat &left, const cv::Mat &right, cv::Mat &disparity){
+    if(m_matchers.empty() || left.empty() || right.empty() || left.size() != right.size())
+        return false;
+
+    const cv::Mat *grayLeft = &left, *grayRight = &right;
+    if(left.channels() == 3){
+        cv::cvtColor(left, m_grayLeft, cv::COLOR_BGR2GRAY);
+        cv::cvtColor(right, m_grayRight, cv::COLOR_BGR2GRAY);
+        grayLeft = &m_grayLeft;
+        grayRight = &m_grayRight;
+    }
+
+    int bands = (int)m_matchers.size();
+    std::vector<double> timings(bands, 0);
+    disparity.create(left.size(), CV_16SC1);
+    if(bands == 1){
+        int64_t start = cv::getTickCount();
+        m_matchers[0]->compute(*grayLeft, *grayRight, disparity);
+        timings[0] = (cv::getTickCount() - start) * 1000.0 / cv::getTickFrequency();
+    }
+    else{
+        cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range &range){
+            for(int band = range.start; band < range.end; band++){
+                int64_t start = cv::getTickCount();
+                computeBand(band, *grayLeft, *grayRight, disparity);
+                timings[band] = (cv::getTickCount() - start) * 1000.0 / cv::getTickFrequency();
+            }
+        }, bands);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_timingLock);
+        m_bandTimings.swap(timings);
+    }
+    if(disparity.type() != CV_16SC1)
+        return false;
+    // frames are matched in order, the filter state is the previous matched frame
+    return !m_config.temporalFilter || m_temporalFilter.apply(disparity);
+}
+
+void StereoPipeline::computeBand(int band, const cv::Mat &left, const cv::Mat &right, cv::Mat &disparity){
+    // rectified rows are epipolar lines, a band only needs some rows around it for block and path support
+    int bands = (int)m_matchers.size();
+    int top = left.rows * band / bands, bottom = left.rows * (band + 1) / bands;
+    int overlapTop = std::max(0, top - m_config.bandOverlap);
+    int overlapBottom = std::min(left.rows, bottom + m_config.bandOverlap);
+    cv::Rect roi(0, overlapTop, left.cols, overlapBottom - overlapTop);
+
+    cv::Mat &bandDisparity = m_bandDisparity[band];
+    m_matchers[band]->compute(left(roi), right(roi), bandDisparity);
+    cv::Mat target = disparity.rowRange(top, bottom);
+    bandDisparity.rowRange(top - overlapTop, bottom - overlapTop).copyTo(target);
+}
@@ -0,0 +1,481 @@
+/**
+  * @file StereoRectifier.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement stereo image rectification APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "StereoRectifier.hpp"
+#include <cerrno>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MAP_CACHE_VERSION 1
+
+typedef struct MapCacheHeader{
+    char magic[8];
+    uint32_t version;
+    int32_t width;
+    int32_t height;
+    uint32_t reserved;
+    uint64_t key;
+}MapCacheHeaderType;
+
+static const char MAP_CACHE_MAGIC[8] = {'U', 'R', 'E', 'C', 'T', 'M', 'A', 'P'};
+
+// FNV-1a, stable across runs and platforms of the same endianness
+static uint64_t hashBytes(uint64_t hash, const void *data, size_t size){
+    const unsigned char *bytes = (const unsigned char*)data;
+    for(size_t i = 0; i < size; i++){
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static uint64_t hashMat(uint64_t hash, const cv::Mat &m){
+    cv::Mat d;
+    m.convertTo(d, CV_64F);
+    d = d.clone();   // continuous
+    int32_t count = (int32_t)d.total();
+    hash = hashBytes(hash, &count, sizeof(count));
+    return hashBytes(hash, d.ptr(), d.total() * d.elemSize());
+}
+
+// fixed-point maps keep 5 fractional bits of x and y, see cv::convertMaps()
+#define REMAP_BITS 5
+#define REMAP_SIZE (1 << REMAP_BITS)
+#define REMAP_TILE_ROWS 16
+
+static inline int grayValue(int b, int g, int r){
+    return (b * 29 + g * 150 + r * 77 + 128) >> 8;
+}
+
+template<int cn, bool gray>
+static void remapRows(const cv::Mat &src, const cv::Mat &mapXY, const cv::Mat &mapA, cv::Mat &dst,
+                      int rowStart, int rowEnd){
+    const int outCn = gray ? 1 : cn;
+    const int maxX = src.cols - 1, maxY = src.rows - 1;
+    for(int v = rowStart; v < rowEnd; v++){
+        const short *xy = mapXY.ptr<short>(v);
+        const unsigned short *a = mapA.ptr<unsigned short>(v);
+        unsigned char *out = dst.ptr<unsigned char>(v);
+        for(int u = 0; u < dst.cols; u++, out += outCn){
+            int x = xy[2 * u], y = xy[2 * u + 1];
+            int fx = a[u] & (REMAP_SIZE - 1), fy = a[u] >> REMAP_BITS;
+            int w00 = (REMAP_SIZE - fx) * (REMAP_SIZE - fy), w01 = fx * (REMAP_SIZE - fy);
+            int w10 = (REMAP_SIZE - fx) * fy, w11 = fx * fy;
+
+            int value[cn];
+            if(x >= 0 && y >= 0 && x < maxX && y < maxY){
+                const unsigned char *p0 = src.ptr<unsigned char>(y) + x * cn;
+                const unsigned char *p1 = p0 + src.step;
+                for(int c = 0; c < cn; c++)
+                    value[c] = (p0[c] * w00 + p0[c + cn] * w01 + p1[c] * w10 + p1[c + cn] * w11
+                                + (1 << (2 * REMAP_BITS - 1))) >> (2 * REMAP_BITS);
+            }
+            else{
+                // border, neighbours outside the image are black like BORDER_CONSTANT
+                const int xs[2] = {x, x + 1}, ys[2] = {y, y + 1};
+                const int ws[4] = {w00, w01, w10, w11};
+                int sum[cn] = {0};
+                for(int k = 0; k < 4; k++){
+                    int sx = xs[k & 1], sy = ys[k >> 1];
+                    if(sx < 0 || sy < 0 || sx > maxX || sy > maxY)
+                        continue;
+                    const unsigned char *p = src.ptr<unsigned char>(sy) + sx * cn;
+                    for(int c = 0; c < cn; c++)
+                        sum[c] += p[c] * ws[k];
+                }
+                for(int c = 0; c < cn; c++)
+                    value[c] = (sum[c] + (1 << (2 * REMAP_BITS - 1))) >> (2 * REMAP_BITS);
+            }
+
+            if(gray && cn == 3){
+                out[0] = (unsigned char)grayValue(value[0], value[1], value[cn - 1]);
+            }
+            else{
+                for(int c = 0; c < outCn; c++)
+                    out[c] = (unsigned char)value[c];
+            }
+        }
+    }
+}
+
+typedef struct RemapView{
+    cv::Mat src;
+    const cv::Mat *mapXY;
+    const cv::Mat *mapA;
+    cv::Mat *dst;
+}RemapViewType;
+
+static void remapViews(const std::vector<RemapViewType> &views, int channels, bool gray){
+    int tiles = 1;
+    for(const RemapViewType &view : views)
+        tiles = std::max(tiles, (view.dst->rows + REMAP_TILE_ROWS - 1) / REMAP_TILE_ROWS);
+
+    cv::parallel_for_(cv::Range(0, tiles), [&](const cv::Range &range){
+        for(int tile = range.start; tile < range.end; tile++){
+            for(const RemapViewType &view : views){
+                int rowStart = view.dst->rows * tile / tiles, rowEnd = view.dst->rows * (tile + 1) / tiles;
+                if(channels == 3 && gray)
+                    remapRows<3, true>(view.src, *view.mapXY, *view.mapA, *view.dst, rowStart, rowEnd);
+                else if(channels == 3)
+                    remapRows<3, false>(view.src, *view.mapXY, *view.mapA, *view.dst, rowStart, rowEnd);
+                else
+                    remapRows<1, false>(view.src, *view.mapXY, *view.mapA, *view.dst, rowStart, rowEnd);
+            }
+        }
+    });
+}
+
+static size_t mapCacheSize(cv::Size size){
+    // per camera: CV_16SC2 coordinate map and CV_16UC1 interpolation map
+    return sizeof(MapCacheHeaderType) + 2 * (size_t)size.area() * (2 * sizeof(int16_t) + sizeof(uint16_t));
+}
+
+static cv::Mat toDouble(const cv::Mat &m){
+    cv::Mat d;
+    m.convertTo(d, CV_64F);
+    return d;
+}
+
+static cv::Mat scaleIntrinsic(const cv::Mat &K, double sx, double sy){
+    cv::Mat k = toDouble(K);
+    for(int c = 0; c < 3; c++){
+        k.at<double>(0, c) *= sx;
+        k.at<double>(1, c) *= sy;
+    }
+    return k;
+}
+
+void initMeiRectifyMap(const cv::Mat &K, const cv::Mat &D, const cv::Mat &xi, const cv::Mat &R,
+                       const cv::Mat &Knew, cv::Size size, int mode, cv::Mat &mapX, cv::Mat &mapY){
+    cv::Mat k = toDouble(K), d = toDouble(D), r = toDouble(R), kn = toDouble(Knew);
+    double fx = k.at<double>(0, 0), fy = k.at<double>(1, 1), s = k.at<double>(0, 1);
+    double cx = k.at<double>(0, 2), cy = k.at<double>(1, 2);
+    double k1 = d.at<double>(0), k2 = d.at<double>(1), p1 = d.at<double>(2), p2 = d.at<double>(3);
+    double xiv = toDouble(xi).at<double>(0);
+    double nfx = kn.at<double>(0, 0), nfy = kn.at<double>(1, 1);
+    double ncx = kn.at<double>(0, 2), ncy = kn.at<double>(1, 2);
+
+    mapX.create(size, CV_32FC1);
+    mapY.create(size, CV_32FC1);
+    for(int v = 0; v < size.height; v++){
+        float *mx = mapX.ptr<float>(v);
+        float *my = mapY.ptr<float>(v);
+        double lat = (v - ncy) / nfy;
+        for(int u = 0; u < size.width; u++){
+            // viewing ray in rectified camera frame
+            double x, y, z;
+            if(mode == RECTIFY_LONGLAT){
+                double lon = (u - ncx) / nfx;
+                x = -std::cos(lon);
+                y = -std::sin(lon) * std::cos(lat);
+                z = std::sin(lon) * std::sin(lat);
+            }
+            else{
+                x = (u - ncx) / nfx;
+                y = (v - ncy) / nfy;
+                z = 1.0;
+            }
+
+            // rotate back to raw camera frame, R^T * ray
+            double X = r.at<double>(0, 0) * x + r.at<double>(1, 0) * y + r.at<double>(2, 0) * z;
+            double Y = r.at<double>(0, 1) * x + r.at<double>(1, 1) * y + r.at<double>(2, 1) * z;
+            double Z = r.at<double>(0, 2) * x + r.at<double>(1, 2) * y + r.at<double>(2, 2) * z;
+
+            // Mei model: project to unit sphere, then to normalized plane shifted by xi
+            double norm = std::sqrt(X * X + Y * Y + Z * Z);
+            double zs = Z / norm + xiv;
+            if(zs <= 1e-6){
+                mx[u] = -1.f;
+                my[u] = -1.f;
+                continue;
+            }
+            double xu = X / norm / zs, yu = Y / norm / zs;
+            double r2 = xu * xu + yu * yu, r4 = r2 * r2;
+            double radial = 1 + k1 * r2 + k2 * r4;
+            double xd = radial * xu + 2 * p1 * xu * yu + p2 * (r2 + 2 * xu * xu);
+            double yd = radial * yu + p1 * (r2 + 2 * yu * yu) + 2 * p2 * xu * yu;
+            mx[u] = (float)(fx * xd + s * yd + cx);
+            my[u] = (float)(fy * yd + cy);
+        }
+    }
+}
+
+StereoRectifier::StereoRectifier(void){
+}
+
+StereoRectifier::~StereoRectifier(){
+    releaseCache();
+}
+
+bool StereoRectifier::init(const std::vector<cv::Mat> &leftParams, const std::vector<cv::Mat> &rightParams,
+                           cv::Size calibSize, cv::Size rawSize, cv::Size rectSize, int mode, double hFov,
+                           const std::string &cacheDir, cv::Rect roi, int decimation){
+    if(leftParams.size() < 6 || rightParams.size() < 6)
+        return false;
+    if(calibSize.width <= 0 || calibSize.height <= 0 || rectSize.width <= 0 || rectSize.height <= 0)
+        return false;
+    for(int i = 0; i < 4; i++)
+        if(leftParams[i].empty() || rightParams[i].empty())
+            return false;
+
+    for(int i = 0; i < 2; i++){
+        for(int j = 0; j < 2; j++)
+            m_map[i][j].release();
+        m_viewMap[i].release();
+    }
+    m_viewKfe.release();
+    releaseCache();
+
+    // region of the full rectified image actually built, at 1 / decimation resolution
+    cv::Rect full(0, 0, rectSize.width, rectSize.height);
+    roi = roi.area() > 0 ? (roi & full) : full;
+    decimation = std::max(1, decimation);
+    if(roi.width < decimation || roi.height < decimation)
+        return false;
+
+    m_mode = mode == RECTIFY_PERSPECTIVE ? RECTIFY_PERSPECTIVE : RECTIFY_LONGLAT;
+    m_rectSize = cv::Size(roi.width / decimation, roi.height / decimation);
+
+    const cv::Mat &translation = leftParams[4].empty() ? rightParams[4] : leftParams[4];
+    m_baseline = translation.empty() ? 0 : cv::norm(translation);
+
+    // rectified intrinsic matrix
+    double rx = (double)rectSize.width / calibSize.width, ry = (double)rectSize.height / calibSize.height;
+    if(m_mode == RECTIFY_PERSPECTIVE){
+        double f = rectSize.width / 2.0 / std::tan(hFov * CV_PI / 360.0);
+        m_kfe = (cv::Mat_<double>(3, 3) << f, 0, (rectSize.width - 1) / 2.0,
+                                           0, f, (rectSize.height - 1) / 2.0,
+                                           0, 0, 1);
+    }
+    else if(!leftParams[5].empty()){
+        m_kfe = scaleIntrinsic(leftParams[5], rx, ry);
+    }
+    else{
+        m_kfe = (cv::Mat_<double>(3, 3) << rectSize.width / CV_PI, 0, 0,
+                                           0, rectSize.height / CV_PI, 0,
+                                           0, 0, 1);
+    }
+
+    // output pixel u maps to full pixel roi.x + u * decimation + (decimation - 1) / 2, both models are linear in it
+    if(roi != full || decimation > 1){
+        double shift = (decimation - 1) / 2.0;
+        m_kfe.at<double>(0, 2) = (m_kfe.at<double>(0, 2) - roi.x - shift) / decimation;
+        m_kfe.at<double>(1, 2) = (m_kfe.at<double>(1, 2) - roi.y - shift) / decimation;
+        m_kfe.at<double>(0, 0) /= decimation;
+        m_kfe.at<double>(0, 1) /= decimation;
+        m_kfe.at<double>(1, 1) /= decimation;
+    }
+
+    // raw intrinsic matrix follows raw frame size
+    double sx = (double)rawSize.width / calibSize.width, sy = (double)rawSize.height / calibSize.height;
+    m_leftParams.assign(leftParams.begin(), leftParams.begin() + 4);
+    m_leftParams[0] = scaleIntrinsic(leftParams[0], sx, sy);
+
+    const std::vector<cv::Mat> *params[2] = {&leftParams, &rightParams};
+    uint64_t key = 14695981039346656037ULL;
+    std::string cacheFile;
+    if(!cacheDir.empty()){
+        int32_t sizes[] = {MAP_CACHE_VERSION, calibSize.width, calibSize.height, rawSize.width, rawSize.height,
+                           m_rectSize.width, m_rectSize.height, m_mode};
+        key = hashBytes(key, sizes, sizeof(sizes));
+        key = hashMat(key, m_kfe);
+        for(int i = 0; i < 2; i++)
+            for(int j = 0; j < 4; j++)
+                key = hashMat(key, (*params[i])[j]);
+        // one file per key, cameras sharing the directory never replace each other's maps
+        char name[32];
+        snprintf(name, sizeof(name), "/%016" PRIx64 ".map", key);
+        cacheFile = cacheDir + name;
+        if(loadCache(cacheFile, key))
+            return true;
+    }
+
+    for(int i = 0; i < 2; i++){
+        cv::Mat K = scaleIntrinsic((*params[i])[0], sx, sy), mapX, mapY;
+        initMeiRectifyMap(K, (*params[i])[1], (*params[i])[2], (*params[i])[3], m_kfe, m_rectSize, m_mode,
+                          mapX, mapY);
+        cv::convertMaps(mapX, mapY, m_map[i][0], m_map[i][1], CV_16SC2);
+    }
+
+    if(!cacheFile.empty() && (mkdir(cacheDir.c_str(), 0777) == 0 || errno == EEXIST))
+        saveCache(cacheFile, key);
+    return true;
+}
+
+bool StereoRectifier::rectify(const cv::Mat &raw, cv::Mat &left, cv::Mat &right, bool gray, cv::Mat *view) const{
+    if(!isReady() || raw.empty())
+        return false;
+
+    // raw frame keeps the right image at the left half, see example_getRawFrame.cc
+    int halfWidth = raw.cols / 2;
+    cv::Mat rawRight = raw(cv::Rect(0, 0, halfWidth, raw.rows));
+    cv::Mat rawLeft = raw(cv::Rect(halfWidth, 0, halfWidth, raw.rows));
+    bool hasView = view && !m_viewMap[0].empty();
+
+    if(raw.depth() != CV_8U || (raw.channels() != 3 && raw.channels() != 1)){
+        cv::remap(rawLeft, left, m_map[0][0], m_map[0][1], cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+        cv::remap(rawRight, right, m_map[1][0], m_map[1][1], cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+        if(hasView)
+            cv::remap(rawLeft, *view, m_viewMap[0], m_viewMap[1], cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+        return true;
+    }
+
+    int type = gray ? CV_8UC1 : raw.type();
+    left.create(m_rectSize, type);
+    right.create(m_rectSize, type);
+    std::vector<RemapViewType> views;
+    RemapViewType leftView = {rawLeft, &m_map[0][0], &m_map[0][1], &left};
+    RemapViewType rightView = {rawRight, &m_map[1][0], &m_map[1][1], &right};
+    views.push_back(leftView);
+    views.push_back(rightView);
+    if(hasView){
+        view->create(m_viewMap[0].size(), type);
+        RemapViewType extraView = {rawLeft, &m_viewMap[0], &m_viewMap[1], view};
+        views.push_back(extraView);
+    }
+    remapViews(views, raw.channels(), gray);
+    return true;
+}
+
+bool StereoRectifier::initPerspectiveView(cv::Size size, double hFov){
+    if(m_leftParams.size() < 4 || size.width <= 0 || size.height <= 0)
+        return false;
+
+    double f = size.width / 2.0 / std::tan(hFov * CV_PI / 360.0);
+    m_viewKfe = (cv::Mat_<double>(3, 3) << f, 0, (size.width - 1) / 2.0,
+                                           0, f, (size.height - 1) / 2.0,
+                                           0, 0, 1);
+    cv::Mat mapX, mapY;
+    initMeiRectifyMap(m_leftParams[0], m_leftParams[1], m_leftParams[2], m_leftParams[3], m_viewKfe, size,
+                      RECTIFY_PERSPECTIVE, mapX, mapY);
+    cv::convertMaps(mapX, mapY, m_viewMap[0], m_viewMap[1], CV_16SC2);
+    return true;
+}
+
+cv::Mat StereoRectifier::getViewIntrinsic(void) const{
+    return m_viewKfe.clone();
+}
+
+bool StereoRectifier::isReady(void) const{
+    return !m_map[0][0].empty() && !m_map[1][0].empty();
+}
+
+int StereoRectifier::getMode(void) const{
+    return m_mode;
+}
+
+double StereoRectifier::getBaseline(void) const{
+    return m_baseline;
+}
+
+cv::Size StereoRectifier::getRectFrameSize(void) const{
+    return m_rectSize;
+}
+
+cv::Mat StereoRectifier::getRectIntrinsic(void) const{
+    return m_kfe.clone();
+}
+
+bool StereoRectifier::isCached(void) const{
+    return m_cacheData != nullptr;
+}
+
+bool StereoRectifier::loadCache(const std::string &fileName, uint64_t key){
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+
+    struct stat info;
+    size_t size = mapCacheSize(m_rectSize);
+    if(fstat(fd, &info) != 0 || (size_t)info.st_size != size){
+        close(fd);
+        return false;
+    }
+    void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(data == MAP_FAILED)
+        return false;
+
+    const MapCacheHeaderType *header = (const MapCacheHeaderType*)data;
+    if(memcmp(header->magic, MAP_CACHE_MAGIC, sizeof(MAP_CACHE_MAGIC)) != 0 || header->version != MAP_CACHE_VERSION ||
+       header->width != m_rectSize.width || header->height != m_rectSize.height || header->key != key){
+        munmap(data, size);
+        return false;
+    }
+
+    // maps are read-only headers into the mapping, nothing is copied
+    m_cacheData = data;
+    m_cacheSize = size;
+    unsigned char *cursor = (unsigned char*)data + sizeof(MapCacheHeaderType);
+    for(int i = 0; i < 2; i++){
+        m_map[i][0] = cv::Mat(m_rectSize, CV_16SC2, cursor);
+        cursor += m_rectSize.area() * 2 * sizeof(int16_t);
+        m_map[i][1] = cv::Mat(m_rectSize, CV_16UC1, cursor);
+        cursor += m_rectSize.area() * sizeof(uint16_t);
+    }
+    return true;
+}
+
+bool StereoRectifier::saveCache(const std::string &fileName, uint64_t key) const{
+    // write a unique temporary file and rename it, a reader never maps a half written cache and processes
+    // saving the same maps at once do not write into one file
+    std::string tempName = fileName + ".XXXXXX";
+    int fd = mkstemp(&tempName[0]);
+    if(fd < 0)
+        return false;
+    FILE *file = fdopen(fd, "wb");
+    if(fchmod(fd, 0644) != 0 || !file){
+        if(file)
+            fclose(file);
+        else
+            close(fd);
+        remove(tempName.c_str());
+        return false;
+    }
+
+    MapCacheHeaderType header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAP_CACHE_MAGIC, sizeof(MAP_CACHE_MAGIC));
+    header.version = MAP_CACHE_VERSION;
+    header.width = m_rectSize.width;
+    header.height = m_rectSize.height;
+    header.key = key;
+
+    bool isDone = fwrite(&header, sizeof(header), 1, file) == 1;
+    for(int i = 0; i < 2 && isDone; i++){
+        for(int j = 0; j < 2 && isDone; j++){
+            const cv::Mat &map = m_map[i][j];
+            for(int row = 0; row < map.rows && isDone; row++)
+                isDone = fwrite(map.ptr(row), map.cols * map.elemSize(), 1, file) == 1;
+        }
+    }
+    isDone = fclose(file) == 0 && isDone;
+    if(!isDone || rename(tempName.c_str(), fileName.c_str()) != 0){
+        remove(tempName.c_str());
+        return false;
+    }
+    return true;
+}
+
+void StereoRectifier::releaseCache(void){
+    if(!m_cacheData)
+        return;
+    for(int i = 0; i < 2; i++)
+        for(int j = 0; j < 2; j++)
+            m_map[i][j].release();
+    munmap(m_cacheData, m_cacheSize);
+    m_cacheData = nullptr;
+    m_cacheSize = 0;
+}
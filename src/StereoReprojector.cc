@@ -0,0 +1,230 @@
+/**
+  * @file StereoReprojector.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement disparity reprojection APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "StereoReprojector.hpp"
+#include <algorithm>
+#include <cmath>
+
+StereoReprojector::StereoReprojector(void){
+}
+
+StereoReprojector::~StereoReprojector(){
+}
+
+bool StereoReprojector::init(const StereoRectifier &rectifier, int numDisparities){
+    if(!rectifier.isReady())
+        return false;
+    return init(rectifier.getMode(), rectifier.getRectIntrinsic(), rectifier.getBaseline(),
+                rectifier.getRectFrameSize(), numDisparities);
+}
+
+bool StereoReprojector::init(int mode, const cv::Mat &kfe, double baseline, cv::Size size, int numDisparities){
+    if(kfe.rows != 3 || kfe.cols != 3 || size.area() <= 0 || numDisparities <= 0)
+        return false;
+
+    cv::Mat k;
+    kfe.convertTo(k, CV_64F);
+    double fx = k.at<double>(0, 0), fy = k.at<double>(1, 1);
+    double cx = k.at<double>(0, 2), cy = k.at<double>(1, 2);
+
+    m_mode = mode == RECTIFY_PERSPECTIVE ? RECTIFY_PERSPECTIVE : RECTIFY_LONGLAT;
+    m_baseline = (float)baseline;
+    m_size = size;
+
+    // raw disparity has 4 fractional bits, 0 is invalid
+    m_lut.assign(numDisparities * 16 + 1, 0.f);
+    for(size_t d = 1; d < m_lut.size(); d++){
+        double angle = d / 16.0 / fx;
+        m_lut[d] = (float)(baseline * (m_mode == RECTIFY_LONGLAT ? std::cos(angle) / std::sin(angle) : 1.0 / angle));
+    }
+
+    m_colA.resize(size.width);
+    m_colS.resize(size.width);
+    m_colC.resize(size.width);
+    for(int u = 0; u < size.width; u++){
+        double lon = (u - cx) / fx;
+        if(m_mode == RECTIFY_LONGLAT){
+            m_colA[u] = (float)-std::cos(lon);
+            m_colS[u] = (float)std::sin(lon);
+            m_colC[u] = (float)(baseline * std::cos(lon));
+        }
+        else{
+            m_colA[u] = (float)lon;
+            m_colS[u] = 1.f;
+            m_colC[u] = 0.f;
+        }
+    }
+
+    m_rowP.resize(size.height);
+    m_rowR.resize(size.height);
+    for(int v = 0; v < size.height; v++){
+        double lat = (v - cy) / fy;
+        m_rowP[v] = m_mode == RECTIFY_LONGLAT ? (float)-std::cos(lat) : (float)lat;
+        m_rowR[v] = m_mode == RECTIFY_LONGLAT ? (float)std::sin(lat) : 1.f;
+    }
+
+    // the row kernel may write whole vectors past the last column
+    m_rowX.resize(size.width + REPROJECT_ROW_PADDING);
+    m_rowY.resize(m_rowX.size());
+    m_rowZ.resize(m_rowX.size());
+    m_rowIndex.resize(m_rowX.size());
+    return true;
+}
+
+bool StereoReprojector::setTransform(const cv::Mat &transform){
+    if(transform.empty()){
+        m_transform.clear();
+        return true;
+    }
+    if((transform.rows != 3 && transform.rows != 4) || transform.cols != 4 || transform.channels() != 1)
+        return false;
+
+    cv::Mat t;
+    transform.convertTo(t, CV_32F);
+    m_transform.resize(12);
+    for(int i = 0; i < 3; i++)
+        for(int j = 0; j < 4; j++)
+            m_transform[i * 4 + j] = t.at<float>(i, j);
+    return true;
+}
+
+bool StereoReprojector::prepare(const cv::Mat &disparity, cv::Mat *depth) const{
+    if(m_lut.empty() || disparity.empty() || disparity.size() != m_size || disparity.type() != CV_16SC1)
+        return false;
+    if(depth)
+        depth->create(m_size, CV_32FC1);
+    return true;
+}
+
+ReprojectRowArgsType StereoReprojector::rowArgs(const cv::Mat &disparity, int v, float minDepth, float maxDepth) const{
+    ReprojectRowArgsType args;
+    args.disparity = disparity.ptr<short>(v);
+    args.width = m_size.width;
+    args.lut = m_lut.data();
+    args.lutSize = (int)m_lut.size();
+    args.colA = m_colA.data();
+    args.colS = m_colS.data();
+    args.colC = m_colC.data();
+    args.rowP = m_rowP[v];
+    args.rowR = m_rowR[v];
+    args.minDepth = minDepth;
+    args.maxDepth = maxDepth;
+    args.transform = m_transform.empty() ? nullptr : m_transform.data();
+    return args;
+}
+
+bool StereoReprojector::reproject(const cv::Mat &disparity, const cv::Mat &color, float minDepth, float maxDepth,
+                                  cv::Mat *depth, std::vector<PCLType> *cloud) const{
+    if(!prepare(disparity, depth))
+        return false;
+
+    bool hasColor = !color.empty() && color.size() == m_size && color.type() == CV_8UC3;
+    bool hasGray = !color.empty() && color.size() == m_size && color.type() == CV_8UC1;
+    const float *x = m_rowX.data(), *y = m_rowY.data(), *z = m_rowZ.data();
+    const int *index = m_rowIndex.data();
+    if(cloud){
+        cloud->clear();
+        cloud->reserve(m_size.area());
+    }
+
+    for(int v = 0; v < m_size.height; v++){
+        float *dep = depth ? depth->ptr<float>(v) : nullptr;
+        int count = reprojectRow(rowArgs(disparity, v, minDepth, maxDepth), dep, m_rowX.data(), m_rowY.data(),
+                                 m_rowZ.data(), m_rowIndex.data());
+        if(!cloud)
+            continue;
+
+        for(int i = 0; i < count; i++){
+            PCLType point;
+            point.pts = cv::Vec3f(x[i], y[i], z[i]);
+            if(hasColor){
+                point.clr = color.ptr<cv::Vec3b>(v)[index[i]];
+            }
+            else if(hasGray){
+                unsigned char g = color.ptr<unsigned char>(v)[index[i]];
+                point.clr = cv::Vec3b(g, g, g);
+            }
+            else{
+                point.clr = cv::Vec3b(255, 255, 255);
+            }
+            cloud->push_back(point);
+        }
+    }
+    return true;
+}
+
+bool StereoReprojector::reproject(const cv::Mat &disparity, const cv::Mat &color, float minDepth, float maxDepth,
+                                  cv::Mat *depth, PointCloudSoAType &cloud) const{
+    cloud.count = 0;
+    if(!prepare(disparity, depth))
+        return false;
+
+    bool hasColor = !color.empty() && color.size() == m_size && color.type() == CV_8UC3;
+    bool hasGray = !color.empty() && color.size() == m_size && color.type() == CV_8UC1;
+    cloud.reserve(m_size.area() + REPROJECT_ROW_PADDING);
+    int *index = m_rowIndex.data();
+
+    // rows are compacted straight into the cloud arrays
+    size_t count = 0;
+    for(int v = 0; v < m_size.height; v++){
+        float *dep = depth ? depth->ptr<float>(v) : nullptr;
+        int rowCount = reprojectRow(rowArgs(disparity, v, minDepth, maxDepth), dep,
+                                    &cloud.x[count], &cloud.y[count], &cloud.z[count], index);
+        uint32_t *clr = &cloud.color[count];
+        for(int i = 0; i < rowCount; i++){
+            if(hasColor){
+                const cv::Vec3b &c = color.ptr<cv::Vec3b>(v)[index[i]];
+                clr[i] = PointCloudSoAType::packColor(c[0], c[1], c[2]);
+            }
+            else if(hasGray){
+                unsigned char g = color.ptr<unsigned char>(v)[index[i]];
+                clr[i] = PointCloudSoAType::packColor(g, g, g);
+            }
+            else{
+                clr[i] = PointCloudSoAType::packColor(255, 255, 255);
+            }
+        }
+        count += rowCount;
+    }
+    cloud.count = count;
+    return true;
+}
+
+bool StereoReprojector::computeDepth(const cv::Mat &disparity, float minDepth, float maxDepth,
+                                     cv::Mat &depth, cv::Mat *mask) const{
+    if(!prepare(disparity, nullptr))
+        return false;
+    depth.create(m_size, CV_16UC1);
+    if(mask)
+        mask->create(m_size, CV_8UC1);
+
+    maxDepth = std::min(maxDepth, 65.535f);
+    int lutSize = (int)m_lut.size();
+    cv::parallel_for_(cv::Range(0, m_size.height), [&](const cv::Range &range){
+        for(int v = range.start; v < range.end; v++){
+            const short *disp = disparity.ptr<short>(v);
+            unsigned short *dep = depth.ptr<unsigned short>(v);
+            unsigned char *valid = mask ? mask->ptr<unsigned char>(v) : nullptr;
+            for(int u = 0; u < m_size.width; u++){
+                int d = disp[u];
+                float r = 0;
+                bool isValid = false;
+                // holes have no disparity, they stay invalid whatever minDepth is
+                if(d > 0 && d < lutSize){
+                    r = m_colS[u] * m_lut[d] - m_colC[u];
+                    isValid = r >= minDepth && r <= maxDepth;
+                }
+                dep[u] = isValid ? (unsigned short)(r * 1000.f + 0.5f) : 0;
+                if(valid)
+                    valid[u] = isValid ? 255 : 0;
+            }
+        }
+    });
+    return true;
+}
@@ -0,0 +1,91 @@
+/**
+  * @file TemporalFilter.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement temporal disparity filter APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "TemporalFilter.hpp"
+#include <algorithm>
+#include <cmath>
+
+TemporalFilter::TemporalFilter(void){
+}
+
+TemporalFilter::~TemporalFilter(){
+}
+
+bool TemporalFilter::setParams(float alpha, float delta, int persistence){
+    if(!isValidParams(alpha, delta, persistence))
+        return false;
+    m_alpha = alpha;
+    m_delta = delta * 16;
+    m_persistence = persistence;
+    return true;
+}
+
+bool TemporalFilter::isValidParams(float alpha, float delta, int persistence){
+    return alpha > 0 && alpha <= 1 && delta >= 0 && persistence >= 0 && persistence <= 255;
+}
+
+void TemporalFilter::reset(void){
+    m_state.release();
+    m_confidence.release();
+    m_missing.release();
+}
+
+bool TemporalFilter::apply(cv::Mat &disparity){
+    if(disparity.empty() || disparity.type() != CV_16SC1)
+        return false;
+    if(m_state.size() != disparity.size()){
+        m_state.create(disparity.size(), CV_32FC1);
+        m_confidence.create(disparity.size(), CV_8UC1);
+        m_missing.create(disparity.size(), CV_8UC1);
+        m_state.setTo(cv::Scalar(0));
+        m_confidence.setTo(cv::Scalar(0));
+        m_missing.setTo(cv::Scalar(0));
+    }
+
+    // weight of the new disparity by confidence, fresh pixels follow the input
+    float weight[256];
+    for(int c = 0; c < 256; c++)
+        weight[c] = std::max(m_alpha, 1.f / (c + 1));
+
+    cv::parallel_for_(cv::Range(0, disparity.rows), [&](const cv::Range &range){
+        for(int v = range.start; v < range.end; v++){
+            short *disp = disparity.ptr<short>(v);
+            float *state = m_state.ptr<float>(v);
+            unsigned char *confidence = m_confidence.ptr<unsigned char>(v);
+            unsigned char *missing = m_missing.ptr<unsigned char>(v);
+            for(int u = 0; u < disparity.cols; u++){
+                float d = disp[u], s = state[u];
+                if(d <= 0){
+                    // hold the filtered value through short dropouts
+                    if(s > 0 && missing[u] < m_persistence){
+                        missing[u]++;
+                        disp[u] = (short)(s + 0.5f);
+                    }
+                    else{
+                        state[u] = 0;
+                        confidence[u] = 0;
+                    }
+                    continue;
+                }
+                missing[u] = 0;
+                if(s <= 0 || std::fabs(d - s) > m_delta){
+                    state[u] = d;
+                    confidence[u] = 0;
+                    continue;
+                }
+                unsigned char c = confidence[u];
+                s += weight[c] * (d - s);
+                state[u] = s;
+                confidence[u] = c < 255 ? c + 1 : 255;
+                disp[u] = (short)(s + 0.5f);
+            }
+        }
+    });
+    return true;
+}
@@ -0,0 +1,324 @@
+/**
+  * @file V4l2Capture.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement direct V4L2 capture APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "V4l2Capture.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/videodev2.h>
+
+static int xioctl(int fd, unsigned long request, void *arg){
+    int result;
+    do{
+        result = ioctl(fd, request, arg);
+    }while(result == -1 && errno == EINTR);
+    return result;
+}
+
+static int64_t clockMicroseconds(clockid_t clock){
+    struct timespec now;
+    clock_gettime(clock, &now);
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+// wall clock minus monotonic clock, the monotonic reads around the wall clock read bound the error
+static int64_t clockOffset(void){
+    int64_t before = clockMicroseconds(CLOCK_MONOTONIC);
+    int64_t wall = clockMicroseconds(CLOCK_REALTIME);
+    int64_t after = clockMicroseconds(CLOCK_MONOTONIC);
+    return wall - (before + after) / 2;
+}
+
+V4l2Capture::V4l2Capture(void){
+}
+
+V4l2Capture::~V4l2Capture(){
+    close();
+}
+
+bool V4l2Capture::open(const std::string &device, cv::Size frameSize, double frameRate, int bufferCount){
+    close();
+    m_fd = ::open(device.c_str(), O_RDWR | O_NONBLOCK);
+    if(m_fd < 0)
+        return false;
+    m_device = device;
+
+    struct v4l2_capability capability;
+    memset(&capability, 0, sizeof(capability));
+    if(xioctl(m_fd, VIDIOC_QUERYCAP, &capability) < 0 || !(capability.capabilities & V4L2_CAP_VIDEO_CAPTURE) ||
+       !(capability.capabilities & V4L2_CAP_STREAMING) || !setFormat(frameSize)){
+        close();
+        return false;
+    }
+    setFrameRate(frameRate);
+
+    struct v4l2_requestbuffers request;
+    memset(&request, 0, sizeof(request));
+    request.count = bufferCount < 2 ? 2 : bufferCount;
+    request.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    request.memory = V4L2_MEMORY_MMAP;
+    if(xioctl(m_fd, VIDIOC_REQBUFS, &request) < 0 || request.count < 2){
+        close();
+        return false;
+    }
+    for(uint32_t i = 0; i < request.count; i++){
+        struct v4l2_buffer buffer;
+        memset(&buffer, 0, sizeof(buffer));
+        buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buffer.memory = V4L2_MEMORY_MMAP;
+        buffer.index = i;
+        if(xioctl(m_fd, VIDIOC_QUERYBUF, &buffer) < 0){
+            close();
+            return false;
+        }
+        void *start = mmap(nullptr, buffer.length, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, buffer.m.offset);
+        if(start == MAP_FAILED){
+            close();
+            return false;
+        }
+        m_buffers.push_back({start, buffer.length});
+    }
+
+    m_hasExposure = true;
+    readExposure();
+    // auto exposure changes the value without us, the driver tells it through POLLPRI events
+    struct v4l2_event_subscription subscription;
+    memset(&subscription, 0, sizeof(subscription));
+    subscription.type = V4L2_EVENT_CTRL;
+    subscription.id = V4L2_CID_EXPOSURE_ABSOLUTE;
+    m_hasExposureEvents = m_hasExposure && xioctl(m_fd, VIDIOC_SUBSCRIBE_EVENT, &subscription) == 0;
+    return true;
+}
+
+void V4l2Capture::close(void){
+    if(m_fd < 0)
+        return;
+    stop();
+    for(const BufferType &buffer : m_buffers)
+        munmap(buffer.start, buffer.length);
+    m_buffers.clear();
+
+    // free the driver buffers so the next open can change the format
+    struct v4l2_requestbuffers request;
+    memset(&request, 0, sizeof(request));
+    request.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    request.memory = V4L2_MEMORY_MMAP;
+    xioctl(m_fd, VIDIOC_REQBUFS, &request);
+    ::close(m_fd);
+    m_fd = -1;
+}
+
+bool V4l2Capture::isOpened(void) const{
+    return m_fd >= 0;
+}
+
+bool V4l2Capture::start(void){
+    if(m_fd < 0)
+        return false;
+    if(m_isStreaming)
+        return true;
+    for(uint32_t i = 0; i < m_buffers.size(); i++){
+        struct v4l2_buffer buffer;
+        memset(&buffer, 0, sizeof(buffer));
+        buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buffer.memory = V4L2_MEMORY_MMAP;
+        buffer.index = i;
+        if(xioctl(m_fd, VIDIOC_QBUF, &buffer) < 0)
+            return false;
+    }
+    int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if(xioctl(m_fd, VIDIOC_STREAMON, &type) < 0)
+        return false;
+    m_isStreaming = true;
+    m_hasSequence = false;
+    return true;
+}
+
+bool V4l2Capture::stop(void){
+    if(m_fd < 0 || !m_isStreaming)
+        return false;
+    int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    xioctl(m_fd, VIDIOC_STREAMOFF, &type);
+    m_isStreaming = false;
+    return true;
+}
+
+bool V4l2Capture::isStreaming(void) const{
+    return m_isStreaming;
+}
+
+bool V4l2Capture::read(cv::Mat &frame, V4l2FrameInfoType &info, std::chrono::milliseconds timeout){
+    if(!m_isStreaming)
+        return false;
+
+    int64_t deadline = clockMicroseconds(CLOCK_MONOTONIC) + timeout.count() * 1000;
+    while(true){
+        struct pollfd descriptor = {m_fd, (short)(POLLIN | POLLPRI), 0};
+        int wait = (int)std::max<int64_t>(0, (deadline - clockMicroseconds(CLOCK_MONOTONIC) + 999) / 1000);
+        int ready = poll(&descriptor, 1, wait);
+        if(ready < 0 && errno == EINTR)
+            continue;
+        if(ready <= 0)
+            return false;
+        if(descriptor.revents & POLLPRI)
+            readEvents();
+        if(descriptor.revents & POLLIN)
+            break;
+        if(descriptor.revents & (POLLERR | POLLHUP | POLLNVAL))
+            return false;
+    }
+
+    struct v4l2_buffer buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buffer.memory = V4L2_MEMORY_MMAP;
+    if(xioctl(m_fd, VIDIOC_DQBUF, &buffer) < 0)
+        return false;
+    int64_t offset = clockOffset();
+
+    // the buffer goes back to the driver as soon as it is converted
+    bool isConverted = buffer.index < m_buffers.size() && !(buffer.flags & V4L2_BUF_FLAG_ERROR) &&
+                       convertFrame(m_buffers[buffer.index], buffer.bytesused, frame);
+    xioctl(m_fd, VIDIOC_QBUF, &buffer);
+    if(!isConverted)
+        return false;
+
+    int64_t monotonic;
+    info.isDriverStamp = (buffer.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC;
+    if(info.isDriverStamp)
+        monotonic = (int64_t)buffer.timestamp.tv_sec * 1000000 + buffer.timestamp.tv_usec;
+    else
+        monotonic = clockMicroseconds(CLOCK_MONOTONIC);
+    info.isStartOfExposure = (buffer.flags & V4L2_BUF_FLAG_TSTAMP_SRC_MASK) == V4L2_BUF_FLAG_TSTAMP_SRC_SOE;
+    info.monotonicStamp = std::chrono::microseconds(monotonic);
+    info.timeStamp = std::chrono::microseconds(monotonic + offset);
+
+    // end of frame stamps are taken after readout, the readout time of rolling shutters is not known here
+    if(m_hasExposure && !m_hasExposureEvents && monotonic - m_exposureTime >= 1000000)
+        readExposure();
+    info.exposure = std::chrono::microseconds(m_exposure);
+    info.exposureMidpoint = info.isStartOfExposure ? info.timeStamp + info.exposure / 2 : info.timeStamp - info.exposure / 2;
+
+    info.sequence = buffer.sequence;
+    info.dropped = m_hasSequence && buffer.sequence > m_lastSequence ? buffer.sequence - m_lastSequence - 1 : 0;
+    m_lastSequence = buffer.sequence;
+    m_hasSequence = true;
+    return true;
+}
+
+cv::Size V4l2Capture::getFrameSize(void) const{
+    return m_frameSize;
+}
+
+double V4l2Capture::getFrameRate(void) const{
+    return m_frameRate;
+}
+
+std::string V4l2Capture::getPixelFormat(void) const{
+    char fourcc[5] = {(char)(m_pixelFormat & 0xff), (char)((m_pixelFormat >> 8) & 0xff),
+                      (char)((m_pixelFormat >> 16) & 0xff), (char)((m_pixelFormat >> 24) & 0xff), 0};
+    return fourcc;
+}
+
+std::string V4l2Capture::getDevice(void) const{
+    return m_device;
+}
+
+bool V4l2Capture::setFormat(cv::Size frameSize){
+    const uint32_t formats[] = {V4L2_PIX_FMT_MJPEG, V4L2_PIX_FMT_YUYV, V4L2_PIX_FMT_GREY};
+    for(uint32_t pixelFormat : formats){
+        struct v4l2_format format;
+        memset(&format, 0, sizeof(format));
+        format.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        format.fmt.pix.width = frameSize.width;
+        format.fmt.pix.height = frameSize.height;
+        format.fmt.pix.pixelformat = pixelFormat;
+        format.fmt.pix.field = V4L2_FIELD_NONE;
+        // drivers replace a format they do not support by one they do
+        if(xioctl(m_fd, VIDIOC_S_FMT, &format) < 0 || format.fmt.pix.pixelformat != pixelFormat)
+            continue;
+        m_pixelFormat = pixelFormat;
+        m_frameSize = cv::Size(format.fmt.pix.width, format.fmt.pix.height);
+        // 0 for compressed formats, some drivers leave it 0 for packed ones too
+        size_t packedLine = (size_t)m_frameSize.width * (pixelFormat == V4L2_PIX_FMT_YUYV ? 2 : 1);
+        m_bytesPerLine = std::max<size_t>(format.fmt.pix.bytesperline, packedLine);
+        return true;
+    }
+    return false;
+}
+
+void V4l2Capture::setFrameRate(double frameRate){
+    struct v4l2_streamparm param;
+    memset(&param, 0, sizeof(param));
+    param.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if(frameRate > 0){
+        param.parm.capture.timeperframe.numerator = 1000;
+        param.parm.capture.timeperframe.denominator = (uint32_t)(frameRate * 1000 + 0.5);
+        xioctl(m_fd, VIDIOC_S_PARM, &param);
+    }
+    m_frameRate = 0;
+    if(xioctl(m_fd, VIDIOC_G_PARM, &param) == 0 && param.parm.capture.timeperframe.numerator > 0)
+        m_frameRate = (double)param.parm.capture.timeperframe.denominator / param.parm.capture.timeperframe.numerator;
+}
+
+void V4l2Capture::readExposure(void){
+    struct v4l2_control control;
+    memset(&control, 0, sizeof(control));
+    control.id = V4L2_CID_EXPOSURE_ABSOLUTE;
+    m_exposureTime = clockMicroseconds(CLOCK_MONOTONIC);
+    if(xioctl(m_fd, VIDIOC_G_CTRL, &control) != 0){
+        m_hasExposure = false;
+        m_exposure = 0;
+        return;
+    }
+    // unit is 100 microseconds
+    m_exposure = (int64_t)control.value * 100;
+}
+
+void V4l2Capture::readEvents(void){
+    struct v4l2_event event;
+    memset(&event, 0, sizeof(event));
+    while(xioctl(m_fd, VIDIOC_DQEVENT, &event) == 0){
+        if(event.type == V4L2_EVENT_CTRL && event.id == V4L2_CID_EXPOSURE_ABSOLUTE &&
+           (event.u.ctrl.changes & V4L2_EVENT_CTRL_CH_VALUE))
+            m_exposure = event.u.ctrl.value * 100;
+    }
+}
+
+bool V4l2Capture::convertFrame(const BufferType &buffer, size_t bytesUsed, cv::Mat &frame) const{
+    int width = m_frameSize.width, height = m_frameSize.height;
+    switch(m_pixelFormat){
+    case V4L2_PIX_FMT_MJPEG:{
+        if(bytesUsed == 0 || bytesUsed > buffer.length)
+            return false;
+        cv::Mat jpeg(1, (int)bytesUsed, CV_8UC1, buffer.start);
+        cv::imdecode(jpeg, cv::IMREAD_COLOR, &frame);
+        return !frame.empty();
+    }
+    // padded rows are skipped through the step of the image
+    case V4L2_PIX_FMT_YUYV:
+        if(bytesUsed < m_bytesPerLine * height || bytesUsed > buffer.length)
+            return false;
+        cv::cvtColor(cv::Mat(height, width, CV_8UC2, buffer.start, m_bytesPerLine), frame, cv::COLOR_YUV2BGR_YUYV);
+        return true;
+    case V4L2_PIX_FMT_GREY:
+        if(bytesUsed < m_bytesPerLine * height || bytesUsed > buffer.length)
+            return false;
+        cv::cvtColor(cv::Mat(height, width, CV_8UC1, buffer.start, m_bytesPerLine), frame, cv::COLOR_GRAY2BGR);
+        return true;
+    default:
+        return false;
+    }
+}
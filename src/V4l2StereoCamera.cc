@@ -0,0 +1,169 @@
+/**
+  * @file V4l2StereoCamera.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement V4L2 stereo camera APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "V4l2StereoCamera.hpp"
+#include <thread>
+
+// getRawFrame() waits in slices of this length, m_frameLock is free between them
+static const std::chrono::milliseconds READ_SLICE(20);
+static const std::chrono::milliseconds READ_TIMEOUT(1000);
+
+V4l2StereoCamera::V4l2StereoCamera(std::string device, double frameRate, cv::Size frameSize)
+    : HostStereoCamera("V4l2StereoCamera"), m_controlWaiters(0){
+    m_device = device;
+    m_frameRate = frameRate;
+    m_frameSize = frameSize;
+    if(reopen())
+        m_log->runTimeInfo("Open %s, %s %dx%d at %.1f fps.", device.c_str(), m_capture.getPixelFormat().c_str(),
+                           m_capture.getFrameSize().width, m_capture.getFrameSize().height, m_capture.getFrameRate());
+    else
+        m_log->runTimeError("Open %s failed!", device.c_str());
+}
+
+V4l2StereoCamera::V4l2StereoCamera(int deviceNode, double frameRate, cv::Size frameSize)
+    : V4l2StereoCamera("/dev/video" + std::to_string(deviceNode), frameRate, frameSize){
+}
+
+V4l2StereoCamera::~V4l2StereoCamera(){
+    m_capture.close();
+}
+
+bool V4l2StereoCamera::reopen(void){
+    bool isStreaming = m_capture.isStreaming();
+    if(!m_capture.open(m_device, m_frameSize, m_frameRate))
+        return false;
+    if(m_capture.getFrameSize() != m_frameSize)
+        m_log->runTimeWarning("%s does not support %dx%d, using %dx%d.", m_device.c_str(), m_frameSize.width,
+                              m_frameSize.height, m_capture.getFrameSize().width, m_capture.getFrameSize().height);
+    return !isStreaming || m_capture.start();
+}
+
+std::unique_lock<std::mutex> V4l2StereoCamera::lockControl(void){
+    m_controlWaiters++;
+    std::unique_lock<std::mutex> lock(m_frameLock);
+    m_controlWaiters--;
+    return lock;
+}
+
+bool V4l2StereoCamera::isOpened(void){
+    return m_capture.isOpened();
+}
+
+bool V4l2StereoCamera::setRawFrameRate(int frameRate){
+    if(frameRate <= 0)
+        return false;
+    std::unique_lock<std::mutex> lock = lockControl();
+    m_frameRate = frameRate;
+    return reopen();
+}
+
+bool V4l2StereoCamera::setRawFrameSize(cv::Size frameSize){
+    if(frameSize.width < 2 || frameSize.height < 1)
+        return false;
+    std::unique_lock<std::mutex> lock = lockControl();
+    m_frameSize = frameSize;
+    return reopen();
+}
+
+float V4l2StereoCamera::getRawFrameRate(void) const{
+    double frameRate = m_capture.getFrameRate();
+    return (float)(frameRate > 0 ? frameRate : m_frameRate);
+}
+
+cv::Size V4l2StereoCamera::getRawFrameSize(void) const{
+    return m_capture.isOpened() ? m_capture.getFrameSize() : m_frameSize;
+}
+
+bool V4l2StereoCamera::getRawFrame(cv::Mat &frame, std::chrono::microseconds &timeStamp){
+    V4l2FrameInfoType info;
+    if(!getRawFrame(frame, info))
+        return false;
+    timeStamp = info.timeStamp;
+    return true;
+}
+
+bool V4l2StereoCamera::getRawFrame(cv::Mat &frame, V4l2FrameInfoType &info){
+    // the lock is held for one slice at a time, so stopCapture() and the setters do not wait for a frame
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + READ_TIMEOUT;
+    while(true){
+        while(m_controlWaiters.load() > 0)
+            std::this_thread::yield();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(m_frameLock);
+            if(!m_capture.isStreaming()){
+                m_log->debugTimeWarning("Capture is not started!");
+                return false;
+            }
+            if(m_capture.read(frame, info, READ_SLICE))
+                break;
+        }
+        // a read failing before its slice is over is a device error, not a timeout
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if(now - start < READ_SLICE / 2 || now >= deadline)
+            return false;
+    }
+    if(info.dropped > 0)
+        m_log->debugTimeWarning("Driver dropped %u frames before frame %u.", info.dropped, info.sequence);
+    std::lock_guard<std::mutex> lock(m_infoLock);
+    m_lastInfo = info;
+    return true;
+}
+
+V4l2FrameInfoType V4l2StereoCamera::getLastFrameInfo(void){
+    std::lock_guard<std::mutex> lock(m_infoLock);
+    return m_lastInfo;
+}
+
+std::string V4l2StereoCamera::getPixelFormat(void) const{
+    return m_capture.getPixelFormat();
+}
+
+bool V4l2StereoCamera::getStereoFrame(cv::Mat &left, cv::Mat &right, std::chrono::microseconds &timeStamp){
+    cv::Mat frame;
+    if(!getRawFrame(frame, timeStamp))
+        return false;
+    int halfWidth = frame.cols / 2;
+    frame(cv::Rect(0, 0, halfWidth, frame.rows)).copyTo(right);
+    frame(cv::Rect(halfWidth, 0, halfWidth, frame.rows)).copyTo(left);
+    return true;
+}
+
+bool V4l2StereoCamera::startCapture(bool udpFlag, bool shmFlag){
+    if(udpFlag || shmFlag)
+        m_log->runTimeWarning("V4L2 camera does not send frames by udp or share memory!");
+    std::unique_lock<std::mutex> lock = lockControl();
+    if(!m_capture.start()){
+        m_log->runTimeError("Start streaming %s failed!", m_device.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool V4l2StereoCamera::stopCapture(void){
+    std::unique_lock<std::mutex> lock = lockControl();
+    return m_capture.stop();
+}
+
+bool V4l2StereoCamera::startStereoCompute(void){
+    m_log->runTimeWarning("V4L2 camera does not compute depth, use StereoPipeline!");
+    return false;
+}
+
+bool V4l2StereoCamera::stopStereoCompute(void){
+    return false;
+}
+
+bool V4l2StereoCamera::getDepthFrame(cv::Mat &depth, bool color, std::chrono::microseconds &timeStamp){
+    return false;
+}
+
+bool V4l2StereoCamera::getPointCloud(std::vector<PCLType> &pcl, std::chrono::microseconds &timeStamp){
+    return false;
+}
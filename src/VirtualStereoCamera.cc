@@ -0,0 +1,416 @@
+/**
+  * @file VirtualStereoCamera.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement virtual stereo camera APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "VirtualStereoCamera.hpp"
+#include "UnitreeCameraSDK.hpp"
+#include "V4l2StereoCamera.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+// synthetic rig and scene, unit is meter, x right, y down, z forward, right camera at (BASELINE, 0, 0)
+static const double BASELINE = 0.03;
+static const double FOCAL = 390;        // at CALIB_SIZE, xi = 1 sees about 100 degree off axis at the image edge
+static const double FLOOR_Y = 0.3;
+static const double WALL_Z = 2.0;
+static const double BALL_RADIUS = 0.1;
+
+enum SceneSurface{
+    SURFACE_NONE  = 0,
+    SURFACE_FLOOR = 1,
+    SURFACE_WALL  = 2,
+    SURFACE_BALL  = 3,
+};
+
+static void ballCenter(double time, double center[3]){
+    center[0] = 0.15 * std::sin(time * 1.5);
+    center[1] = 0.15;
+    center[2] = 0.6;
+}
+
+// nearest surface along a unit ray, t is the distance from origin
+static int intersectScene(const double origin[3], const double dir[3], const double ball[3], double &t){
+    int surface = SURFACE_NONE;
+    t = 1e9;
+    if(dir[1] > 1e-6){
+        double hit = (FLOOR_Y - origin[1]) / dir[1];
+        if(hit > 0 && hit < t){
+            t = hit;
+            surface = SURFACE_FLOOR;
+        }
+    }
+    if(dir[2] > 1e-6){
+        double hit = (WALL_Z - origin[2]) / dir[2];
+        if(hit > 0 && hit < t){
+            t = hit;
+            surface = SURFACE_WALL;
+        }
+    }
+    double oc[3] = {origin[0] - ball[0], origin[1] - ball[1], origin[2] - ball[2]};
+    double b = oc[0] * dir[0] + oc[1] * dir[1] + oc[2] * dir[2];
+    double c = oc[0] * oc[0] + oc[1] * oc[1] + oc[2] * oc[2] - BALL_RADIUS * BALL_RADIUS;
+    double discriminant = b * b - c;
+    if(discriminant > 0){
+        double hit = -b - std::sqrt(discriminant);
+        if(hit > 0 && hit < t){
+            t = hit;
+            surface = SURFACE_BALL;
+        }
+    }
+    return surface;
+}
+
+static double latticeValue(int x, int y){
+    uint32_t h = (uint32_t)x * 374761393u + (uint32_t)y * 668265263u;
+    h = (h ^ (h >> 13)) * 1274126177u;
+    return ((h ^ (h >> 16)) & 0xffff) / 65535.0;
+}
+
+static double valueNoise(double x, double y){
+    double fx = std::floor(x), fy = std::floor(y);
+    int ix = (int)fx, iy = (int)fy;
+    double tx = x - fx, ty = y - fy;
+    tx = tx * tx * (3 - 2 * tx);
+    ty = ty * ty * (3 - 2 * ty);
+    double top = latticeValue(ix, iy) + tx * (latticeValue(ix + 1, iy) - latticeValue(ix, iy));
+    double bottom = latticeValue(ix, iy + 1) + tx * (latticeValue(ix + 1, iy + 1) - latticeValue(ix, iy + 1));
+    return top + ty * (bottom - top);
+}
+
+// two octaves of value noise, fine enough for block matching
+static cv::Vec3b shadeSurface(int surface, const double point[3], const double ball[3]){
+    double s, t;
+    cv::Vec3d tint;
+    switch(surface){
+    case SURFACE_FLOOR:
+        s = point[0];
+        t = point[2];
+        tint = cv::Vec3d(0.8, 0.9, 1.0);
+        break;
+    case SURFACE_WALL:
+        s = point[0];
+        t = point[1];
+        tint = cv::Vec3d(1.0, 0.9, 0.8);
+        break;
+    case SURFACE_BALL:
+        s = std::atan2(point[0] - ball[0], point[2] - ball[2]) * BALL_RADIUS;
+        t = point[1] - ball[1];
+        tint = cv::Vec3d(0.6, 0.7, 1.0);
+        break;
+    default:
+        return cv::Vec3b(0, 0, 0);
+    }
+    double value = 0.6 * valueNoise(s / 0.02, t / 0.02) + 0.4 * valueNoise(s / 0.006, t / 0.006);
+    value = 30 + 200 * value;
+    return cv::Vec3b(cv::saturate_cast<unsigned char>(value * tint[0]), cv::saturate_cast<unsigned char>(value * tint[1]),
+                     cv::saturate_cast<unsigned char>(value * tint[2]));
+}
+
+static std::chrono::microseconds nowStamp(void){
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch());
+}
+
+VirtualStereoCamera::VirtualStereoCamera(std::string source, double frameRate, cv::Size frameSize)
+    : HostStereoCamera("VirtualStereoCamera"){
+    m_source = source;
+    m_frameRate = std::max(0.0, frameRate);
+    m_startStamp = nowStamp();
+    m_nextFrame = std::chrono::steady_clock::now();
+
+    if(source == VIRTUAL_SOURCE_SYNTHETIC){
+        m_isSynthetic = true;
+        m_frameSize = frameSize;
+        initSynthetic();
+        m_isOpened = m_frameSize.width >= 2 && m_frameSize.height >= 1;
+    }
+    else{
+        cv::Mat frame;
+        if(m_capture.open(source) && m_capture.read(frame) && !frame.empty()){
+            m_frameSize = frame.size();
+            m_capture.set(cv::CAP_PROP_POS_FRAMES, 0);
+            m_isOpened = true;
+        }
+    }
+
+    if(m_isOpened)
+        m_log->runTimeInfo("Open virtual camera %s, %dx%d.", source.c_str(), m_frameSize.width, m_frameSize.height);
+    else
+        m_log->runTimeError("Open virtual camera %s failed!", source.c_str());
+}
+
+VirtualStereoCamera::~VirtualStereoCamera(){
+    m_capture.release();
+}
+
+void VirtualStereoCamera::initSynthetic(void){
+    cv::Mat K = (cv::Mat_<double>(3, 3) << FOCAL, 0, (CALIB_SIZE.width - 1) / 2.0,
+                                           0, FOCAL, (CALIB_SIZE.height - 1) / 2.0,
+                                           0, 0, 1);
+    cv::Mat D = cv::Mat::zeros(1, 4, CV_64F), xi = cv::Mat::ones(1, 1, CV_64F), R = cv::Mat::eye(3, 3, CV_64F);
+    cv::Mat T = (cv::Mat_<double>(3, 1) << -BASELINE, 0, 0);
+    cv::Mat kfe = (cv::Mat_<double>(3, 3) << CALIB_SIZE.width / CV_PI, 0, 0,
+                                             0, CALIB_SIZE.height / CV_PI, 0,
+                                             0, 0, 1);
+    m_leftParams = {K, D, xi, R, T, kfe};
+    m_rightParams = {K.clone(), D.clone(), xi.clone(), R.clone(), T.clone(), kfe.clone()};
+
+    // inverse Mei projection with xi = 1 and no distortion, intrinsic scaled to the image size
+    cv::Size size(m_frameSize.width / 2, m_frameSize.height);
+    double fx = FOCAL * size.width / CALIB_SIZE.width, fy = FOCAL * size.height / CALIB_SIZE.height;
+    double cx = (CALIB_SIZE.width - 1) / 2.0 * size.width / CALIB_SIZE.width;
+    double cy = (CALIB_SIZE.height - 1) / 2.0 * size.height / CALIB_SIZE.height;
+    m_rays[0].create(size, CV_32FC3);
+    for(int v = 0; v < size.height; v++){
+        cv::Vec3f *ray = m_rays[0].ptr<cv::Vec3f>(v);
+        for(int u = 0; u < size.width; u++){
+            double x = (u - cx) / fx, y = (v - cy) / fy, r2 = x * x + y * y;
+            double factor = 2 / (r2 + 1);
+            ray[u] = cv::Vec3f((float)(factor * x), (float)(factor * y), (float)(factor - 1));
+        }
+    }
+    m_rays[1] = m_rays[0];
+}
+
+void VirtualStereoCamera::renderFrame(double time, cv::Mat &frame) const{
+    double ball[3];
+    ballCenter(time, ball);
+    int width = m_frameSize.width / 2;
+    frame.create(m_frameSize, CV_8UC3);
+
+    cv::parallel_for_(cv::Range(0, m_frameSize.height), [&](const cv::Range &range){
+        for(int v = range.start; v < range.end; v++){
+            // right image at the left half, like the camera
+            for(int eye = 0; eye < 2; eye++){
+                const cv::Vec3f *rays = m_rays[eye].ptr<cv::Vec3f>(v);
+                cv::Vec3b *out = frame.ptr<cv::Vec3b>(v) + (eye == 0 ? width : 0);
+                double origin[3] = {eye == 0 ? 0 : BASELINE, 0, 0};
+                for(int u = 0; u < width; u++){
+                    double dir[3] = {rays[u][0], rays[u][1], rays[u][2]}, t;
+                    int surface = intersectScene(origin, dir, ball, t);
+                    double point[3] = {origin[0] + t * dir[0], origin[1] + t * dir[1], origin[2] + t * dir[2]};
+                    out[u] = shadeSurface(surface, point, ball);
+                }
+            }
+        }
+    });
+}
+
+bool VirtualStereoCamera::readFrame(cv::Mat &frame){
+    if(m_capture.read(frame) && !frame.empty())
+        return true;
+    // loop recorded sources
+    m_capture.set(cv::CAP_PROP_POS_FRAMES, 0);
+    if(m_capture.read(frame) && !frame.empty())
+        return true;
+    m_capture.release();
+    m_capture.open(m_source);
+    return m_capture.read(frame) && !frame.empty();
+}
+
+bool VirtualStereoCamera::isOpened(void){
+    return m_isOpened;
+}
+
+bool VirtualStereoCamera::setRawFrameRate(int frameRate){
+    if(frameRate < 0)
+        return false;
+    std::lock_guard<std::mutex> lock(m_frameLock);
+    m_frameRate = frameRate;
+    return true;
+}
+
+bool VirtualStereoCamera::setRawFrameSize(cv::Size frameSize){
+    if(!m_isSynthetic){
+        m_log->runTimeWarning("Frame size of a recorded source can not be changed!");
+        return false;
+    }
+    if(frameSize.width < 2 || frameSize.height < 1)
+        return false;
+    std::lock_guard<std::mutex> frameLock(m_frameLock);
+    std::lock_guard<std::mutex> rectLock(m_rectLock);
+    m_frameSize = frameSize;
+    initSynthetic();
+    m_isRectInit = false;
+    return true;
+}
+
+float VirtualStereoCamera::getRawFrameRate(void) const{
+    return (float)m_frameRate;
+}
+
+cv::Size VirtualStereoCamera::getRawFrameSize(void) const{
+    return m_frameSize;
+}
+
+bool VirtualStereoCamera::getRawFrame(cv::Mat &frame, std::chrono::microseconds &timeStamp){
+    if(!m_isOpened)
+        return false;
+    std::lock_guard<std::mutex> lock(m_frameLock);
+    if(m_frameRate > 0){
+        std::this_thread::sleep_until(m_nextFrame);
+        std::chrono::steady_clock::duration period =
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / m_frameRate));
+        m_nextFrame = std::max(m_nextFrame + period, std::chrono::steady_clock::now());
+    }
+
+    timeStamp = nowStamp();
+    if(m_isSynthetic){
+        renderFrame((timeStamp - m_startStamp).count() / 1e6, frame);
+        return true;
+    }
+    return readFrame(frame);
+}
+
+bool VirtualStereoCamera::getStereoFrame(cv::Mat &left, cv::Mat &right, std::chrono::microseconds &timeStamp){
+    cv::Mat frame;
+    if(!getRawFrame(frame, timeStamp))
+        return false;
+    int halfWidth = frame.cols / 2;
+    frame(cv::Rect(0, 0, halfWidth, frame.rows)).copyTo(right);
+    frame(cv::Rect(halfWidth, 0, halfWidth, frame.rows)).copyTo(left);
+    return true;
+}
+
+bool VirtualStereoCamera::startCapture(bool udpFlag, bool shmFlag){
+    if(udpFlag || shmFlag)
+        m_log->runTimeWarning("Virtual camera does not send frames by udp or share memory!");
+    m_isCapturing = m_isOpened;
+    return m_isOpened;
+}
+
+bool VirtualStereoCamera::stopCapture(void){
+    bool isCapturing = m_isCapturing;
+    m_isCapturing = false;
+    return isCapturing;
+}
+
+bool VirtualStereoCamera::startStereoCompute(void){
+    m_log->runTimeWarning("Virtual camera does not compute depth, use StereoPipeline!");
+    return false;
+}
+
+bool VirtualStereoCamera::stopStereoCompute(void){
+    return false;
+}
+
+bool VirtualStereoCamera::getDepthFrame(cv::Mat &depth, bool color, std::chrono::microseconds &timeStamp){
+    return false;
+}
+
+bool VirtualStereoCamera::getPointCloud(std::vector<PCLType> &pcl, std::chrono::microseconds &timeStamp){
+    return false;
+}
+
+bool VirtualStereoCamera::isSynthetic(void) const{
+    return m_isSynthetic;
+}
+
+bool VirtualStereoCamera::getGroundTruth(const StereoRectifier &rectifier, std::chrono::microseconds timeStamp,
+                                         cv::Mat &disparity, cv::Mat *distance) const{
+    if(!m_isSynthetic || !rectifier.isReady())
+        return false;
+
+    double ball[3];
+    ballCenter((timeStamp - m_startStamp).count() / 1e6, ball);
+    cv::Mat kfe = rectifier.getRectIntrinsic();
+    double fx = kfe.at<double>(0, 0), fy = kfe.at<double>(1, 1);
+    double cx = kfe.at<double>(0, 2), cy = kfe.at<double>(1, 2);
+    double baseline = rectifier.getBaseline();
+    bool isLonglat = rectifier.getMode() == RECTIFY_LONGLAT;
+    cv::Size size = rectifier.getRectFrameSize();
+    disparity.create(size, CV_16SC1);
+    if(distance)
+        distance->create(size, CV_32FC1);
+
+    // parallel cameras, the rectified left frame is the left camera frame
+    cv::parallel_for_(cv::Range(0, size.height), [&](const cv::Range &range){
+        const double origin[3] = {0, 0, 0};
+        for(int v = range.start; v < range.end; v++){
+            short *disp = disparity.ptr<short>(v);
+            float *dist = distance ? distance->ptr<float>(v) : nullptr;
+            double lat = (v - cy) / fy;
+            for(int u = 0; u < size.width; u++){
+                double lon = (u - cx) / fx, dir[3];
+                if(isLonglat){
+                    dir[0] = -std::cos(lon);
+                    dir[1] = -std::sin(lon) * std::cos(lat);
+                    dir[2] = std::sin(lon) * std::sin(lat);
+                }
+                else{
+                    double norm = std::sqrt(lon * lon + lat * lat + 1);
+                    dir[0] = lon / norm;
+                    dir[1] = lat / norm;
+                    dir[2] = 1 / norm;
+                }
+
+                double t, value = 0, d = -1;
+                if(intersectScene(origin, dir, ball, t) != SURFACE_NONE){
+                    if(isLonglat){
+                        value = t;
+                        d = std::atan2(std::sin(lon), t / baseline + std::cos(lon)) * fx;
+                    }
+                    else{
+                        value = t * dir[2];
+                        d = fx * baseline / value;
+                    }
+                }
+                disp[u] = d > 0 ? (short)std::min(32767.0, d * 16 + 0.5) : -16;
+                if(dist)
+                    dist[u] = d > 0 ? (float)value : 0.f;
+            }
+        }
+    });
+    return true;
+}
+
+StereoCamera* openStereoCamera(std::string fileName){
+    cv::FileStorage fs(fileName, cv::FileStorage::READ);
+    cv::Mat deviceNode;
+    std::string backend = "sdk";
+    if(fs.isOpened()){
+        fs["DeviceNode"] >> deviceNode;
+        cv::FileNode node = fs["CaptureBackend"];
+        if(!node.empty() && node.isString())
+            node >> backend;
+    }
+    bool isVirtual = !deviceNode.empty() && deviceNode.at<double>(0) < 0;
+    if(!isVirtual && backend != "v4l2")
+        return new UnitreeCamera(fileName);
+
+    std::string source = VIRTUAL_SOURCE_SYNTHETIC, calibFile;
+    cv::FileNode node = fs["VirtualSource"];
+    if(!node.empty() && node.isString())
+        node >> source;
+    node = fs["CalibParamsFile"];
+    if(!node.empty() && node.isString())
+        node >> calibFile;
+    cv::Mat frameRate, frameSize, rectSize, rectMode, hFov;
+    fs["FrameRate"] >> frameRate;
+    fs["FrameSize"] >> frameSize;
+    fs["RectifyFrameSize"] >> rectSize;
+    fs["Depthmode"] >> rectMode;
+    fs["hFov"] >> hFov;
+
+    double rate = frameRate.empty() ? 30 : frameRate.at<double>(0);
+    cv::Size size(1856, 800);
+    if(frameSize.total() >= 2)
+        size = cv::Size((int)frameSize.at<double>(0), (int)frameSize.at<double>(1));
+    HostStereoCamera *camera;
+    if(isVirtual)
+        camera = new VirtualStereoCamera(source, rate, size);
+    else
+        camera = new V4l2StereoCamera(deviceNode.empty() ? 0 : (int)deviceNode.at<double>(0), rate, size);
+    if(rectSize.total() >= 2)
+        camera->setRectParams(cv::Size((int)rectSize.at<double>(0), (int)rectSize.at<double>(1)),
+                              rectMode.empty() ? RECTIFY_LONGLAT : (int)rectMode.at<double>(0),
+                              hFov.empty() ? 90 : hFov.at<double>(0));
+    if(!calibFile.empty())
+        camera->loadCalibParams(calibFile);
+    return camera;
+}
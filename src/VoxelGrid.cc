@@ -0,0 +1,186 @@
+/**
+  * @file VoxelGrid.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement the hashed voxel grid APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "VoxelGrid.hpp"
+#include <cmath>
+
+// smallest table, 1024 cells
+#define VOXEL_TABLE_MIN 1024
+
+static inline uint64_t hashKey(uint64_t key){
+    return key * 0x9E3779B97F4A7C15ull;
+}
+
+VoxelGrid::VoxelGrid(float voxelSize){
+    setVoxelSize(voxelSize);
+}
+
+VoxelGrid::~VoxelGrid(){
+}
+
+bool VoxelGrid::setVoxelSize(float voxelSize){
+    if(!(voxelSize > 0))
+        return false;
+    m_voxelSize = voxelSize;
+    m_inverseSize = 1.f / voxelSize;
+    clear();
+    return true;
+}
+
+float VoxelGrid::getVoxelSize(void) const{
+    return m_voxelSize;
+}
+
+void VoxelGrid::reserve(size_t voxels){
+    while(m_cells.size() < VOXEL_TABLE_MIN || m_cells.size() < voxels * 2)
+        grow();
+    m_occupied.reserve(voxels);
+}
+
+void VoxelGrid::clear(void){
+    m_occupied.clear();
+    if(++m_stamp != 0)
+        return;
+    // stamps wrapped around, old cells could look current
+    for(VoxelCellType &cell : m_cells)
+        cell.stamp = 0;
+    m_stamp = 1;
+}
+
+bool VoxelGrid::voxelKey(float x, float y, float z, uint64_t &key) const{
+    float fx = std::floor(x * m_inverseSize), fy = std::floor(y * m_inverseSize), fz = std::floor(z * m_inverseSize);
+    // also false for NaN
+    if(!(std::fabs(fx) < VOXEL_INDEX_RANGE && std::fabs(fy) < VOXEL_INDEX_RANGE && std::fabs(fz) < VOXEL_INDEX_RANGE))
+        return false;
+    uint64_t ix = (uint64_t)((int64_t)fx + VOXEL_INDEX_RANGE);
+    uint64_t iy = (uint64_t)((int64_t)fy + VOXEL_INDEX_RANGE);
+    uint64_t iz = (uint64_t)((int64_t)fz + VOXEL_INDEX_RANGE);
+    key = (ix << 42) | (iy << 21) | iz;
+    return true;
+}
+
+uint32_t VoxelGrid::findCell(uint64_t key) const{
+    size_t mask = m_cells.size() - 1;
+    size_t index = (size_t)(hashKey(key) >> 32) & mask;
+    while(m_cells[index].stamp == m_stamp && m_cells[index].key != key)
+        index = (index + 1) & mask;
+    return (uint32_t)index;
+}
+
+void VoxelGrid::grow(void){
+    std::vector<VoxelCellType> cells;
+    cells.swap(m_cells);
+    m_cells.resize(cells.empty() ? VOXEL_TABLE_MIN : cells.size() * 2);
+    for(VoxelCellType &cell : m_cells)
+        cell.stamp = 0;
+    m_stamp = 1;
+    for(uint32_t &index : m_occupied){
+        VoxelCellType &cell = cells[index];
+        cell.stamp = m_stamp;
+        index = findCell(cell.key);
+        m_cells[index] = cell;
+    }
+}
+
+uint32_t VoxelGrid::addPoint(float x, float y, float z, uint32_t color){
+    uint64_t key;
+    if(!voxelKey(x, y, z, key))
+        return VOXEL_NONE;
+    uint32_t index = findCell(key);
+    VoxelCellType *cell = &m_cells[index];
+    if(cell->stamp != m_stamp){
+        // keep the load at most one half, probes stay short
+        if((m_occupied.size() + 1) * 2 > m_cells.size()){
+            grow();
+            index = findCell(key);
+            cell = &m_cells[index];
+        }
+        cell->key = key;
+        cell->stamp = m_stamp;
+        cell->count = 0;
+        cell->x = cell->y = cell->z = 0;
+        cell->b = cell->g = cell->r = 0;
+        cell->number = (uint32_t)m_occupied.size();
+        m_occupied.push_back(index);
+    }
+    cell->count++;
+    cell->x += x;
+    cell->y += y;
+    cell->z += z;
+    cell->b += color & 0xff;
+    cell->g += (color >> 8) & 0xff;
+    cell->r += (color >> 16) & 0xff;
+    return cell->number;
+}
+
+void VoxelGrid::insert(const float *x, const float *y, const float *z, const uint32_t *color, size_t count,
+                       uint32_t *voxels){
+    if(!(m_voxelSize > 0))
+        return;
+    if(m_cells.empty())
+        grow();
+    uint32_t white = PointCloudSoAType::packColor(255, 255, 255);
+    for(size_t i = 0; i < count; i++){
+        uint32_t voxel = addPoint(x[i], y[i], z[i], color ? color[i] : white);
+        if(voxels)
+            voxels[i] = voxel;
+    }
+}
+
+void VoxelGrid::insert(const PointCloudSoAType &cloud){
+    insert(cloud.x.data(), cloud.y.data(), cloud.z.data(), cloud.color.data(), cloud.count);
+}
+
+void VoxelGrid::insert(const std::vector<PCLType> &cloud){
+    if(!(m_voxelSize > 0))
+        return;
+    if(m_cells.empty())
+        grow();
+    for(const PCLType &point : cloud)
+        addPoint(point.pts[0], point.pts[1], point.pts[2], PointCloudSoAType::packColor(point.clr[0], point.clr[1], point.clr[2]));
+}
+
+size_t VoxelGrid::size(void) const{
+    return m_occupied.size();
+}
+
+uint32_t VoxelGrid::pointCount(uint32_t voxel) const{
+    return m_cells[m_occupied[voxel]].count;
+}
+
+uint32_t VoxelGrid::neighbor(uint32_t voxel, int dx, int dy, int dz) const{
+    const uint64_t mask = (1ull << 21) - 1;
+    uint64_t key = m_cells[m_occupied[voxel]].key;
+    int64_t ix = (int64_t)((key >> 42) & mask) + dx;
+    int64_t iy = (int64_t)((key >> 21) & mask) + dy;
+    int64_t iz = (int64_t)(key & mask) + dz;
+    if(ix < 0 || iy < 0 || iz < 0 || ix > (int64_t)mask || iy > (int64_t)mask || iz > (int64_t)mask)
+        return VOXEL_NONE;
+    const VoxelCellType &cell = m_cells[findCell(((uint64_t)ix << 42) | ((uint64_t)iy << 21) | (uint64_t)iz)];
+    return cell.stamp == m_stamp ? cell.number : VOXEL_NONE;
+}
+
+size_t VoxelGrid::extract(PointCloudSoAType &cloud, uint32_t minPoints) const{
+    cloud.reserve(m_occupied.size());
+    size_t count = 0;
+    for(uint32_t index : m_occupied){
+        const VoxelCellType &cell = m_cells[index];
+        if(cell.count < minPoints)
+            continue;
+        float inverse = 1.f / cell.count;
+        cloud.x[count] = cell.x * inverse;
+        cloud.y[count] = cell.y * inverse;
+        cloud.z[count] = cell.z * inverse;
+        cloud.color[count] = PointCloudSoAType::packColor((uint8_t)(cell.b / cell.count), (uint8_t)(cell.g / cell.count),
+                                                          (uint8_t)(cell.r / cell.count));
+        count++;
+    }
+    cloud.count = count;
+    return count;
+}
@@ -0,0 +1,133 @@
+/**
+  * @file WorkerPool.cc
+  * @brief This file is part of UnitreeCameraSDK, which implement the worker thread pool APIs.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c)2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  * Use of this source code is governed by the MPL-2.0 license, see LICENSE.
+  */
+
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <opencv2/opencv.hpp>
+#include <pthread.h>
+#include <sched.h>
+
+WorkerPool::WorkerPool(const WorkerPoolConfigType &config) : m_config(config), m_isPriorityWarned(false){
+    m_log = new SystemLog(m_logName);
+    m_log->setLogLevel(1);
+    std::lock_guard<std::mutex> lock(m_lock);
+    for(int i = 0; i < m_config.threadCount; i++)
+        startWorker();
+}
+
+WorkerPool::~WorkerPool(){
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_isClosed = true;
+    }
+    m_trigger.notify_all();
+    for(std::thread *worker : m_workers){
+        worker->join();
+        delete worker;
+    }
+    delete m_log;
+}
+
+std::future<void> WorkerPool::submit(TaskType task, std::string name){
+    QueuedTaskType queued;
+    queued.task = std::packaged_task<void(void)>(std::move(task));
+    queued.name = name;
+    std::future<void> result = queued.task.get_future();
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if(m_isClosed)
+            return std::future<void>();
+        m_tasks.push_back(std::move(queued));
+        // loops never return their thread, a task must not wait for one
+        if((int)m_tasks.size() > m_idleCount)
+            startWorker();
+    }
+    m_trigger.notify_one();
+    return result;
+}
+
+int WorkerPool::threadCount(void){
+    std::lock_guard<std::mutex> lock(m_lock);
+    return (int)m_workers.size();
+}
+
+WorkerPoolConfigType WorkerPool::getConfig(void) const{
+    return m_config;
+}
+
+WorkerPool* WorkerPool::defaultPool(void){
+    // never destroyed, a component still running at exit must not block it
+    static WorkerPool *pool = new WorkerPool();
+    return pool;
+}
+
+void WorkerPool::setParallelThreads(int threads){
+    cv::setNumThreads(threads);
+}
+
+void WorkerPool::startWorker(void){
+    int index = (int)m_workers.size();
+    m_idleCount++;
+    m_workers.push_back(new std::thread(&WorkerPool::taskWorker, this, index));
+}
+
+void WorkerPool::taskWorker(int index){
+    applyConfig(index);
+    std::string idleName = m_config.name + std::to_string(index);
+    std::unique_lock<std::mutex> lock(m_lock);
+    while(true){
+        m_trigger.wait(lock, [this]{ return m_isClosed || !m_tasks.empty(); });
+        if(m_tasks.empty())
+            break;
+        QueuedTaskType queued = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        m_idleCount--;
+        lock.unlock();
+
+        if(!queued.name.empty())
+            setThreadName(queued.name);
+        queued.task();
+        if(!queued.name.empty())
+            setThreadName(idleName);
+
+        lock.lock();
+        m_idleCount++;
+    }
+}
+
+void WorkerPool::applyConfig(int index){
+    setThreadName(m_config.name + std::to_string(index));
+
+    if(!m_config.cpus.empty()){
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for(int cpu : m_config.cpus)
+            if(cpu >= 0 && cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &cpus);
+        int result = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if(result != 0)
+            m_log->runTimeError("Set cpu affinity of worker %d failed: %s", index, strerror(result));
+    }
+
+    if(m_config.priority > 0){
+        struct sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = std::min(m_config.priority, sched_get_priority_max(SCHED_FIFO));
+        int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if(result != 0 && !m_isPriorityWarned.exchange(true))
+            m_log->runTimeWarning("Set SCHED_FIFO priority %d failed: %s, workers keep the default scheduler.",
+                                  param.sched_priority, strerror(result));
+    }
+}
+
+void WorkerPool::setThreadName(const std::string &name){
+    // the kernel keeps 15 characters
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+}
@@ -0,0 +1,134 @@
+/**
+  * @file test_virtual_pipeline.cc
+  * @brief This file is part of UnitreeCameraSDK.
+  * @details This test runs frames of the synthetic VirtualStereoCamera scene through StereoPipeline::processFrame()
+  * in both rectify modes and compares disparity and depth with VirtualStereoCamera::getGroundTruth().
+  * Usage: test_virtual_pipeline [--config FILE]
+  * It fails if the mean disparity error, the share of scene pixels with a disparity or the mean relative depth
+  * error is out of its limit.
+  * @date  2026.10.16
+  * @version 1.1.0
+  * @copyright Copyright (c) 2020-2021, Hangzhou Yushu Technology Stock CO.LTD. All Rights Reserved.
+  */
+
+#include <StereoPipeline.hpp>
+#include <StereoRectifier.hpp>
+#include <VirtualStereoCamera.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static const int FRAME_COUNT = 5;
+static const double MAX_DISPARITY_ERROR = 1.0;      ///< mean absolute disparity error, unit is pixel
+static const double MIN_COVERAGE = 0.3;             ///< matched share of the pixels that see the scene
+static const double MAX_DEPTH_ERROR = 0.1;          ///< mean depth error relative to the true depth
+
+typedef struct TruthError{
+    double disparitySum = 0;
+    double depthSum = 0;
+    long scenePixels = 0;       ///< pixels that see the scene
+    long matchedPixels = 0;     ///< scene pixels with a disparity
+    long depthPixels = 0;       ///< matched pixels with a valid depth
+}TruthErrorType;
+
+// disparity in 1/16 pixel, invalid below 0 for both, depth 0 where invalid for both
+static void accumulate(const cv::Mat &disparity, const cv::Mat &depth, const cv::Mat &truthDisparity,
+                       const cv::Mat &truthDistance, TruthErrorType &error){
+    for(int v = 0; v < disparity.rows; v++){
+        const short *disp = disparity.ptr<short>(v), *truth = truthDisparity.ptr<short>(v);
+        const float *dist = depth.ptr<float>(v), *truthDist = truthDistance.ptr<float>(v);
+        for(int u = 0; u < disparity.cols; u++){
+            if(truth[u] <= 0)
+                continue;
+            error.scenePixels++;
+            if(disp[u] <= 0)
+                continue;
+            error.matchedPixels++;
+            error.disparitySum += std::abs(disp[u] - truth[u]) / 16.0;
+            if(dist[u] > 0 && truthDist[u] > 0){
+                error.depthPixels++;
+                error.depthSum += std::abs(dist[u] - truthDist[u]) / truthDist[u];
+            }
+        }
+    }
+}
+
+static bool runMode(const StereoPipelineConfigType &baseConfig, int mode){
+    const char *modeName = mode == RECTIFY_LONGLAT ? "longlat" : "perspective";
+    StereoPipelineConfigType config = baseConfig;
+    config.depthMode = mode;
+    config.depthFormat = DEPTH_METER;
+
+    VirtualStereoCamera camera(VIRTUAL_SOURCE_SYNTHETIC, 0);
+    StereoPipeline pipeline;
+    if(!camera.isOpened() || !pipeline.setConfig(config) || !pipeline.init(&camera)){
+        fprintf(stderr, "%s: open camera or init pipeline failed\n", modeName);
+        return false;
+    }
+
+    // ground truth is rendered into the rectified left image of the pipeline
+    std::vector<cv::Mat> leftParams, rightParams;
+    cv::Size rawSize = camera.getRawFrameSize();
+    StereoRectifier rectifier;
+    if(!camera.getCalibParams(leftParams, false) || !camera.getCalibParams(rightParams, true) ||
+       !rectifier.init(leftParams, rightParams, config.calibFrameSize, cv::Size(rawSize.width / 2, rawSize.height),
+                       config.rectFrameSize, config.depthMode, config.hFov, config.mapCacheDir,
+                       config.depthRoi, config.decimation)){
+        fprintf(stderr, "%s: init ground truth rectifier failed\n", modeName);
+        return false;
+    }
+
+    TruthErrorType error;
+    for(int i = 0; i < FRAME_COUNT; i++){
+        cv::Mat raw, left, right, disparity, depth, truthDisparity, truthDistance;
+        std::chrono::microseconds timeStamp;
+        PointCloudSoAType cloud;
+        if(!camera.getRawFrame(raw, timeStamp) ||
+           !pipeline.processFrame(raw, left, right, disparity, &depth, cloud) ||
+           !camera.getGroundTruth(rectifier, timeStamp, truthDisparity, &truthDistance)){
+            fprintf(stderr, "%s: frame %d failed\n", modeName, i);
+            return false;
+        }
+        if(disparity.size() != truthDisparity.size() || depth.size() != truthDistance.size()){
+            fprintf(stderr, "%s: pipeline output %dx%d, ground truth %dx%d\n", modeName, disparity.cols,
+                    disparity.rows, truthDisparity.cols, truthDisparity.rows);
+            return false;
+        }
+        accumulate(disparity, depth, truthDisparity, truthDistance, error);
+    }
+
+    double coverage = error.scenePixels > 0 ? (double)error.matchedPixels / error.scenePixels : 0;
+    double disparityError = error.matchedPixels > 0 ? error.disparitySum / error.matchedPixels : 0;
+    double depthError = error.depthPixels > 0 ? error.depthSum / error.depthPixels : 0;
+    bool isPassed = coverage >= MIN_COVERAGE && disparityError <= MAX_DISPARITY_ERROR &&
+                    error.depthPixels > 0 && depthError <= MAX_DEPTH_ERROR;
+    printf("%s %s: coverage %.3f (min %.3f), disparity error %.3f px (max %.3f), "
+           "depth error %.3f (max %.3f) over %ld pixels\n", isPassed ? "PASS" : "FAIL", modeName,
+           coverage, MIN_COVERAGE, disparityError, MAX_DISPARITY_ERROR, depthError, MAX_DEPTH_ERROR, error.depthPixels);
+    return isPassed;
+}
+
+int main(int argc, char *argv[]){
+    std::string configFile;
+    for(int i = 1; i < argc; i++){
+        if(!strcmp(argv[i], "--config") && i + 1 < argc)
+            configFile = argv[++i];
+        else{
+            fprintf(stderr, "usage: %s [--config FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    StereoPipeline pipeline;
+    if(!configFile.empty() && !pipeline.loadConfig(configFile))
+        return 1;
+    StereoPipelineConfigType config = pipeline.getConfig();
+
+    bool isPassed = true;
+    for(int mode : {RECTIFY_LONGLAT, RECTIFY_PERSPECTIVE})
+        isPassed = runMode(config, mode) && isPassed;
+    return isPassed ? 0 : 1;
+}